@@ -28,6 +28,8 @@
 #define ADE_REG_BWATT 0x313
 #define ADE_REG_AVAR 0x314
 #define ADE_REG_BVAR 0x315
+#define ADE_REG_IA_WAVE 0x316
+#define ADE_REG_IB_WAVE 0x317
 #define ADE_REG_IA 0x31A
 #define ADE_REG_IB 0x31B
 #define ADE_REG_V 0x31C
@@ -45,6 +47,77 @@
 #define ADE_REG_CONFIG_HPFEN (1 << 2)
 #define ADE_REG_CONFIG_SWRST (1 << 7)
 
+static const uint64_t ADE_RECEIVE_TIMEOUT_MILLI = 100;
+static const uint64_t ADE_DETECT_PERIOD_MILLI = 1000;
+static const uint64_t ADE_RESET_POLL_MILLI = 10;
+static const uint64_t ADE_RESET_TIMEOUT_MILLI = 2000;
+// Maximal time spent in transaction scheduler per single process() call
+static const uint32_t ADE_PROCESS_BUDGET_MICRO = 1000;
+
+static constexpr PowerMeasDevice::DescriptorInfo ADE7953_DESCRIPTORS[] PROGMEM = {
+    { "Power factor 1", "%", ".0f", "power_factor1", true },
+    { "Power factor 2", "%", ".0f", "power_factor2", true },
+    { "Active power 1", "W", ".0f", "active_power1", true },
+    { "Active power 2", "W", ".0f", "active_power2", true },
+    { "Current 1", "A", ".3f", "current1", true },
+    { "Current 2", "A", ".3f", "current2", true },
+    { "Energy 1", "Wh", ".3f", "energy1", true },
+    { "Energy 2", "Wh", ".3f", "energy2", true },
+    { "Voltage", "V", ".0f", "voltage", true },
+    { "Frequency", "Hz", ".0f", "frequency", true },
+    { "Fast current RMS", "A", ".3f", "current_fast", true }
+};
+
+static float scalePowerFactor(int32_t raw, float factor)
+{
+    // Signed 16 bit fraction, 0x7fff is almost 1
+    return (float)raw / 32768.0f;
+}
+
+static float scaleFrequency(int32_t raw, float factor)
+{
+    // Period register counts 223.75 kHz clock ticks
+    return 223750.0f / ((float)raw + 1);
+}
+
+typedef PowerMeasRegisterDevice::RegisterInfo RegisterInfo;
+static const uint8_t SIGNED_GROUP = PowerMeasRegisterDevice::REG_SIGNED | PowerMeasRegisterDevice::REG_GROUP;
+static const uint8_t CAPTURE = PowerMeasRegisterDevice::REG_SIGNED | PowerMeasRegisterDevice::REG_CAPTURE;
+static const uint8_t NO_DESC = PowerMeasRegisterDevice::NO_DESCRIPTOR;
+
+// Polled registers first in read order, 0x31x registers are kept adjacent so
+// they are read as one group
+static constexpr RegisterInfo ADE7953_REGISTERS[] = {
+    // address, width, flags, scale, factor, descriptor, cadence
+    { ADE_REG_PFA, 2, PowerMeasRegisterDevice::REG_SIGNED, scalePowerFactor, 0, 0, 1 },
+    { ADE_REG_PFB, 2, PowerMeasRegisterDevice::REG_SIGNED, scalePowerFactor, 0, 1, 1 },
+    { ADE_REG_AWATT, 4, SIGNED_GROUP, PowerMeasRegisterDevice::scaleAbsolute, ADE7953::SC_APOWER0, 2, 1 },
+    { ADE_REG_BWATT, 4, SIGNED_GROUP, PowerMeasRegisterDevice::scaleAbsolute, ADE7953::SC_APOWER1, 3, 1 },
+    { ADE_REG_IA, 4, SIGNED_GROUP, PowerMeasRegisterDevice::scaleAbsolute, ADE7953::SC_CURRENT0, 4, 1 },
+    { ADE_REG_IB, 4, SIGNED_GROUP, PowerMeasRegisterDevice::scaleAbsolute, ADE7953::SC_CURRENT1, 5, 1 },
+    { ADE_REG_V, 4, PowerMeasRegisterDevice::REG_GROUP, PowerMeasRegisterDevice::scaleLinear, ADE7953::SC_VOLTAGE, 8, 1 },
+    // Energy registers are cleared on read, they must be read every refresh
+    { ADE_REG_ANENERGYA, 4, SIGNED_GROUP, PowerMeasRegisterDevice::scaleLinear, ADE7953::SC_AENERGY0, 6, 1 },
+    { ADE_REG_ANENERGYB, 4, SIGNED_GROUP, PowerMeasRegisterDevice::scaleLinear, ADE7953::SC_AENERGY1, 7, 1 },
+    { ADE_REG_PERIOD, 2, 0, scaleFrequency, 0, 9, 5 },
+    // Waveform of current channels, read while capture runs
+    { ADE_REG_IA_WAVE, 4, CAPTURE, PowerMeasRegisterDevice::scaleLinear, ADE7953::SC_CURRENT0, 10, 0 },
+    { ADE_REG_IB_WAVE, 4, CAPTURE, PowerMeasRegisterDevice::scaleLinear, ADE7953::SC_CURRENT1, 10, 0 },
+    // Control registers
+    { ADE_REG_LCYCMODE, 1, 0, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_PGA_V, 1, 0, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_PGA_IA, 1, 0, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_PGA_IB, 1, 0, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_UNNAMED, 1, 0, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_CONFIG, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_RESERVED, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_AIRMSOS, 4, PowerMeasRegisterDevice::REG_SIGNED, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_VRMSOS, 4, PowerMeasRegisterDevice::REG_SIGNED, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_BIRMSOS, 4, PowerMeasRegisterDevice::REG_SIGNED, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_IRQSTATA, 4, 0, nullptr, 0, NO_DESC, 0 },
+    { ADE_REG_VERSION, 1, 0, nullptr, 0, NO_DESC, 0 }
+};
+
 ADE7953::ADE7953(Mode mode) :
     m_mode((Mode)PROFILE_DEFAULT_ADE7953_MODE),
     m_peripheralIndex(0),
@@ -54,30 +127,28 @@ ADE7953::ADE7953(Mode mode) :
     m_refreshPeriod(PROFILE_DEFAULT_ADE7953_PERIOD_MILLI),
     m_i2c(nullptr),
     m_serial(nullptr),
-    m_lastReadTimestamp(0)
+    m_lastReadTimestamp(0),
+    m_state(ADE_ST_IDLE),
+    m_transferState(ADE_TR_IDLE),
+    m_stateTimestamp(0),
+    m_requestTimestamp(0),
+    m_receiveCount(0),
+    m_receiveValue(0)
 {
-    appendDescriptor("Power factor 1", "%", ".0f", "power_factor1");
-    appendDescriptor("Power factor 2", "%", ".0f", "power_factor2");
-    appendDescriptor("Active power 1", "W", ".0f", "active_power1");
-    appendDescriptor("Active power 2", "W", ".0f", "active_power2");
-    appendDescriptor("Current 1", "A", ".3f", "current1");
-    appendDescriptor("Current 2", "A", ".3f", "current2");
-    appendDescriptor("Energy 1", "Wh", ".3f", "energy1");
-    appendDescriptor("Energy 2", "Wh", ".3f", "energy2");
-    appendDescriptor("Voltage", "V", ".0f", "voltage");
-    appendDescriptor("Frequency", "Hz", ".0f", "frequency");
+    setDescriptors(ADE7953_DESCRIPTORS, sizeof(ADE7953_DESCRIPTORS) / sizeof(ADE7953_DESCRIPTORS[0]));
+    setRegisterMap(ADE7953_REGISTERS, sizeof(ADE7953_REGISTERS) / sizeof(ADE7953_REGISTERS[0]), m_config.scales);
 
     // Default config
-    m_config.voltageScale = .0000382602;
+    m_config.scales[SC_VOLTAGE] = .0000382602;
     m_config.voltageOffset = -0.068;
-    m_config.currentScale0 = 0.00000949523;
-    m_config.currentScale1 = 0.00000949523;
+    m_config.scales[SC_CURRENT0] = 0.00000949523;
+    m_config.scales[SC_CURRENT1] = 0.00000949523;
     m_config.currentOffset0 = -0.017;
     m_config.currentOffset1 = -0.017;
-    m_config.apowerScale0 = (1 / 164.0);
-    m_config.apowerScale1 = (1 / 164.0);
-    m_config.aenergyScale0 = (1 / 25240.0);
-    m_config.aenergyScale1 = (1 / 25240.0);
+    m_config.scales[SC_APOWER0] = (1 / 164.0);
+    m_config.scales[SC_APOWER1] = (1 / 164.0);
+    m_config.scales[SC_AENERGY0] = (1 / 25240.0);
+    m_config.scales[SC_AENERGY1] = (1 / 25240.0);
     m_config.voltagePgaGain = PGA_GAIN_1;
     m_config.currentPgaGain0 = PGA_GAIN_1;
     m_config.currentPgaGain1 = PGA_GAIN_1;
@@ -139,64 +210,10 @@ void ADE7953::init()
             Log::error("ADE7953", "Unable to initialize, bad configuration");
         }
     }
-    if (ok)
-    {
-        int32_t value;
-        if (read(ADE_REG_VERSION, false, value))
-        {
-            Log::info("ADE7953", "Silicon version: 0x%02x (%d)", (int)value, (int)value);
-            write(ADE_REG_CONFIG, ADE_REG_CONFIG_SWRST);
-            delay(10);
-            int32_t val = 0;
-            uint64_t timeout = Time::nowRelativeMilli() + 2000;
-            do 
-            {
-                delay(10);
-                if (Time::nowRelativeMilli() > timeout)
-                {
-                    Log::error("ADE7953", "Unable to initialize - communication timeout");
-                    m_serial = nullptr;
-                    m_i2c = nullptr;
-                    return;
-                }
-            } while (!read(ADE_REG_IRQSTATA, false, value) || !(value & ADE_REG_IRQSTATA_RESET));
-            // Lock comms interface, enable high pass filter
-            write(ADE_REG_CONFIG, 0x04);
-            // Unlock unnamed (!) register 0x120 (see datasheet, page 18)
-            write(ADE_REG_UNNAMED, 0xAD);
-            // Set "optimal setting" (see datasheet, page 18)
-            write(ADE_REG_RESERVED, 0x30);
-            // Program measurement offsets.
-            if (m_config.voltageOffset != 0) 
-            {
-                write(ADE_REG_VRMSOS, (int32_t)(m_config.voltageOffset / m_config.voltageScale));
-            }
-            if (m_config.currentOffset0 != 0) 
-            {
-                write(ADE_REG_AIRMSOS, (int32_t)(m_config.currentOffset0 / m_config.currentScale0));
-            }
-            if (m_config.currentOffset1 != 0) 
-            {
-                write(ADE_REG_BIRMSOS, (int32_t)(m_config.currentOffset1 / m_config.currentScale1));
-            }
-
-            // Set PGA gains.
-            if (m_config.voltagePgaGain != 0) 
-            {
-                write(ADE_REG_PGA_V, m_config.voltagePgaGain);
-            }
-            if (m_config.currentPgaGain0 != 0) 
-            {
-                write(ADE_REG_PGA_IA, m_config.currentPgaGain0);
-            }
-            if (m_config.currentPgaGain1 != 0) 
-            {
-                write(ADE_REG_PGA_IB, m_config.currentPgaGain1);
-            }
-
-            write(ADE_REG_LCYCMODE, 0x40);
-        }
-    }
+    clearQueue();
+    m_lastReadTimestamp = 0;
+    m_stateTimestamp = 0;
+    m_state = ok ? ADE_ST_DETECT : ADE_ST_IDLE;
 }
 
 String ADE7953::getChipInfo() const
@@ -291,181 +308,263 @@ void ADE7953::setConfiguration(String config, bool save, bool performInit)
     }
 }
 
-uint8_t ADE7953::getRegSize(uint16_t reg) 
+void ADE7953::clearQueue()
 {
-    uint8_t size = 1;
-    if (reg != ADE_REG_VERSION && reg != ADE_REG_EX_REF) 
-    {
-        if (reg >= 0x300) size++;
-        if (reg >= 0x200) size++;
-        if (reg >= 0x100) size++;
-    }
-    return size;
+    clearRequests();
+    m_transferState = ADE_TR_IDLE;
 }
 
-void ADE7953::write(uint16_t reg, int32_t value)
+void ADE7953::writeUart(uint16_t reg, int32_t value)
 {
-    uint8_t size = getRegSize(reg);
-    if ((size > 4) || (size < 0))
-        return;
-    if ((m_mode == M_UART) && (m_serial))
+    uint8_t size = getRegisterWidth(reg);
+    m_serial->write(0xca);
+    m_serial->write(reg >> 8);
+    m_serial->write(reg & 0xff);
+    while(size--)
     {
-        m_serial->flush();
-        m_serial->write(0xca);
-        m_serial->write(reg >> 8);
-        m_serial->write(reg & 0xff);
-        while(size--)
-        {
-            m_serial->write((value >> (8 * size)) & 0xff);
-        }
+        m_serial->write((value >> (8 * size)) & 0xff);
     }
-    if ((m_mode == M_I2C) && (m_i2c))
+}
+
+void ADE7953::writeI2c(uint16_t reg, int32_t value)
+{
+    uint8_t size = getRegisterWidth(reg);
+    m_i2c->beginTransmission(ADE_ADDRESS);
+    m_i2c->write(reg >> 8);
+    m_i2c->write(reg & 0xff);
+    while(size--)
     {
-        m_i2c->beginTransmission(ADE_ADDRESS);
-        m_i2c->write(reg >> 8);
-        m_i2c->write(reg & 0xff);
-        while(size--)
-        {
-            m_i2c->write((value >> (8 * size)) & 0xff);
-        }
-        if (m_i2c->endTransmission() != 0)
-            Log::error("ADE7953", "Unable to write register %x, no ACK?", reg);
+        m_i2c->write((value >> (8 * size)) & 0xff);
     }
+    if (m_i2c->endTransmission() != 0)
+        Log::error("ADE7953", "Unable to write register %x, no ACK?", reg);
 }
 
-bool ADE7953::read(uint16_t reg, bool isSigned, int32_t& value)
+bool ADE7953::readI2c(uint16_t reg, bool sendStop, int32_t& value)
 {
-    int32_t v = 0;
-    uint8_t size = getRegSize(reg);
-    if ((m_mode == M_UART) && (m_serial))
+    uint8_t size = getRegisterWidth(reg);
+    uint32_t v = 0;
+    m_i2c->beginTransmission(ADE_ADDRESS);
+    m_i2c->write(reg >> 8);
+    m_i2c->write(reg & 0xff);
+    if (m_i2c->endTransmission(false) != 0)
     {
-        m_serial->flush();
-        m_serial->write(0x35);
-        m_serial->write(reg >> 8);
-        m_serial->write(reg & 0xff);
-        delay(1);
-        uint8_t cnt = 0;
-        uint64_t start = Time::nowRelativeMilli();
-        while(Time::nowRelativeMilli() < start + 500)
-        {
-            while(m_serial->available())
-            {
-                v = (v << 8) | m_serial->read();
-                cnt++;
-                if (cnt == size)
-                    break;
-            }
-        }
+        Log::error("ADE7953", "Unable to read register %x, no ACK?", reg);
+        return false;
     }
-    if ((m_mode == M_I2C) && (m_i2c))
+    m_i2c->requestFrom((uint8_t)ADE_ADDRESS, (uint8_t)size, (uint8_t)sendStop);
+    if (m_i2c->available() < size)
     {
-        m_i2c->beginTransmission(ADE_ADDRESS);
-        m_i2c->write(reg >> 8);
-        m_i2c->write(reg & 0xff);
-        if (m_i2c->endTransmission() == 0)
-        {
-            m_i2c->requestFrom((int)ADE_ADDRESS, (int)size);
-            value = 0;
-            if(m_i2c->available() >= size)
-            {
-                for(uint8_t i = 0; i < size; i++)
-                {
-                    v = (v << 8) | m_i2c->read();
-                }
-            }
-            else
-            {
-                Log::error("ADE7953", "Error reading 16 bit register %x", reg);
-                return false;
-            }
-        }
+        Log::error("ADE7953", "Error reading register %x", reg);
+        return false;
     }
-    if (isSigned) 
+    for(uint8_t i = 0; i < size; i++)
     {
-        uint32_t signMask = 0;
-        if (size == 1) signMask = (1 << 7);
-        if (size == 2) signMask = (1 << 15);
-        if (size == 3) signMask = (1 << 23);
-        if (size == 4) signMask = (1 << 31);
-        if ((v & signMask) != 0) 
-        {
-            v &= ~signMask;
-            v |= (1 << 31);
-        }
+        v = (v << 8) | m_i2c->read();
     }
-    value = (int32_t)v;    
+    value = decodeRaw(reg, v);
     return true;
 }
 
-void ADE7953::process()
+void ADE7953::processTransfer(uint64_t now)
 {
-    if ((m_i2c) || (m_serial))
+    uint32_t start = micros();
+    while ((uint32_t)(micros() - start) < ADE_PROCESS_BUDGET_MICRO)
     {
-        uint64_t now = Time::nowRelativeMilli();
-        if (now >= m_lastReadTimestamp + m_refreshPeriod)
+        // Idle bus between refreshes samples the waveform for the rest of the budget
+        if ((getRequestCount() == 0) && ((m_state != ADE_ST_READ) || !queueCaptureRead()))
+            break;
+        Request request = getRequest(0);
+        if (m_i2c)
         {
-            m_lastReadTimestamp = now;
-            Log::verbose("ADE7953", "Values update");
-            int32_t value;
-            // Power factor A
-            if (read(ADE_REG_PFA, false, value))
-            {
-                  // bit 15 is indicationg the sign and is part of the calculation
-                float pf = (value & (1 << 15)) ? /*negative sign*/ -(32767.0 / value) : /*positive sign*/ (value * 0.000030518);
-                setLastValue(0, pf);
-            }
-            // Power factor B
-            if (read(ADE_REG_PFB, false, value))
-            {
-                  // bit 15 is indicationg the sign and is part of the calculation
-                float pf = (value & (1 << 15)) ? /*negative sign*/ -(32767.0 / value) : /*positive sign*/ (value * 0.000030518);
-                setLastValue(1, pf);
-            }
-            // Active power A
-            if (read(ADE_REG_AWATT, true, value))
+            if (request.write)
             {
-                float watts = abs((float)value * m_config.apowerScale0);
-                setLastValue(2, watts);
+                popRequest();
+                writeI2c(request.reg, request.value);
+                continue;
             }
-            // Active power B
-            if (read(ADE_REG_BWATT, true, value))
+            // Adjacent 0x31x reads share one bus transaction (repeated start, single STOP)
+            uint8_t groupCount = 1;
+            if (isGroupRegister(request.reg))
             {
-                float watts = abs((float)value * m_config.apowerScale1);
-                setLastValue(3, watts);
+                while (groupCount < getRequestCount())
+                {
+                    const Request& next = getRequest(groupCount);
+                    if (next.write || !isGroupRegister(next.reg))
+                        break;
+                    groupCount++;
+                }
             }
-            // Current A
-            if (read(ADE_REG_IA, true, value))
+            for(uint8_t i = 0; (i < groupCount) && (getRequestCount() > 0); i++)
             {
-                float amperes = abs((float)value * m_config.currentScale0);
-                setLastValue(4, amperes);
+                request = getRequest(0);
+                popRequest();
+                int32_t value;
+                if (readI2c(request.reg, i == groupCount - 1, value))
+                    onRegisterRead(request.reg, value, now);
+                else
+                    onTransferError(request.reg, now);
             }
-            // Current B
-            if (read(ADE_REG_IB, true, value))
+            continue;
+        }
+        if (!m_serial)
+            break;
+        if (m_transferState == ADE_TR_IDLE)
+        {
+            if (request.write)
             {
-                float amperes = abs((float)value * m_config.currentScale1);
-                setLastValue(5, amperes);
+                popRequest();
+                writeUart(request.reg, request.value);
+                continue;
             }
-            // Energy A
-            if (read(ADE_REG_ANENERGYA, true, value)) 
+            // Drop any stale bytes so response is aligned
+            while (m_serial->available())
+                m_serial->read();
+            m_serial->write(0x35);
+            m_serial->write(request.reg >> 8);
+            m_serial->write(request.reg & 0xff);
+            m_receiveCount = 0;
+            m_receiveValue = 0;
+            m_requestTimestamp = now;
+            m_transferState = ADE_TR_RECEIVE;
+            continue;
+        }
+        if (!m_serial->available())
+        {
+            if (now > m_requestTimestamp + ADE_RECEIVE_TIMEOUT_MILLI)
             {
-                float wh = (float)value * m_config.aenergyScale0;
-                setLastValue(6, wh);
+                Log::error("ADE7953", "Receive timeout, register %x, received %d bytes", request.reg, m_receiveCount);
+                popRequest();
+                m_transferState = ADE_TR_IDLE;
+                onTransferError(request.reg, now);
+                continue;
             }
-            // Energy B
-            if (read(ADE_REG_ANENERGYB, true, value)) 
+            // Nothing to do until next byte arrives
+            break;
+        }
+        m_receiveValue = (m_receiveValue << 8) | m_serial->read();
+        m_receiveCount++;
+        if (m_receiveCount == getRegisterWidth(request.reg))
+        {
+            popRequest();
+            m_transferState = ADE_TR_IDLE;
+            onRegisterRead(request.reg, decodeRaw(request.reg, m_receiveValue), now);
+        }
+    }
+}
+
+void ADE7953::onRegisterRead(uint16_t reg, int32_t value, uint64_t now)
+{
+    if (storeRegister(reg, value))
+        return;
+    switch(reg)
+    {
+        case ADE_REG_VERSION:
+            if (m_state == ADE_ST_DETECT)
             {
-                float wh = (float)value * m_config.aenergyScale1;
-                setLastValue(7, wh);
+                Log::info("ADE7953", "Silicon version: 0x%02x (%d)", (int)value, (int)value);
+                queueWrite(ADE_REG_CONFIG, ADE_REG_CONFIG_SWRST);
+                m_stateTimestamp = now;
+                m_requestTimestamp = now;
+                m_state = ADE_ST_RESET;
             }
-            // Voltage
-            if (read(ADE_REG_V, false, value))
-                setLastValue(8, (float)value * m_config.voltageScale);
-            // Frequency
-            if (read(ADE_REG_PERIOD, false, value))
+            break;
+        case ADE_REG_IRQSTATA:
+            if ((m_state == ADE_ST_RESET) && (value & ADE_REG_IRQSTATA_RESET))
             {
-                float hertz = 223750.0f / ((float) value + 1);
-                setLastValue(9, hertz);
+                // Lock comms interface, enable high pass filter
+                queueWrite(ADE_REG_CONFIG, 0x04);
+                // Unlock unnamed (!) register 0x120 (see datasheet, page 18)
+                queueWrite(ADE_REG_UNNAMED, 0xAD);
+                // Set "optimal setting" (see datasheet, page 18)
+                queueWrite(ADE_REG_RESERVED, 0x30);
+                // Program measurement offsets.
+                if (m_config.voltageOffset != 0) 
+                {
+                    queueWrite(ADE_REG_VRMSOS, (int32_t)(m_config.voltageOffset / m_config.scales[SC_VOLTAGE]));
+                }
+                if (m_config.currentOffset0 != 0) 
+                {
+                    queueWrite(ADE_REG_AIRMSOS, (int32_t)(m_config.currentOffset0 / m_config.scales[SC_CURRENT0]));
+                }
+                if (m_config.currentOffset1 != 0) 
+                {
+                    queueWrite(ADE_REG_BIRMSOS, (int32_t)(m_config.currentOffset1 / m_config.scales[SC_CURRENT1]));
+                }
+
+                // Set PGA gains.
+                if (m_config.voltagePgaGain != 0) 
+                {
+                    queueWrite(ADE_REG_PGA_V, m_config.voltagePgaGain);
+                }
+                if (m_config.currentPgaGain0 != 0) 
+                {
+                    queueWrite(ADE_REG_PGA_IA, m_config.currentPgaGain0);
+                }
+                if (m_config.currentPgaGain1 != 0) 
+                {
+                    queueWrite(ADE_REG_PGA_IB, m_config.currentPgaGain1);
+                }
+
+                queueWrite(ADE_REG_LCYCMODE, 0x40);
+                m_state = ADE_ST_READ;
+                Log::verbose("ADE7953", "Init finished");
             }
+            break;
+    }
+}
+
+void ADE7953::onTransferError(uint16_t reg, uint64_t now)
+{
+    onReadError(reg);
+    if (m_state == ADE_ST_DETECT)
+    {
+        // Device not responding, next detect attempt is planned by process()
+        clearQueue();
+    }
+}
+
+void ADE7953::process()
+{
+    if ((m_i2c) || (m_serial))
+    {
+        uint64_t now = Time::nowRelativeMilli();
+        switch(m_state)
+        {
+            case ADE_ST_IDLE:
+                break;
+            case ADE_ST_DETECT:
+                if ((getRequestCount() == 0) && (now >= m_stateTimestamp + ADE_DETECT_PERIOD_MILLI))
+                {
+                    m_stateTimestamp = now;
+                    Log::verbose("ADE7953", "Sending detect request");
+                    queueRead(ADE_REG_VERSION);
+                }
+                break;
+            case ADE_ST_RESET:
+                if (now > m_stateTimestamp + ADE_RESET_TIMEOUT_MILLI)
+                {
+                    Log::error("ADE7953", "Unable to initialize - communication timeout");
+                    clearQueue();
+                    m_stateTimestamp = now;
+                    m_state = ADE_ST_DETECT;
+                }
+                else if ((getRequestCount() == 0) && (now >= m_requestTimestamp + ADE_RESET_POLL_MILLI))
+                {
+                    m_requestTimestamp = now;
+                    queueRead(ADE_REG_IRQSTATA);
+                }
+                break;
+            case ADE_ST_READ:
+                // Waveform read may be queued, refresh reads follow it
+                if (!isBatchPending() && (now >= m_lastReadTimestamp + getRefreshPeriod(m_refreshPeriod, FAST_REFRESH_PERIOD_MILLI)))
+                {
+                    m_lastReadTimestamp = now;
+                    Log::verbose("ADE7953", "Values update");
+                    scheduleReads(now);
+                }
+                break;
         }
+        processTransfer(now);
     }
-}
\ No newline at end of file
+}
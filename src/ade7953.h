@@ -1,8 +1,8 @@
 #pragma once
 #include <Wire.h>
-#include "power_meas_device.h"
+#include "power_meas_register_device.h"
 
-class ADE7953 : public PowerMeasDevice
+class ADE7953 : public PowerMeasRegisterDevice
 {
 public:
 
@@ -12,6 +12,19 @@ public:
         M_I2C
     };
 
+    // Calibration factors referenced by register map
+    enum ScaleIndex
+    {
+        SC_VOLTAGE = 0,
+        SC_CURRENT0,
+        SC_CURRENT1,
+        SC_APOWER0,
+        SC_APOWER1,
+        SC_AENERGY0,
+        SC_AENERGY1,
+        SC_COUNT
+    };
+
     ADE7953(Mode mode = M_I2C);
 
     void init() override;
@@ -26,6 +39,23 @@ public:
 
 private:
 
+    // Fastest useful read rate, RMS registers settle within a few mains cycles
+    static constexpr uint32_t FAST_REFRESH_PERIOD_MILLI = 50;
+
+    enum State
+    {
+        ADE_ST_IDLE = 0,
+        ADE_ST_DETECT,
+        ADE_ST_RESET,
+        ADE_ST_READ
+    };
+
+    enum TransferState
+    {
+        ADE_TR_IDLE = 0,
+        ADE_TR_RECEIVE
+    };
+
     enum PgaGain 
     {
         PGA_GAIN_1 = 0x00,
@@ -38,24 +68,22 @@ private:
 
     struct AdeConfig
     {
-        float voltageScale;
+        float scales[SC_COUNT];
         float voltageOffset;
-        float currentScale0;
-        float currentScale1;
         float currentOffset0;
         float currentOffset1;
-        float apowerScale0;
-        float apowerScale1;
-        float aenergyScale0;
-        float aenergyScale1;
         PgaGain voltagePgaGain;
         PgaGain currentPgaGain0;
         PgaGain currentPgaGain1;
     };
 
-    uint8_t getRegSize(uint16_t reg);
-    void write(uint16_t reg, int32_t value);
-    bool read(uint16_t reg, bool isSigned, int32_t& value);
+    void clearQueue();
+    void writeUart(uint16_t reg, int32_t value);
+    void writeI2c(uint16_t reg, int32_t value);
+    bool readI2c(uint16_t reg, bool sendStop, int32_t& value);
+    void processTransfer(uint64_t now);
+    void onRegisterRead(uint16_t reg, int32_t value, uint64_t now);
+    void onTransferError(uint16_t reg, uint64_t now);
 
     Mode m_mode;
     uint8_t m_peripheralIndex;
@@ -67,4 +95,10 @@ private:
     HardwareSerial* m_serial;
     uint64_t m_lastReadTimestamp;
     AdeConfig m_config;
+    State m_state;
+    TransferState m_transferState;
+    uint64_t m_stateTimestamp;
+    uint64_t m_requestTimestamp;
+    uint8_t m_receiveCount;
+    uint32_t m_receiveValue;
 };
\ No newline at end of file
@@ -33,24 +33,59 @@ const uint8_t BL0939_INIT[6][6] = {
     // 0x181C = Half cycle, Fast RMS threshold 6172
     {BL0939_WRITE_COMMAND, BL0939_REG_IB_FAST_RMS_CTRL, 0x1C, 0x18, 0x00, 0x08}};
 
+static constexpr PowerMeasDevice::DescriptorInfo BL0939_DESCRIPTORS[] PROGMEM = {
+    { "Voltage RMS", "V", ".0f", "voltage", true },
+    { "Current 1 RMS", "A", ".3f", "current1", true },
+    { "Current 2 RMS", "A", ".3f", "current2", true },
+    { "Power 1", "W", ".3f", "power1", true },
+    { "Power 2", "W", ".3f", "power2", true },
+    { "Energy 1", "Wh", ".0f", "energy1", true },
+    { "Energy 2", "Wh", ".0f", "energy2", true },
+    { "Total energy", "Wh", ".0f", "total_energy", true }
+};
+
+static constexpr float BL0939_IREF = 324004 * 1 / 1.218;
+static constexpr float BL0939_UREF = 79931 * 0.51 * 1000 / (1.218 * (5 * 390 + 0.51));
+static constexpr float BL0939_PREF = 4046 * 1 * 0.51 * 1000 / (1.218 * 1.218 * (5 * 390 + 0.51));
+static constexpr float BL0939_EREF = 3.6e6 * 4046 * 1 * 0.51 * 1000 / (1638.4 * 256 * 1.218 * 1.218 * (5 * 390 + 0.51));
+
+enum ScaleIndex
+{
+    SC_VOLTAGE = 0,
+    SC_CURRENT,
+    SC_POWER,
+    SC_ENERGY
+};
+
+static const float BL0939_SCALES[] = { 1 / BL0939_UREF, 1 / BL0939_IREF, 1 / BL0939_PREF, 1 / BL0939_EREF };
+
+// Fields of the full packet, address is offset in packet and whole packet is
+// decoded at once, so nothing is polled
+static constexpr PowerMeasRegisterDevice::RegisterInfo BL0939_FIELDS[] = {
+    // offset, width, flags, scale, factor, descriptor, cadence
+    { BL0939::OFS_V_RMS, 3, 0, PowerMeasRegisterDevice::scaleLinear, SC_VOLTAGE, 0, 0 },
+    { BL0939::OFS_IA_RMS, 3, 0, PowerMeasRegisterDevice::scaleLinear, SC_CURRENT, 1, 0 },
+    { BL0939::OFS_IB_RMS, 3, 0, PowerMeasRegisterDevice::scaleLinear, SC_CURRENT, 2, 0 },
+    { BL0939::OFS_A_WATT, 3, PowerMeasRegisterDevice::REG_SIGNED, PowerMeasRegisterDevice::scaleLinear, SC_POWER, 3, 0 },
+    { BL0939::OFS_B_WATT, 3, PowerMeasRegisterDevice::REG_SIGNED, PowerMeasRegisterDevice::scaleLinear, SC_POWER, 4, 0 },
+    { BL0939::OFS_CFA_CNT, 3, PowerMeasRegisterDevice::REG_SIGNED, PowerMeasRegisterDevice::scaleLinear, SC_ENERGY, 5, 0 },
+    { BL0939::OFS_CFB_CNT, 3, PowerMeasRegisterDevice::REG_SIGNED, PowerMeasRegisterDevice::scaleLinear, SC_ENERGY, 6, 0 }
+};
+
+static const uint8_t BL0939_FIELD_COUNT = sizeof(BL0939_FIELDS) / sizeof(BL0939_FIELDS[0]);
 
 BL0939::BL0939() :
-    PowerMeasDevice(),
-    m_serial(nullptr),
+    PowerMeasRegisterDevice(),
     m_serialIndex(PROFILE_DEFAULT_BL0939_SERIAL),
     m_rxGpio(PROFILE_DEFAULT_BL0939_RX_GPIO),
     m_txGpio(PROFILE_DEFAULT_BL0939_TX_GPIO),
     m_refreshPeriod(PROFILE_DEFAULT_BL0939_PERIOD_MILLI),
-    m_packetIndex(0)
+    m_ringHead(0),
+    m_ringTail(0),
+    m_badPackets(0)
 {
-    appendDescriptor("Voltage RMS", "V", ".0f", "voltage");
-    appendDescriptor("Current 1 RMS", "A", ".3f", "current1");
-    appendDescriptor("Current 2 RMS", "A", ".3f", "current2");
-    appendDescriptor("Power 1", "W", ".3f", "power1");
-    appendDescriptor("Power 2", "W", ".3f", "power2");
-    appendDescriptor("Energy 1", "Wh", ".0f", "energy1");
-    appendDescriptor("Energy 2", "Wh", ".0f", "energy2");
-    appendDescriptor("Total energy", "Wh", ".0f", "total_energy");
+    setDescriptors(BL0939_DESCRIPTORS, sizeof(BL0939_DESCRIPTORS) / sizeof(BL0939_DESCRIPTORS[0]));
+    setRegisterMap(BL0939_FIELDS, BL0939_FIELD_COUNT, BL0939_SCALES);
 }
 
 String BL0939::getChipInfo() const
@@ -61,38 +96,21 @@ String BL0939::getChipInfo() const
 void BL0939::init()
 {
     PowerMeasDevice::init();
-    m_serial = nullptr;
     m_serialIndex = Config::getInt("bl0939/serial", PROFILE_DEFAULT_BL0939_SERIAL);
     m_rxGpio = Config::getInt("bl0939/rx_gpio", PROFILE_DEFAULT_BL0939_RX_GPIO);
     m_txGpio = Config::getInt("bl0939/tx_gpio", PROFILE_DEFAULT_BL0939_TX_GPIO);
     m_refreshPeriod = Config::getInt("bl0939/refresh_milli", PROFILE_DEFAULT_BL0939_PERIOD_MILLI);
 
-    if (m_serialIndex == 0)
-        m_serial = &Serial;
-    else if (m_serialIndex == 1)
-        m_serial = &Serial1;
-#ifdef ESP32
-    else if (m_serialIndex == 2)
-        m_serial = &Serial2;
-#endif
-    m_packetIndex = 0;
     m_lastReadTimestamp = 0;
-    if (m_serial)
+    m_ringHead = 0;
+    m_ringTail = 0;
+    if (m_uart.begin(m_serialIndex, 4800, false, m_rxGpio, m_txGpio))
     {
-#ifdef ESP32
-        m_serial->begin(4800, SERIAL_8N1, m_rxGpio, m_txGpio);
-#else
-        m_serial->begin(4800, SERIAL_8N1);
-#endif
         for(uint8_t i = 0; i < 6; i++)
         {
-            for (uint8_t ii = 0; ii < 6; ii++)
-            {
-                m_serial->write(BL0939_INIT[i][ii]);
-            }
+            m_uart.write(BL0939_INIT[i], sizeof(BL0939_INIT[i]));
             delay(10);
         }
-        m_serial->flush();
         Log::info("BL0939", "Initialized, serial=%d, rx=%d, tx=%d, refresh period=%d ms", m_serialIndex, m_rxGpio, m_txGpio, m_refreshPeriod);
     }
     else
@@ -148,85 +166,97 @@ void BL0939::setConfiguration(String config, bool save, bool performInit)
     }
 }
 
-bool BL0939::validateChecksum(const DataPacket *data) 
+bool BL0939::validateChecksum() const
 {
     uint8_t checksum = BL0939_READ_COMMAND;
     // Whole package but checksum
-    for (uint32_t i = 0; i < sizeof(data->raw) - 1; i++) 
+    for (uint8_t i = 0; i < OFS_CHECKSUM; i++) 
     {
-        checksum += data->raw[i];
+        checksum += getRingByte(i);
     }
     checksum ^= 0xFF;
-    return checksum == data->checksum;
+    return checksum == getRingByte(OFS_CHECKSUM);
 }
 
-uint32_t BL0939::to_uint32_t(ube24_t input) 
+uint32_t BL0939::readUnsigned24(uint8_t offset) const
 { 
-    return input.h << 16 | input.m << 8 | input.l; 
+    return (uint32_t)getRingByte(offset + 2) << 16 | (uint32_t)getRingByte(offset + 1) << 8 | getRingByte(offset); 
 }
 
-int32_t BL0939::to_int32_t(sbe24_t input) 
-{ 
-    return input.h << 16 | input.m << 8 | input.l; 
+void BL0939::fillRing()
+{
+    // UART data are copied straight to free space of the ring, at most in two parts
+    for(uint8_t part = 0; part < 2; part++)
+    {
+        uint8_t count = m_ringHead - m_ringTail;
+        uint8_t head = m_ringHead & (RING_SIZE - 1);
+        uint8_t space = RING_SIZE - count;
+        if (space > RING_SIZE - head)
+            space = RING_SIZE - head;
+        if (space == 0)
+            break;
+        uint8_t read = (uint8_t)m_uart.read(&m_ring[head], space);
+        m_ringHead += read;
+        if (read < space)
+            break;
+    }
 }
 
-void BL0939::process()
+void BL0939::parseRing()
 {
-    if (m_serial)
+    while ((uint8_t)(m_ringHead - m_ringTail) >= PACKET_SIZE)
     {
-        uint64_t now = Time::nowRelativeMilli();
-        if (now >= m_lastReadTimestamp + m_refreshPeriod)
+        if ((getRingByte(OFS_HEADER) == BL0939_PACKET_HEADER) && validateChecksum())
         {
-            m_lastReadTimestamp = now;
-            m_serial->flush();
-            m_serial->write(BL0939_READ_COMMAND);
-            m_serial->write(BL0939_FULL_PACKET);
-            Log::verbose("BL0939", "Sending request");
+            Log::verbose("BL0939", "Valid packet received");
+            decodePacket();
+            m_ringTail += PACKET_SIZE;
         }
-        while(m_serial->available())
+        else
         {
-            uint8_t d = m_serial->read();
-            if ((m_packetIndex == 0) && (d == BL0939_PACKET_HEADER))
-            {
-                m_packet.raw[0] = d;
-                m_packetIndex++;
-            }
-            else if (m_packetIndex > 0)
+            // Next header may start anywhere in the rejected window
+            if (getRingByte(OFS_HEADER) == BL0939_PACKET_HEADER)
             {
-                m_packet.raw[m_packetIndex] = d;
-                m_packetIndex++;
-                if (m_packetIndex >= sizeof(DataPacket::raw))
-                {
-                    // Whole packet received
-                    if (validateChecksum(&m_packet))
-                    {
-                        Log::verbose("BL0939", "Valid packet received");
-                        float v_rms = (float) to_uint32_t(m_packet.v_rms) / BL0939_UREF;
-                        float ia_rms = (float) to_uint32_t(m_packet.ia_rms) / BL0939_IREF;
-                        float ib_rms = (float) to_uint32_t(m_packet.ib_rms) / BL0939_IREF;
-                        float a_watt = (float) to_int32_t(m_packet.a_watt) / BL0939_PREF;
-                        float b_watt = (float) to_int32_t(m_packet.b_watt) / BL0939_PREF;
-                        int32_t cfa_cnt = to_int32_t(m_packet.cfa_cnt);
-                        int32_t cfb_cnt = to_int32_t(m_packet.cfb_cnt);
-                        float a_energy_consumption = (float) cfa_cnt / BL0939_EREF;
-                        float b_energy_consumption = (float) cfb_cnt / BL0939_EREF;
-                        float total_energy_consumption = a_energy_consumption + b_energy_consumption;
-                        setLastValue(0, v_rms);
-                        setLastValue(1, ia_rms);
-                        setLastValue(2, ib_rms);
-                        setLastValue(3, a_watt);
-                        setLastValue(4, b_watt);
-                        setLastValue(5, a_energy_consumption);
-                        setLastValue(6, b_energy_consumption);
-                        setLastValue(7, total_energy_consumption);
-                    }
-                    else
-                    {
-                        Log::verbose("BL0939", "Invalid checksum");
-                    }
-                    m_packetIndex = 0;
-                }
+                m_badPackets++;
+                Log::verbose("BL0939", "Invalid checksum, %d bad packets", m_badPackets);
             }
+            m_ringTail++;
+        }
+    }
+}
+
+void BL0939::decodePacket()
+{
+    for(uint8_t i = 0; i < BL0939_FIELD_COUNT; i++)
+    {
+        uint8_t offset = BL0939_FIELDS[i].address;
+        storeRegister(offset, decodeRaw(offset, readUnsigned24(offset)));
+    }
+    // Energy 1 + energy 2
+    setLastValue(7, getLastValue(5) + getLastValue(6));
+    // Values are sampled by the chip when the request is received
+    emitSample(m_lastReadTimestamp);
+}
+
+void BL0939::process()
+{
+    if (m_uart.isOpen())
+    {
+        if (m_uart.getAvailable() > 0)
+        {
+            fillRing();
+            parseRing();
+        }
+        uint64_t now = Time::nowRelativeMilli();
+        if (now >= m_lastReadTimestamp + getRefreshPeriod(m_refreshPeriod, FAST_REFRESH_PERIOD_MILLI))
+        {
+            // Rest of previous response is broken, it must not be joined with the next one
+            m_ringTail = m_ringHead;
+            m_uart.discardInput();
+            m_lastReadTimestamp = now;
+            static const uint8_t request[] = { BL0939_READ_COMMAND, BL0939_FULL_PACKET };
+            m_uart.write(request, sizeof(request));
+            Log::verbose("BL0939", "Sending request");
         }
     }
 }
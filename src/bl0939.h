@@ -1,9 +1,29 @@
 #pragma once
-#include "power_meas_device.h"
+#include "power_meas_register_device.h"
+#include "power_meas_uart.h"
 
-class BL0939 : public PowerMeasDevice
+class BL0939 : public PowerMeasRegisterDevice
 {
 public:
+
+    // Field offsets in packet, 24 bit values are little endian (low - middle - high)
+    enum PacketOffset
+    {
+        OFS_HEADER = 0,
+        OFS_IA_FAST_RMS = 1,
+        OFS_IA_RMS = 4,
+        OFS_IB_RMS = 7,
+        OFS_V_RMS = 10,
+        OFS_IB_FAST_RMS = 13,
+        OFS_A_WATT = 16,
+        OFS_B_WATT = 19,
+        OFS_CFA_CNT = 22,
+        OFS_CFB_CNT = 25,
+        OFS_TPS1 = 28,
+        OFS_TPS2 = 31,
+        OFS_CHECKSUM = 34
+    };
+
     BL0939();
 
     void init() override;
@@ -20,63 +40,38 @@ protected:
 
 private:
 
-    static constexpr float BL0939_IREF = 324004 * 1 / 1.218;
-    static constexpr float BL0939_UREF = 79931 * 0.51 * 1000 / (1.218 * (5 * 390 + 0.51));
-    static constexpr float BL0939_PREF = 4046 * 1 * 0.51 * 1000 / (1.218 * 1.218 * (5 * 390 + 0.51));
-    static constexpr float BL0939_EREF = 3.6e6 * 4046 * 1 * 0.51 * 1000 / (1638.4 * 256 * 1.218 * 1.218 * (5 * 390 + 0.51));
-
-    struct ube24_t {  // NOLINT(readability-identifier-naming,altera-struct-pack-align)
-        uint8_t l;
-        uint8_t m;
-        uint8_t h;
-    } __attribute__((packed));
-
-    struct ube16_t {  // NOLINT(readability-identifier-naming,altera-struct-pack-align)
-        uint8_t l;
-        uint8_t h;
-    } __attribute__((packed));
-
-    struct sbe24_t {  // NOLINT(readability-identifier-naming,altera-struct-pack-align)
-        uint8_t l;
-        uint8_t m;
-        int8_t h;
-    } __attribute__((packed));
-
-    // Caveat: All these values are big endian (low - middle - high)
-
-    union DataPacket {  // NOLINT(altera-struct-pack-align)
-        uint8_t raw[35];
-        struct {
-            uint8_t frame_header;  // 0x55 according to docs
-            ube24_t ia_fast_rms;
-            ube24_t ia_rms;
-            ube24_t ib_rms;
-            ube24_t v_rms;
-            ube24_t ib_fast_rms;
-            sbe24_t a_watt;
-            sbe24_t b_watt;
-            sbe24_t cfa_cnt;
-            sbe24_t cfb_cnt;
-            ube16_t tps1;
-            uint8_t RESERVED1;  // value of 0x00
-            ube16_t tps2;
-            uint8_t RESERVED2;  // value of 0x00
-            uint8_t checksum;   // checksum
-        };
-    } __attribute__((packed));
-
-    static bool validateChecksum(const DataPacket *data);
-
-    uint32_t to_uint32_t(ube24_t input);
-
-    int32_t to_int32_t(sbe24_t input);
-
-    HardwareSerial* m_serial;
+    // Fastest useful request rate, RMS registers are updated every ~100 ms
+    static constexpr uint32_t FAST_REFRESH_PERIOD_MILLI = 100;
+
+    // Received bytes are parsed in place, size is power of two
+    static constexpr uint8_t RING_SIZE = 128;
+    static constexpr uint8_t PACKET_SIZE = 35;
+
+    inline uint8_t getRingByte(uint8_t offset) const
+    {
+        return m_ring[(uint8_t)(m_ringTail + offset) & (RING_SIZE - 1)];
+    }
+
+    void fillRing();
+
+    // Decodes all complete packets in ring, rescans from next byte after bad packet
+    void parseRing();
+
+    bool validateChecksum() const;
+
+    uint32_t readUnsigned24(uint8_t offset) const;
+
+    void decodePacket();
+
+    PowerMeasUart m_uart;
     uint8_t m_serialIndex;
     uint8_t m_rxGpio;
     uint8_t m_txGpio;
     uint32_t m_refreshPeriod;
-    uint8_t m_packetIndex;
-    DataPacket m_packet;
+    uint8_t m_ring[RING_SIZE];
+    // Free running indexes, count is head - tail
+    uint8_t m_ringHead;
+    uint8_t m_ringTail;
+    uint32_t m_badPackets;
     uint64_t m_lastReadTimestamp;
 };
\ No newline at end of file
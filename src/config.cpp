@@ -5,11 +5,14 @@
 #include "log.h"
 
 Config::Config() :
-    m_json(MAX_JSON_SIZE)
+    m_json(MAX_JSON_SIZE),
+    m_keyDropped(false),
+    m_saved(true)
 {
-    EEPROM.begin(MAX_JSON_SIZE);
+    // Larger area keeps content of the previous smaller one
+    EEPROM.begin(EEPROM_SIZE);
     Log::info("Config", "Trying to read configuration file");
-    EepromStream eepromStream(0, MAX_JSON_SIZE);
+    EepromStream eepromStream(0, EEPROM_SIZE);
     DeserializationError error = deserializeJson(m_json, eepromStream);
     if (error) 
     {
@@ -17,48 +20,80 @@ Config::Config() :
     }
 }
 
-void Config::flush()
+bool Config::flush()
 {
+    Config& inst = getInstance();
     Log::info("Config", "Trying to write configuration file");
-    EepromStream eepromStream(0, MAX_JSON_SIZE);
-    if (serializeJson(getInstance().m_json, eepromStream) == 0) 
+    inst.m_saved = !inst.m_keyDropped;
+    inst.m_keyDropped = false;
+    // Truncated image would not be parsed on next boot, old image is kept instead
+    size_t size = measureJson(inst.m_json);
+    if (size >= EEPROM_SIZE)
+    {
+        Log::error("Config", "Configuration too large (%d bytes, max %d), not written", size, EEPROM_SIZE - 1);
+        inst.m_saved = false;
+        return false;
+    }
+    EepromStream eepromStream(0, EEPROM_SIZE);
+    if (serializeJson(inst.m_json, eepromStream) == 0) 
     {
         Log::error("Config", "Failed to write configuration file");
+        inst.m_saved = false;
     }
     eepromStream.flush();
+    return inst.m_saved;
+}
+
+bool Config::isSaved()
+{
+    return getInstance().m_saved;
 }
 
 void Config::clearAll()
 {
     Log::info("Config", "Clearing configuration");
-    EEPROM.begin(MAX_JSON_SIZE);
-    for(size_t i = 0; i < MAX_JSON_SIZE; i++)
+    EEPROM.begin(EEPROM_SIZE);
+    for(size_t i = 0; i < EEPROM_SIZE; i++)
         EEPROM.write(i, 0);
     EEPROM.end();
-    EEPROM.begin(MAX_JSON_SIZE);
+    EEPROM.begin(EEPROM_SIZE);
+}
+
+template<typename T>
+void Config::setValue(const char* key, T value)
+{
+    DynamicJsonDocument& json = getInstance().m_json;
+    if (json[key].set(value))
+        return;
+    json.garbageCollect();
+    if (!json[key].set(value))
+    {
+        getInstance().m_keyDropped = true;
+        Log::error("Config", "Configuration full, key %s not set", key);
+    }
 }
 
 void Config::setInt(const char* key, int value)
 {
-    getInstance().m_json[key] = value;
+    setValue(key, value);
     Log::debug("Config", "Set key %s to %d", key, value);
 }
 
 void Config::setString(const char* key, String value)
 {
-    getInstance().m_json[key] = value;
+    setValue(key, value);
     Log::debug("Config", "Set key %s to \"%s\"", key, value.c_str());
 }
 
 void Config::setFloat(const char* key, float value)
 {
-    getInstance().m_json[key] = value;
+    setValue(key, value);
     Log::debug("Config", "Set key %s to %f", key, value);
 }
 
 void Config::setBool(const char* key, bool value)
 {
-    getInstance().m_json[key] = value;
+    setValue(key, value);
     Log::debug("Config", "Set key %s to %d", key, value);
 }
 
@@ -89,6 +124,12 @@ float Config::getFloat(const char* key, float defaultValue)
     return value;
 }
 
+void Config::remove(const char* key)
+{
+    getInstance().m_json.remove(key);
+    Log::debug("Config", "Removed key %s", key);
+}
+
 bool Config::getBool(const char* key, bool defaultValue)
 {
     bool value = defaultValue;
@@ -7,9 +7,18 @@ public:
 
     static constexpr const char* VERSION = "0.0.6";
 
-    static constexpr size_t MAX_JSON_SIZE = 2048;
+    // EEPROM image of serialized JSON, images of older versions (2048 bytes)
+    // are its prefix and are read unchanged
+    static constexpr size_t EEPROM_SIZE = 4096;
+    // Memory pool of parsed document, keys and string values are copied into it
+    static constexpr size_t MAX_JSON_SIZE = 6144;
 
-    static void flush();
+    // Returns false when the image does not fit into EEPROM or a key did not
+    // fit into the pool since the last flush, the rest is written anyway
+    static bool flush();
+
+    // Result of the last flush, settings pages report unsaved configuration
+    static bool isSaved();
 
     static void clearAll();
 
@@ -29,10 +38,16 @@ public:
 
     static bool getBool(const char* key, bool defaultValue = false);
 
+    static void remove(const char* key);
+
 private:
 
     Config();
 
+    // Replaced strings are released by garbage collection when pool is full
+    template<typename T>
+    static void setValue(const char* key, T value);
+
     static inline Config& getInstance()
     {
         static Config config;
@@ -40,4 +55,6 @@ private:
     }
 
     DynamicJsonDocument m_json;
+    bool m_keyDropped;
+    bool m_saved;
 };
\ No newline at end of file
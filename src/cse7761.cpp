@@ -1,4 +1,5 @@
 #include "cse7761.h"
+#include <math.h>
 #include "log.h"
 #include "time.h"
 #include "config.h"
@@ -80,30 +81,112 @@ static const uint8_t CSE_REG_ENERGYAC = 0x76;
 static const uint8_t CSE_REG_ENERGYBC = 0x77;
 static const uint8_t CSE_REG_DEVICEID = 0x7f;
 static const uint8_t CSE_REG_SPECIAL = 0xea;
+static const uint8_t CSE_SPECIAL_RESET = 0x96;
 
 static const uint32_t CSE_DEVICEID = 0x776110;
 
 static const uint64_t CSE_RECEIVE_TIMEOUT_MILLI = 100;
 static const uint64_t CSE_DETECT_PERIOD_MILLI = 1000;
+static const uint64_t CSE_RESET_TIME_MILLI = 1000;
+// Maximal time spent in transfer engine per single process() call
+static const uint32_t CSE_PROCESS_BUDGET_MICRO = 300;
+
+static constexpr PowerMeasDevice::DescriptorInfo CSE7761_DESCRIPTORS[] PROGMEM = {
+    { "Voltage RMS", "V", ".0f", "voltage", true },
+    { "Frequency", "Hz", ".0f", "frequency", true },
+    { "Current 1 RMS", "A", ".3f", "current1", true },
+    { "Power 1", "W", ".3f", "power1", true },
+    { "Current 2 RMS", "A", ".3f", "current2", true },
+    { "Power 2", "W", ".3f", "power2", true },
+    { "Fast current RMS", "A", ".3f", "current_fast", true }
+    //{ "Energy 1", "Wh", ".0f", "energy1", true },
+    //{ "Energy 2", "Wh", ".0f", "energy2", true },
+    //{ "Total energy", "Wh", ".0f", "total_energy", true }
+};
+
+static float scaleVoltage(int32_t raw, float coefficient)
+{
+    if ((uint32_t)raw >= 0x800000)
+        return 0;
+    return 0.01 * (double)raw * coefficient / (double)0x400000;
+}
+
+static float scaleFrequency(int32_t raw, float coefficient)
+{
+    if ((raw == 0) || ((uint32_t)raw >= 0x8000))
+        return 0;
+    return (double)CSE7761_FREF / 8.0 / (double)raw;
+}
+
+static float scaleCurrent(int32_t raw, float coefficient)
+{
+    // No load threshold of 10mA
+    if (((uint32_t)raw >= 0x800000) || (raw < 1600))
+        return 0;
+    return 0.001 * (double)raw * coefficient / (double)0x800000;
+}
+
+static float scaleWaveCurrent(int32_t raw, float coefficient)
+{
+    // Signed waveform sample, same scale as RMS register
+    return 0.001 * (double)raw * coefficient / (double)0x800000;
+}
+
+static float scalePower(int32_t raw, float coefficient)
+{
+    return fabs((double)raw) * coefficient / (double)0x80000000;
+}
+
+typedef PowerMeasRegisterDevice::RegisterInfo RegisterInfo;
+static const uint8_t CAPTURE = PowerMeasRegisterDevice::REG_SIGNED | PowerMeasRegisterDevice::REG_CAPTURE;
+static const uint8_t NO_DESC = PowerMeasRegisterDevice::NO_DESCRIPTOR;
+
+// Polled registers first in read order
+static constexpr RegisterInfo CSE7761_REGISTERS[] = {
+    // address, width, flags, scale, factor, descriptor, cadence
+    { CSE_REG_RMSU, 3, 0, scaleVoltage, CSE7761::COEF_RMS_UC, 0, 1 },
+    { CSE_REG_UFREQ, 2, 0, scaleFrequency, 0, 1, 5 },
+    { CSE_REG_RMSIA, 3, 0, scaleCurrent, CSE7761::COEF_RMS_IAC, 2, 1 },
+    { CSE_REG_POWERPA, 4, PowerMeasRegisterDevice::REG_SIGNED, scalePower, CSE7761::COEF_POWER_PAC, 3, 1 },
+    { CSE_REG_RMSIB, 3, 0, scaleCurrent, CSE7761::COEF_RMS_IBC, 4, 1 },
+    { CSE_REG_POWERPB, 4, PowerMeasRegisterDevice::REG_SIGNED, scalePower, CSE7761::COEF_POWER_PBC, 5, 1 },
+    // Waveform of current channels, read while capture runs
+    { CSE_REG_WAVEIA, 3, CAPTURE, scaleWaveCurrent, CSE7761::COEF_RMS_IAC, 6, 0 },
+    { CSE_REG_WAVEIB, 3, CAPTURE, scaleWaveCurrent, CSE7761::COEF_RMS_IBC, 6, 0 },
+    // Control registers
+    { CSE_REG_SYSCON, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_EMUCON, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_EMUCON2, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_PULSE1SEL, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_SYSSTATUS, 1, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_COEFF_CHKSUM, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_RMSIAC, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_RMSIBC, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_RMSUC, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_POWERPAC, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_POWERPBC, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_POWERSC, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_ENERGYAC, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_ENERGYBC, 2, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_DEVICEID, 3, 0, nullptr, 0, NO_DESC, 0 },
+    { CSE_REG_SPECIAL, 1, 0, nullptr, 0, NO_DESC, 0 }
+};
 
 CSE7761::CSE7761() :
-    PowerMeasDevice(),
-    m_serial(nullptr),
+    PowerMeasRegisterDevice(),
     m_state(CSE_ST_IDLE),
     m_serialIndex(PROFILE_DEFAULT_CSE7761_SERIAL),
     m_rxGpio(PROFILE_DEFAULT_CSE7761_RX_GPIO),
     m_txGpio(PROFILE_DEFAULT_CSE7761_TX_GPIO),
-    m_refreshPeriod(PROFILE_DEFAULT_CSE7761_PERIOD_MILLI)
+    m_refreshPeriod(PROFILE_DEFAULT_CSE7761_PERIOD_MILLI),
+    m_lastReadTimestamp(0),
+    m_stateTimestamp(0),
+    m_transferState(CSE_TR_IDLE),
+    m_requestTimestamp(0)
 {
-    appendDescriptor("Voltage RMS", "V", ".0f", "voltage");
-    appendDescriptor("Frequency", "Hz", ".0f", "frequency");
-    appendDescriptor("Current 1 RMS", "A", ".3f", "current1");
-    appendDescriptor("Power 1", "W", ".3f", "power1");
-    appendDescriptor("Current 2 RMS", "A", ".3f", "current2");
-    appendDescriptor("Power 2", "W", ".3f", "power2");
-    //appendDescriptor("Energy 1", "Wh", ".0f", "energy1");
-    //appendDescriptor("Energy 2", "Wh", ".0f", "energy2");
-    //appendDescriptor("Total energy", "Wh", ".0f", "total_energy");
+    memset(m_coefficients, 0, sizeof(m_coefficients));
+    setDescriptors(CSE7761_DESCRIPTORS, sizeof(CSE7761_DESCRIPTORS) / sizeof(CSE7761_DESCRIPTORS[0]));
+    setRegisterMap(CSE7761_REGISTERS, sizeof(CSE7761_REGISTERS) / sizeof(CSE7761_REGISTERS[0]), m_coefficients);
 }
 
 String CSE7761::getChipInfo() const
@@ -114,29 +197,17 @@ String CSE7761::getChipInfo() const
 void CSE7761::init()
 {
     PowerMeasDevice::init();
-    m_serial = nullptr;
     m_serialIndex = Config::getInt("cse7761/serial", PROFILE_DEFAULT_CSE7761_SERIAL);
     m_rxGpio = Config::getInt("cse7761/rx_gpio", PROFILE_DEFAULT_CSE7761_RX_GPIO);
     m_txGpio = Config::getInt("cse7761/tx_gpio", PROFILE_DEFAULT_CSE7761_TX_GPIO);
     m_refreshPeriod = Config::getInt("cse7761/refresh_milli", PROFILE_DEFAULT_CSE7761_PERIOD_MILLI);
 
-    if (m_serialIndex == 0)
-        m_serial = &Serial;
-    else if (m_serialIndex == 1)
-        m_serial = &Serial1;
-#ifdef ESP32
-    else if (m_serialIndex == 2)
-        m_serial = &Serial2;
-#endif
     m_lastReadTimestamp = 0;
+    m_stateTimestamp = 0;
     m_state = CSE_ST_DETECT;
-    if (m_serial)
+    clearQueue();
+    if (m_uart.begin(m_serialIndex, 38400, true, m_rxGpio, m_txGpio))
     {
-#ifdef ESP32
-        m_serial->begin(38400, SERIAL_8E1, m_rxGpio, m_txGpio);
-#else
-        m_serial->begin(38400, SERIAL_8E1);
-#endif
         Log::info("CSE7761", "Initialized, serial=%d, rx=%d, tx=%d, refresh period=%d ms", m_serialIndex, m_rxGpio, m_txGpio, m_refreshPeriod);
     }
     else
@@ -203,110 +274,176 @@ uint8_t CSE7761::calculateChecksum(uint8_t size)
     return chk;
 }
 
-uint8_t CSE7761::getRegisterSize(uint8_t reg)
+void CSE7761::clearQueue()
 {
-    if ((reg == CSE_REG_PHASEA) || (reg == CSE_REG_PHASEB) || (reg == CSE_REG_SPECIAL))
-        return 1;
-    else if ((reg >= CSE_REG_RMSIA) && (reg <= CSE_REG_ENERGY_PB))
-        return 3;
-    else if ((reg >= CSE_REG_POWERPA) && (reg <= CSE_REG_POWERS))
-        return 4;
-    else if ((reg >= CSE_REG_EMUSTATUS) && (reg <= CSE_REG_WAVEU))
-        return 3;
-    else if ((reg >= CSE_REG_INSTANTP) && (reg <= CSE_REG_INSTANTS))
-        return 4;
-    else if (reg == CSE_REG_SYSSTATUS)
-        return 1;
-    else if (reg == CSE_REG_RDATA)
-        return 4;
-    else if (reg == CSE_REG_DEVICEID)
-        return 3;
-    return 2;
+    clearRequests();
+    m_transferState = CSE_TR_IDLE;
 }
 
-bool CSE7761::writeRegister(uint8_t reg, uint32_t value)
+void CSE7761::sendRequest(const Request& request, uint64_t now)
 {
-    if (!m_serial)
-        return false;
-    uint8_t size = getRegisterSize(reg);
     m_packet[0] = CSE_PACKET_HEADER;
-    m_packet[1] = CSE_CMD_WRITE | reg;
-    Log::verbose("CSE7761", "Writing register 0x%x = 0x%x, size %d", reg, value, size);
-    for(uint8_t i = 0; i < size; i++)
+    if (request.write)
+    {
+        uint8_t size = getRegisterWidth(request.reg);
+        uint32_t value = (uint32_t)request.value;
+        m_packet[1] = CSE_CMD_WRITE | request.reg;
+        Log::verbose("CSE7761", "Writing register 0x%x = 0x%x, size %d", request.reg, request.value, size);
+        for(uint8_t i = 0; i < size; i++)
+        {
+            m_packet[1 + size - i] = value & 0xff;
+            value >>= 8;
+        }
+        m_packet[2 + size] = calculateChecksum(2 + size);
+        m_uart.write(m_packet, 3 + size);
+        if ((request.reg == CSE_REG_SPECIAL) && (request.value == CSE_SPECIAL_RESET))
+            m_stateTimestamp = now;
+    }
+    else
     {
-        m_packet[1 + size - i] = value & 0xff;
-        value >>= 8;
+        // Drop any stale bytes so response starts with clean frame
+        m_uart.discardInput();
+        m_packet[1] = CSE_CMD_READ | request.reg;
+        m_uart.write(m_packet, 2);
+        m_requestTimestamp = now;
+        m_transferState = CSE_TR_RECEIVE;
     }
-    m_packet[2 + size] = calculateChecksum(2 + size);
-    m_serial->flush();
-    m_serial->write(m_packet, 3 + size);
-    return true;
 }
 
-bool CSE7761::readRegister(uint8_t reg, uint32_t& result)
+void CSE7761::processTransfer(uint64_t now)
 {
-    if (!m_serial)
-        return false;
-    uint8_t size = getRegisterSize(reg);
-    m_packet[0] = CSE_PACKET_HEADER;
-    m_packet[1] = reg;
-    m_serial->flush();
-    m_serial->write(m_packet, 2);
-    uint8_t packetIndex = 2;
-    uint32_t readStartTimestamp = Time::nowRelativeMilli();
-    while (1)
+    uint32_t start = micros();
+    while ((uint32_t)(micros() - start) < CSE_PROCESS_BUDGET_MICRO)
     {
-        if (Time::nowRelativeMilli() > (readStartTimestamp + CSE_RECEIVE_TIMEOUT_MILLI))
+        if (m_transferState == CSE_TR_IDLE)
         {
-            Log::error("CSE7761", "Receive timeout, register 0x%x, received %d bytes", reg, packetIndex - 2);
-            return false;
+            // Idle line between refreshes samples the waveform
+            if ((getRequestCount() == 0) && ((m_state != CSE_ST_READ) || !queueCaptureRead()))
+                break;
+            Request request = getRequest(0);
+            if (request.write)
+                popRequest();
+            sendRequest(request, now);
+            continue;
         }
-        if (m_serial->available())
+        // Waiting for read response, data and checksum follow the sent header and command
+        uint8_t reg = getRequest(0).reg;
+        uint8_t size = getRegisterWidth(reg);
+        if (!m_uart.receiveFrame(m_packet + 2, size + 1))
         {
-            uint8_t d = m_serial->read();
-            m_packet[packetIndex] = d;
-            packetIndex++;
-            if (packetIndex == size + 3)
+            if (now > m_requestTimestamp + CSE_RECEIVE_TIMEOUT_MILLI)
             {
-                result = 0;
-                uint8_t chk = calculateChecksum(size + 2);
-                if (chk != m_packet[size + 2])
-                {
-                    Log::error("CSE7761", "Receive error - bad checksum (0x%x != 0x%x)", chk, m_packet[size + 2]);
-                    return false;
-                }
-                for(uint8_t i = 0; i < size; i++)
-                {
-                    result <<= 8;
-                    result |= m_packet[2 + i];
-                }
-                Log::verbose("CSE7761", "Register 0x%x = 0x%x (size %d)", reg, result, size);
-                return true;
+                Log::error("CSE7761", "Receive timeout, register 0x%x, received %d bytes", reg, m_uart.getAvailable());
+                popRequest();
+                m_transferState = CSE_TR_IDLE;
+                onTransferError(reg, now);
+                continue;
             }
+            // Nothing to do until the response is complete
+            break;
         }
+        // Whole frame received - next request is sent right away
+        popRequest();
+        m_transferState = CSE_TR_IDLE;
+        uint8_t chk = calculateChecksum(size + 2);
+        if (chk != m_packet[size + 2])
+        {
+            Log::error("CSE7761", "Receive error - bad checksum (0x%x != 0x%x)", chk, m_packet[size + 2]);
+            onTransferError(reg, now);
+            continue;
+        }
+        uint32_t value = 0;
+        for(uint8_t i = 0; i < size; i++)
+        {
+            value <<= 8;
+            value |= m_packet[2 + i];
+        }
+        Log::verbose("CSE7761", "Register 0x%x = 0x%x (size %d)", reg, value, size);
+        onRegisterRead(reg, decodeRaw(reg, value));
     }
-    return false;
 }
 
-bool CSE7761::readRegister(uint8_t reg, uint16_t& result)
+void CSE7761::onRegisterRead(uint8_t reg, int32_t value)
 {
-    uint32_t value;
-    bool ret = readRegister(reg, value);
-    result = value & 0xffff;
-    return ret;
+    if (storeRegister(reg, value))
+        return;
+    if ((reg >= CSE_REG_RMSIAC) && (reg <= CSE_REG_ENERGYBC))
+    {
+        m_coefficients[reg - CSE_REG_RMSIAC] = value & 0xffff;
+        return;
+    }
+    switch(reg)
+    {
+        case CSE_REG_DEVICEID:
+            if (m_state == CSE_ST_DETECT)
+            {
+                Log::verbose("CSE7761", "Device detected, ID = 0x%x", value);
+                // Reset
+                queueWrite(CSE_REG_SPECIAL, CSE_SPECIAL_RESET);
+                m_state = CSE_ST_RESET;
+            }
+            break;
+        case CSE_REG_COEFF_CHKSUM:
+            //if ((calcChksum != coeffChksum) || (!calcChksum)) 
+            {
+                Log::debug("CSE7761", "Default calibration");
+                m_coefficients[COEF_RMS_IAC] = CSE7761_IREF;
+                m_coefficients[COEF_RMS_IBC] = CSE7761_IREF;
+            //    CSE7761Data.coefficient[RmsIBC] = 0xCC05;
+                m_coefficients[COEF_RMS_UC] = CSE7761_UREF;
+                m_coefficients[COEF_POWER_PAC] = CSE7761_PREF;
+                m_coefficients[COEF_POWER_PBC] = CSE7761_PREF;
+            //    CSE7761Data.coefficient[PowerPBC] = 0xADD7;
+            }
+            break;
+        case CSE_REG_SYSSTATUS:
+            if (value & 0x10)
+            {
+                queueWrite(CSE_REG_SYSCON, 0xFF04);
+                queueWrite(CSE_REG_EMUCON, 0x1183);
+                queueWrite(CSE_REG_EMUCON2, 0x0FE5);
+                queueWrite(CSE_REG_PULSE1SEL, 0x3290);
+                // Disable writing
+                queueWrite(CSE_REG_SPECIAL, 0xdc);
+                // SYSCON read back finishes init sequence
+                queueRead(CSE_REG_SYSCON);
+            }
+            else
+            {
+                Log::error("CSE7761", "Registers are write protected");
+                Log::error("CSE7761", "Cannot initialize");
+                clearQueue();
+                m_state = CSE_ST_DETECT;
+            }
+            break;
+        case CSE_REG_SYSCON:
+            Log::verbose("CSE7761", "SYSCON = 0x%x", value);
+            if (m_state == CSE_ST_INIT)
+            {
+                m_state = CSE_ST_READ;
+                Log::verbose("CSE7761", "Init finished");
+            }
+            break;
+    }
 }
 
-bool CSE7761::readRegister(uint8_t reg, uint8_t& result)
+void CSE7761::onTransferError(uint8_t reg, uint64_t now)
 {
-    uint32_t value;
-    bool ret = readRegister(reg, value);
-    result = value & 0xff;
-    return ret;
+    onReadError(reg);
+    if ((m_state == CSE_ST_DETECT) || (m_state == CSE_ST_INIT))
+    {
+        // Init sequence cannot continue, start from scratch
+        if (m_state == CSE_ST_INIT)
+            Log::error("CSE7761", "Cannot initialize");
+        clearQueue();
+        m_state = CSE_ST_DETECT;
+        m_lastReadTimestamp = now;
+    }
 }
 
 void CSE7761::process()
 {
-    if (m_serial)
+    if (m_uart.isOpen())
     {
         uint64_t now = Time::nowRelativeMilli();
 
@@ -315,189 +452,38 @@ void CSE7761::process()
             case CSE_ST_IDLE:
                 break;
             case CSE_ST_DETECT:
-                if (now > m_lastReadTimestamp + CSE_DETECT_PERIOD_MILLI)
+                if ((getRequestCount() == 0) && (now > m_lastReadTimestamp + CSE_DETECT_PERIOD_MILLI))
                 {
                     m_lastReadTimestamp = now;
                     Log::verbose("CSE7761", "Sending detect request");
-                    uint32_t value;
-                    if (readRegister(CSE_REG_DEVICEID, value))
-                    {
-                        Log::verbose("CSE7761", "Device detected, ID = 0x%x", value);
-                        // Reset
-                        if (!writeRegister(CSE_REG_SPECIAL, 0x96))
-                        {
-                            m_state = CSE_ST_DETECT;
-                            break;
-                        }
-                        m_registerIndex = 0;
-                        m_state = CSE_ST_INIT;
-                    }
+                    queueRead(CSE_REG_DEVICEID);
                 }
                 break;
-            case CSE_ST_INIT:
-                if (now > m_lastReadTimestamp + 1000)
+            case CSE_ST_RESET:
+                // Reset write is popped when sent, empty queue means settle time runs
+                if ((getRequestCount() == 0) && (now > m_stateTimestamp + CSE_RESET_TIME_MILLI))
                 {
-                    uint16_t calcChksum = 0xFFFF;
-                    for (uint32_t i = 0; i < 8; i++) 
-                    {
-                        uint32_t value;
-                        if (!readRegister(CSE_REG_RMSIAC + i, m_data.coefficient[i]))
-                        {
-                            m_state = CSE_ST_DETECT;
-                        }
-                        calcChksum += m_data.coefficient[i];
-                    }
-                    calcChksum = ~calcChksum;
-                    //  uint16_t dummy = Cse7761Read(CSE7761_REG_COEFFOFFSET, 2);
-                    uint16_t coeffChksum;
-                    if (!readRegister(CSE_REG_COEFF_CHKSUM, coeffChksum))
-                    {
-                        m_state = CSE_ST_DETECT;
-                    }
-                    //if ((calcChksum != coeffChksum) || (!calcChksum)) 
-                    {
-                        Log::debug("CSE7761", "Default calibration");
-                        m_data.coefficient[COEF_RMS_IAC] = CSE7761_IREF;
-                        m_data.coefficient[COEF_RMS_IBC] = CSE7761_IREF;
-                    //    CSE7761Data.coefficient[RmsIBC] = 0xCC05;
-                        m_data.coefficient[COEF_RMS_UC] = CSE7761_UREF;
-                        m_data.coefficient[COEF_POWER_PAC] = CSE7761_PREF;
-                        m_data.coefficient[COEF_POWER_PBC] = CSE7761_PREF;
-                    //    CSE7761Data.coefficient[PowerPBC] = 0xADD7;
-                    }
+                    for (uint8_t i = 0; i < 8; i++) 
+                        queueRead(CSE_REG_RMSIAC + i);
+                    queueRead(CSE_REG_COEFF_CHKSUM);
                     // Enable writing
-                    if (!writeRegister(CSE_REG_SPECIAL, 0xe5))
-                        m_state = CSE_ST_DETECT;
-                    uint8_t sysStatus;
-                    if (readRegister(CSE_REG_SYSSTATUS, sysStatus) && (sysStatus & 0x10))
-                    {
-                        if (!writeRegister(CSE_REG_SYSCON, 0xFF04))
-                            m_state = CSE_ST_DETECT;
-                        uint16_t syscon;
-                        if (!readRegister(CSE_REG_SYSCON, syscon))
-                        {
-                            m_state = CSE_ST_DETECT;
-                            break;
-                        }
-
-                        Log::verbose("CSE7761", "SYSCON = 0x%x", syscon);
-
-                        if (!writeRegister(CSE_REG_EMUCON, 0x1183))
-                            m_state = CSE_ST_DETECT;
-                        if (!writeRegister(CSE_REG_EMUCON2, 0x0FE5))
-                            m_state = CSE_ST_DETECT;
-                        if (!writeRegister(CSE_REG_PULSE1SEL, 0x3290))
-                            m_state = CSE_ST_DETECT;
-                        // Disable writing
-                        if (!writeRegister(CSE_REG_SPECIAL, 0xdc))
-                            m_state = CSE_ST_DETECT;
-                        m_state = CSE_ST_INIT;
-                    }
-                    else
-                    {
-                        Log::error("CSE7761", "Registers are write protected");
-                        m_state = CSE_ST_DETECT;
-                    }
-                    if (m_state == CSE_ST_INIT)
-                    {
-                        m_state = CSE_ST_READ;
-                        Log::verbose("CSE7761", "Init finished");
-                    }
-                    else
-                        Log::error("CSE7761", "Cannot initialize");
+                    queueWrite(CSE_REG_SPECIAL, 0xe5);
+                    queueRead(CSE_REG_SYSSTATUS);
+                    m_state = CSE_ST_INIT;
                 }
                 break;
+            case CSE_ST_INIT:
+                break;
             case CSE_ST_READ:
-                if (now >= m_lastReadTimestamp + m_refreshPeriod)
+                // Waveform read may be queued, refresh reads follow it
+                if (!isBatchPending() && (now >= m_lastReadTimestamp + getRefreshPeriod(m_refreshPeriod, FAST_REFRESH_PERIOD_MILLI)))
                 {
                     m_lastReadTimestamp = now;
                     Log::verbose("CSE7761", "Reading data");
-                    uint32_t value;
-                    if (readRegister(CSE_REG_RMSU, value))
-                    {
-                        m_data.voltage_rms = (value >= 0x800000) ? 0 : value;
-                        double val = 0.01 * (double)m_data.voltage_rms * (double)m_data.coefficient[COEF_RMS_UC] / (double)0x400000;
-                        setLastValue(0, val);
-                    }
-                    if (readRegister(CSE_REG_UFREQ, value))
-                    {
-                        m_data.frequency = (value >= 0x8000) ? 0 : value;
-                        double val;
-                        if (m_data.frequency == 0)
-                            val = 0;
-                        else 
-                            val = 3579545./8./m_data.frequency;
-                        setLastValue(1, val);
-                    }
-                    if (readRegister(CSE_REG_RMSIA, value))
-                    {
-                        m_data.current_rms[0] = ((value >= 0x800000) || (value < 1600)) ? 0 : value;  // No load threshold of 10mA
-                        //double val = 0.001 * (double)m_data.current_rms[0] * (double)m_data.coefficient[COEF_RMS_IAC] / (double)0x800000;
-                        double val = (double)m_data.current_rms[0] / ((0x800000 * 100 / this->m_data.coefficient[COEF_RMS_IAC]) * 10);
-                        setLastValue(2, val);
-                    }
-                    if (readRegister(CSE_REG_POWERPA, value))
-                    {
-                        m_data.active_power[0] = (0 == value) ? 0 : (value & 0x80000000) ? (~value) + 1 : value;
-                        double val = (double)m_data.active_power[0] * (double)m_data.coefficient[COEF_POWER_PAC] / (double)0x80000000;
-                        setLastValue(3, val);
-                    }
-                    if (readRegister(CSE_REG_RMSIB, value))
-                    {
-                        m_data.current_rms[1] = ((value >= 0x800000) || (value < 1600)) ? 0 : value;  // No load threshold of 10mA
-                        double val = 0.001 * (double)m_data.current_rms[1] * (double)m_data.coefficient[COEF_RMS_IBC] / (double)0x800000;
-                        setLastValue(4, val);
-                    }
-                    if (readRegister(CSE_REG_POWERPB, value))
-                    {
-                        m_data.active_power[1] = (0 == value) ? 0 : (value & 0x80000000) ? (~value) + 1 : value;
-                        double val = (double)m_data.active_power[1] * (double)m_data.coefficient[COEF_POWER_PBC] / (double)0x80000000;
-                        setLastValue(5, val);
-                    }
+                    scheduleReads(now);
                 }
                 break;
         }
-/*            if ((m_packetIndex == 0) && (d == BL0939_PACKET_HEADER))
-            {
-                m_packet.raw[0] = d;
-                m_packetIndex++;
-            }
-            else if (m_packetIndex > 0)
-            {
-                m_packet.raw[m_packetIndex] = d;
-                m_packetIndex++;
-                if (m_packetIndex >= sizeof(DataPacket::raw))
-                {
-                    // Whole packet received
-                    if (validateChecksum(&m_packet))
-                    {
-                        Log::verbose("BL0939", "Valid packet received");
-                        float v_rms = (float) to_uint32_t(m_packet.v_rms) / BL0939_UREF;
-                        float ia_rms = (float) to_uint32_t(m_packet.ia_rms) / BL0939_IREF;
-                        float ib_rms = (float) to_uint32_t(m_packet.ib_rms) / BL0939_IREF;
-                        float a_watt = (float) to_int32_t(m_packet.a_watt) / BL0939_PREF;
-                        float b_watt = (float) to_int32_t(m_packet.b_watt) / BL0939_PREF;
-                        int32_t cfa_cnt = to_int32_t(m_packet.cfa_cnt);
-                        int32_t cfb_cnt = to_int32_t(m_packet.cfb_cnt);
-                        float a_energy_consumption = (float) cfa_cnt / BL0939_EREF;
-                        float b_energy_consumption = (float) cfb_cnt / BL0939_EREF;
-                        float total_energy_consumption = a_energy_consumption + b_energy_consumption;
-                        setLastValue(0, v_rms);
-                        setLastValue(1, ia_rms);
-                        setLastValue(2, ib_rms);
-                        setLastValue(3, a_watt);
-                        setLastValue(4, b_watt);
-                        setLastValue(5, a_energy_consumption);
-                        setLastValue(6, b_energy_consumption);
-                        setLastValue(7, total_energy_consumption);
-                    }
-                    else
-                    {
-                        Log::verbose("BL0939", "Invalid checksum");
-                    }
-                    m_packetIndex = 0;
-                }
-            }
-            */
+        processTransfer(now);
     }
 }
@@ -1,9 +1,25 @@
 #pragma once
-#include "power_meas_device.h"
+#include "power_meas_register_device.h"
+#include "power_meas_uart.h"
 
-class CSE7761 : public PowerMeasDevice
+class CSE7761 : public PowerMeasRegisterDevice
 {
 public:
+
+    // Calibration coefficients read from chip, referenced by register map
+    enum Coefficient
+    {
+        COEF_RMS_IAC = 0, 
+        COEF_RMS_IBC, 
+        COEF_RMS_UC, 
+        COEF_POWER_PAC, 
+        COEF_POWER_PBC, 
+        COEF_POWER_SC, 
+        COEF_ENERGY_AC, 
+        COEF_ENERGY_BC,
+        COEF_COUNT
+    };
+
     CSE7761();
 
     void init() override;
@@ -20,53 +36,37 @@ protected:
 
 private:
 
+    // Fastest useful read rate, RMS registers are updated every ~100 ms
+    static constexpr uint32_t FAST_REFRESH_PERIOD_MILLI = 100;
+
     enum State
     {
         CSE_ST_IDLE = 0,
         CSE_ST_DETECT,
+        CSE_ST_RESET,
         CSE_ST_INIT,
         CSE_ST_READ
     };
 
-    enum Coefficient
+    enum TransferState
     {
-        COEF_RMS_IAC = 0, 
-        COEF_RMS_IBC, 
-        COEF_RMS_UC, 
-        COEF_POWER_PAC, 
-        COEF_POWER_PBC, 
-        COEF_POWER_SC, 
-        COEF_ENERGY_AC, 
-        COEF_ENERGY_BC
+        CSE_TR_IDLE = 0,
+        CSE_TR_RECEIVE
     };
 
-    struct Data
-    {
-        uint32_t frequency = 0;
-        uint32_t voltage_rms = 0;
-        uint32_t current_rms[2] = { 0 };
-        uint32_t energy[2] = { 0 };
-        uint32_t active_power[2] = { 0 };
-        uint16_t coefficient[8] = { 0 };
-        uint8_t energy_update[2] = { 0 };
-        uint8_t init = 4;
-        uint8_t ready = 0;
-        uint8_t model;
-    };    
-
     uint8_t calculateChecksum(uint8_t size);
 
-    uint8_t getRegisterSize(uint8_t reg);
+    void clearQueue();
 
-    bool writeRegister(uint8_t reg, uint32_t value);
+    void sendRequest(const Request& request, uint64_t now);
 
-    bool readRegister(uint8_t reg, uint32_t& result);
+    void processTransfer(uint64_t now);
 
-    bool readRegister(uint8_t reg, uint16_t& result);
+    void onRegisterRead(uint8_t reg, int32_t value);
 
-    bool readRegister(uint8_t reg, uint8_t& result);
+    void onTransferError(uint8_t reg, uint64_t now);
 
-    HardwareSerial* m_serial;
+    PowerMeasUart m_uart;
     State m_state;
     uint8_t m_serialIndex;
     uint8_t m_rxGpio;
@@ -74,6 +74,9 @@ private:
     uint32_t m_refreshPeriod;
     uint8_t m_packet[32];
     uint64_t m_lastReadTimestamp;
-    uint8_t m_registerIndex;
-    Data m_data;
+    // Reset command sent, chip settles from this time
+    uint64_t m_stateTimestamp;
+    float m_coefficients[COEF_COUNT];
+    TransferState m_transferState;
+    uint64_t m_requestTimestamp;
 };
\ No newline at end of file
@@ -0,0 +1,369 @@
+#include "hlw8012.h"
+#include "log.h"
+#include "time.h"
+#include "config.h"
+#include "profiles.h"
+
+#ifdef ESP32
+#include <driver/pcnt.h>
+static portMUX_TYPE s_pulseMux = portMUX_INITIALIZER_UNLOCKED;
+#define PULSE_LOCK() portENTER_CRITICAL(&s_pulseMux)
+#define PULSE_UNLOCK() portEXIT_CRITICAL(&s_pulseMux)
+#define PULSE_LOCK_ISR() portENTER_CRITICAL_ISR(&s_pulseMux)
+#define PULSE_UNLOCK_ISR() portEXIT_CRITICAL_ISR(&s_pulseMux)
+// Pulses shorter than 100 APB cycles (1.25 us) are ignored
+static const uint16_t PCNT_FILTER_VALUE = 100;
+#else
+#define PULSE_LOCK() noInterrupts()
+#define PULSE_UNLOCK() interrupts()
+#define PULSE_LOCK_ISR()
+#define PULSE_UNLOCK_ISR()
+#endif
+
+// HLW8012 internal oscillator and reference voltage
+static const float HLW8012_FOSC = 3579000;
+static const float HLW8012_VREF = 2.43;
+// BL0937 datasheet transfer constants
+static const float BL0937_VREF = 1.218;
+static const float BL0937_POWER_CONST = 1721506;
+static const float BL0937_CURRENT_CONST = 94638;
+static const float BL0937_VOLTAGE_CONST = 15397;
+
+static constexpr PowerMeasDevice::DescriptorInfo HLW8012_DESCRIPTORS[] PROGMEM = {
+    { "Voltage RMS", "V", ".0f", "voltage", true },
+    { "Current RMS", "A", ".3f", "current1", true },
+    { "Power", "W", ".1f", "power1", true },
+    { "Energy", "Wh", ".3f", "energy1", true }
+};
+
+HLW8012::HLW8012() :
+    PowerMeasDevice(),
+    m_model((Model)PROFILE_DEFAULT_HLW8012_MODEL),
+    m_cfGpio(PROFILE_DEFAULT_HLW8012_CF_GPIO),
+    m_cf1Gpio(PROFILE_DEFAULT_HLW8012_CF1_GPIO),
+    m_selGpio(PROFILE_DEFAULT_HLW8012_SEL_GPIO),
+    m_selCurrentHigh(PROFILE_DEFAULT_HLW8012_SEL_CURRENT_HIGH),
+    m_voltageDivider(DEFAULT_VOLTAGE_DIVIDER),
+    m_currentResistor(DEFAULT_CURRENT_RESISTOR),
+    m_refreshPeriod(PROFILE_DEFAULT_HLW8012_PERIOD_MILLI),
+    m_powerMultiplier(0),
+    m_currentMultiplier(0),
+    m_voltageMultiplier(0),
+    m_attached(false),
+    m_cf1Mode(CF1_CURRENT),
+    m_cf1ModeTimestamp(0),
+    m_voltageTimestamp(0),
+    m_lastReadTimestamp(0)
+{
+    memset((void*)&m_cf, 0, sizeof(m_cf));
+    memset((void*)&m_cf1, 0, sizeof(m_cf1));
+    memset(m_cf1Frequencies, 0, sizeof(m_cf1Frequencies));
+    setDescriptors(HLW8012_DESCRIPTORS, sizeof(HLW8012_DESCRIPTORS) / sizeof(HLW8012_DESCRIPTORS[0]));
+}
+
+String HLW8012::getChipInfo() const
+{
+    return (m_model == MODEL_BL0937) ? "BL0937" : "HLW8012";
+}
+
+void HLW8012::init()
+{
+    PowerMeasDevice::init();
+    m_model = (Model)Config::getInt("hlw8012/model", PROFILE_DEFAULT_HLW8012_MODEL);
+    m_cfGpio = Config::getInt("hlw8012/cf_gpio", PROFILE_DEFAULT_HLW8012_CF_GPIO);
+    m_cf1Gpio = Config::getInt("hlw8012/cf1_gpio", PROFILE_DEFAULT_HLW8012_CF1_GPIO);
+    m_selGpio = Config::getInt("hlw8012/sel_gpio", PROFILE_DEFAULT_HLW8012_SEL_GPIO);
+    m_selCurrentHigh = Config::getBool("hlw8012/sel_current_high", PROFILE_DEFAULT_HLW8012_SEL_CURRENT_HIGH);
+    m_voltageDivider = Config::getFloat("hlw8012/voltage_divider", DEFAULT_VOLTAGE_DIVIDER);
+    m_currentResistor = Config::getFloat("hlw8012/current_resistor", DEFAULT_CURRENT_RESISTOR);
+    m_refreshPeriod = Config::getInt("hlw8012/refresh_milli", PROFILE_DEFAULT_HLW8012_PERIOD_MILLI);
+    updateMultipliers();
+
+    if (m_attached)
+    {
+        detachChannel(m_cf);
+        detachChannel(m_cf1);
+        m_attached = false;
+    }
+    pinMode(m_selGpio, OUTPUT);
+    m_voltageTimestamp = 0;
+    m_lastReadTimestamp = 0;
+    m_attached = attachChannel(m_cf, m_cfGpio, 0) && attachChannel(m_cf1, m_cf1Gpio, 1);
+    m_cf1Frequencies[CF1_CURRENT] = 0;
+    m_cf1Frequencies[CF1_VOLTAGE] = 0;
+    m_cf1Mode = CF1_CURRENT;
+    setCf1Mode(CF1_CURRENT, Time::nowRelativeMilli());
+    if (m_attached)
+    {
+        Log::info("HLW8012", "Initialized, model=%s, cf=%d, cf1=%d, sel=%d, refresh period=%d ms", getChipInfo().c_str(), m_cfGpio, m_cf1Gpio, m_selGpio, m_refreshPeriod);
+    }
+    else
+    {
+        Log::error("HLW8012", "Unable to attach pulse inputs");
+        detachChannel(m_cf);
+        detachChannel(m_cf1);
+    }
+}
+
+String HLW8012::getConfiguration()
+{
+    String result = "{";
+    result = result + "\"model\":\"" + ((m_model == MODEL_BL0937) ? "bl0937" : "hlw8012") + "\",";
+    result = result + "\"cf_gpio\":" + String(m_cfGpio) + ",";
+    result = result + "\"cf1_gpio\":" + String(m_cf1Gpio) + ",";
+    result = result + "\"sel_gpio\":" + String(m_selGpio) + ",";
+    result = result + "\"sel_current_high\":" + (m_selCurrentHigh ? "true" : "false") + ",";
+    result = result + "\"voltage_divider\":" + String(m_voltageDivider, 1) + ",";
+    result = result + "\"current_resistor\":" + String(m_currentResistor, 6) + ",";
+    result = result + "\"refresh_period_milli\":" + String(m_refreshPeriod);
+    result = result + "}";
+    return result;
+}
+
+void HLW8012::setConfiguration(String config, bool save, bool performInit)
+{
+    DynamicJsonDocument json(512);
+    DeserializationError error = deserializeJson(json, config);
+    if (error)
+    {
+        Log::error("HLW8012", "Error while parsing config JSON: %s", error.c_str());
+    }
+    else
+    {
+        if (json.containsKey("model") && (json["model"] == "hlw8012"))
+            m_model = MODEL_HLW8012;
+        if (json.containsKey("model") && (json["model"] == "bl0937"))
+            m_model = MODEL_BL0937;
+        if (json.containsKey("cf_gpio"))
+            m_cfGpio = json["cf_gpio"].as<uint8_t>();
+        if (json.containsKey("cf1_gpio"))
+            m_cf1Gpio = json["cf1_gpio"].as<uint8_t>();
+        if (json.containsKey("sel_gpio"))
+            m_selGpio = json["sel_gpio"].as<uint8_t>();
+        if (json.containsKey("sel_current_high"))
+            m_selCurrentHigh = json["sel_current_high"].as<bool>();
+        if (json.containsKey("voltage_divider") && (json["voltage_divider"].as<float>() > 0))
+            m_voltageDivider = json["voltage_divider"].as<float>();
+        if (json.containsKey("current_resistor") && (json["current_resistor"].as<float>() > 0))
+            m_currentResistor = json["current_resistor"].as<float>();
+        if (json.containsKey("refresh_period_milli"))
+        {
+            m_refreshPeriod = json["refresh_period_milli"].as<uint32_t>();
+            if (m_refreshPeriod < FAST_REFRESH_PERIOD_MILLI)
+                m_refreshPeriod = FAST_REFRESH_PERIOD_MILLI;
+        }
+        updateMultipliers();
+        if (save)
+        {
+            Config::setInt("hlw8012/model", m_model);
+            Config::setInt("hlw8012/cf_gpio", m_cfGpio);
+            Config::setInt("hlw8012/cf1_gpio", m_cf1Gpio);
+            Config::setInt("hlw8012/sel_gpio", m_selGpio);
+            Config::setBool("hlw8012/sel_current_high", m_selCurrentHigh);
+            Config::setFloat("hlw8012/voltage_divider", m_voltageDivider);
+            Config::setFloat("hlw8012/current_resistor", m_currentResistor);
+            Config::setInt("hlw8012/refresh_milli", m_refreshPeriod);
+            Config::flush();
+            Log::info("HLW8012", "Configuration saved");
+        }
+        if (performInit)
+            init();
+    }
+}
+
+void HLW8012::updateMultipliers()
+{
+    if (m_model == MODEL_BL0937)
+    {
+        m_powerMultiplier = BL0937_VREF * BL0937_VREF * m_voltageDivider / (BL0937_POWER_CONST * m_currentResistor);
+        m_currentMultiplier = BL0937_VREF / (BL0937_CURRENT_CONST * m_currentResistor);
+        m_voltageMultiplier = BL0937_VREF * m_voltageDivider / BL0937_VOLTAGE_CONST;
+    }
+    else
+    {
+        // CF = 48 * V1 * V2 / Vref^2 * fosc / 128, CF1 = 24 * V1 / Vref * fosc / 512 or 2 * V2 / Vref * fosc / 512
+        m_powerMultiplier = HLW8012_VREF * HLW8012_VREF * m_voltageDivider * 128 / (48 * HLW8012_FOSC * m_currentResistor);
+        m_currentMultiplier = HLW8012_VREF * 512 / (24 * HLW8012_FOSC * m_currentResistor);
+        m_voltageMultiplier = HLW8012_VREF * m_voltageDivider * 512 / (2 * HLW8012_FOSC);
+    }
+}
+
+void IRAM_ATTR HLW8012::pulseIsr(void* arg)
+{
+    PulseChannel& channel = *(PulseChannel*)arg;
+    PULSE_LOCK_ISR();
+    channel.edges += channel.divider;
+    channel.lastEdgeMicro = Time::nowRelativeMicro();
+    PULSE_UNLOCK_ISR();
+}
+
+bool HLW8012::attachChannel(PulseChannel& channel, uint8_t pin, uint8_t unit)
+{
+    channel.pin = pin;
+    channel.unit = unit;
+    channel.divider = 1;
+    channel.frequency = 0;
+    restartChannel(channel);
+#ifdef ESP32
+    // Counter resets at high limit, interrupt comes once per divider pulses
+    pcnt_config_t config = {};
+    config.pulse_gpio_num = pin;
+    config.ctrl_gpio_num = PCNT_PIN_NOT_USED;
+    config.lctrl_mode = PCNT_MODE_KEEP;
+    config.hctrl_mode = PCNT_MODE_KEEP;
+    config.pos_mode = PCNT_COUNT_INC;
+    config.neg_mode = PCNT_COUNT_DIS;
+    config.counter_h_lim = 1;
+    config.counter_l_lim = 0;
+    config.unit = (pcnt_unit_t)unit;
+    config.channel = PCNT_CHANNEL_0;
+    if (pcnt_unit_config(&config) != ESP_OK)
+        return false;
+    pcnt_set_filter_value((pcnt_unit_t)unit, PCNT_FILTER_VALUE);
+    pcnt_filter_enable((pcnt_unit_t)unit);
+    pcnt_event_enable((pcnt_unit_t)unit, PCNT_EVT_H_LIM);
+    pcnt_counter_pause((pcnt_unit_t)unit);
+    pcnt_counter_clear((pcnt_unit_t)unit);
+    // Service may be installed already by another user of PCNT
+    esp_err_t result = pcnt_isr_service_install(0);
+    if ((result != ESP_OK) && (result != ESP_ERR_INVALID_STATE))
+        return false;
+    if (pcnt_isr_handler_add((pcnt_unit_t)unit, pulseIsr, &channel) != ESP_OK)
+        return false;
+    pcnt_counter_resume((pcnt_unit_t)unit);
+#else
+    if (digitalPinToInterrupt(pin) == NOT_AN_INTERRUPT)
+        return false;
+    pinMode(pin, INPUT);
+    attachInterruptArg(digitalPinToInterrupt(pin), pulseIsr, &channel, RISING);
+#endif
+    return true;
+}
+
+void HLW8012::detachChannel(PulseChannel& channel)
+{
+#ifdef ESP32
+    pcnt_counter_pause((pcnt_unit_t)channel.unit);
+    pcnt_isr_handler_remove((pcnt_unit_t)channel.unit);
+#else
+    if (digitalPinToInterrupt(channel.pin) != NOT_AN_INTERRUPT)
+        detachInterrupt(digitalPinToInterrupt(channel.pin));
+#endif
+}
+
+void HLW8012::restartChannel(PulseChannel& channel)
+{
+    PULSE_LOCK();
+    channel.startEdges = channel.edges;
+    PULSE_UNLOCK();
+    channel.startMicro = Time::nowRelativeMicro();
+    channel.started = false;
+}
+
+bool HLW8012::updateFrequency(PulseChannel& channel, uint64_t nowMicro)
+{
+    // Consistent snapshot of interrupt state, lock is also a compiler barrier
+    PULSE_LOCK();
+    uint32_t edges = channel.edges;
+    uint64_t lastEdgeMicro = channel.lastEdgeMicro;
+    uint32_t divider = channel.divider;
+    PULSE_UNLOCK();
+    if (edges != channel.startEdges)
+    {
+        // Whole periods between reference edge and the last edge
+        bool updated = channel.started && (lastEdgeMicro > channel.startMicro);
+        if (updated)
+            channel.frequency = (float)(uint32_t)(edges - channel.startEdges) * 1000000.0f / (float)(lastEdgeMicro - channel.startMicro);
+        channel.startEdges = edges;
+        channel.startMicro = lastEdgeMicro;
+        channel.started = true;
+        return updated;
+    }
+    // No edge since reference, current period is at least the silence
+    uint64_t silenceMicro = (nowMicro > channel.startMicro) ? nowMicro - channel.startMicro : 0;
+    if (silenceMicro > (uint64_t)PULSE_TIMEOUT_MILLI * 1000)
+    {
+        channel.frequency = 0;
+    }
+    else if (channel.started && (silenceMicro > 0))
+    {
+        float bound = (float)divider * 1000000.0f / (float)silenceMicro;
+        if (bound < channel.frequency)
+            channel.frequency = bound;
+    }
+    return false;
+}
+
+#ifdef ESP32
+void HLW8012::adaptDivider(PulseChannel& channel)
+{
+    uint32_t divider = (uint32_t)(channel.frequency / TARGET_EVENT_HZ);
+    if (divider < 1)
+        divider = 1;
+    if (divider > MAX_DIVIDER)
+        divider = MAX_DIVIDER;
+    // Hysteresis, counter restart loses pulses counted since last event
+    if ((divider < channel.divider * 2) && (divider * 2 > channel.divider))
+        return;
+    pcnt_unit_t unit = (pcnt_unit_t)channel.unit;
+    pcnt_counter_pause(unit);
+    pcnt_set_event_value(unit, PCNT_EVT_H_LIM, (int16_t)divider);
+    pcnt_counter_clear(unit);
+    PULSE_LOCK();
+    channel.divider = divider;
+    PULSE_UNLOCK();
+    restartChannel(channel);
+    pcnt_counter_resume(unit);
+    Log::verbose("HLW8012", "Pulse divider of unit %d set to %d", channel.unit, divider);
+}
+#endif
+
+void HLW8012::setCf1Mode(Cf1Mode mode, uint64_t now)
+{
+    // Frequency of each mode is kept so values do not mix after switching back
+    m_cf1Frequencies[m_cf1Mode] = m_cf1.frequency;
+    m_cf1Mode = mode;
+    m_cf1.frequency = m_cf1Frequencies[mode];
+    m_cf1ModeTimestamp = now;
+    digitalWrite(m_selGpio, ((mode == CF1_CURRENT) == m_selCurrentHigh) ? HIGH : LOW);
+    // Edges before switch belong to the other quantity
+    restartChannel(m_cf1);
+}
+
+void HLW8012::process()
+{
+    if (!m_attached)
+        return;
+    uint64_t now = Time::nowRelativeMilli();
+    if (now < m_lastReadTimestamp + getRefreshPeriod(m_refreshPeriod, FAST_REFRESH_PERIOD_MILLI))
+        return;
+    m_lastReadTimestamp = now;
+    uint64_t nowMicro = Time::nowRelativeMicro();
+
+    updateFrequency(m_cf, nowMicro);
+#ifdef ESP32
+    adaptDivider(m_cf);
+#endif
+    PULSE_LOCK();
+    uint32_t cfEdges = m_cf.edges;
+    PULSE_UNLOCK();
+    setLastValue(2, m_cf.frequency * m_powerMultiplier);
+    // One CF pulse is power multiplier watt seconds
+    setLastValue(3, (float)cfEdges * m_powerMultiplier / 3600);
+
+    bool cf1Updated = updateFrequency(m_cf1, nowMicro);
+    if (m_cf1Mode == CF1_CURRENT)
+    {
+        setLastValue(1, m_cf1.frequency * m_currentMultiplier);
+        // Voltage is not measured while motor runs, current is needed for every sample
+        if (!isFastRefresh() && (now >= m_voltageTimestamp + VOLTAGE_PERIOD_MILLI))
+            setCf1Mode(CF1_VOLTAGE, now);
+    }
+    else if (cf1Updated || (now >= m_cf1ModeTimestamp + VOLTAGE_TIMEOUT_MILLI))
+    {
+        setLastValue(0, cf1Updated ? m_cf1.frequency * m_voltageMultiplier : 0);
+        m_voltageTimestamp = now;
+        setCf1Mode(CF1_CURRENT, now);
+    }
+    emitSample(now);
+}
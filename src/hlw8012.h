@@ -0,0 +1,108 @@
+#pragma once
+#include "power_meas_device.h"
+
+// Pulse output meters (HLW8012, BL0937). CF pulses are proportional to active
+// power, CF1 pulses to current or voltage (selected by SEL pin). Frequency is
+// computed from timestamps of counted edges, not from fixed counting windows.
+class HLW8012 : public PowerMeasDevice
+{
+public:
+
+    enum Model
+    {
+        MODEL_HLW8012 = 0,
+        MODEL_BL0937
+    };
+
+    HLW8012();
+
+    void init() override;
+
+    String getChipInfo() const override;
+
+    String getConfiguration() override;
+
+    void setConfiguration(String config, bool save = true, bool performInit = false) override;
+
+    void process() override;
+
+private:
+
+    // Current is read every refresh while motor runs, voltage only when idle
+    static constexpr uint32_t FAST_REFRESH_PERIOD_MILLI = 100;
+    static constexpr uint32_t VOLTAGE_PERIOD_MILLI = 10000;
+    static constexpr uint32_t VOLTAGE_TIMEOUT_MILLI = 1000;
+    // No pulse for this long means zero
+    static constexpr uint32_t PULSE_TIMEOUT_MILLI = 10000;
+    static constexpr float DEFAULT_VOLTAGE_DIVIDER = 2351;
+    static constexpr float DEFAULT_CURRENT_RESISTOR = 0.001;
+#ifdef ESP32
+    // Counter events are planned at about this rate, divider adapts to frequency
+    static constexpr uint32_t TARGET_EVENT_HZ = 50;
+    static constexpr uint32_t MAX_DIVIDER = 1000;
+#endif
+
+    enum Cf1Mode
+    {
+        CF1_CURRENT = 0,
+        CF1_VOLTAGE
+    };
+
+    struct PulseChannel
+    {
+        uint8_t pin;
+        uint8_t unit;
+        // Updated from interrupt, task reads them together under PULSE_LOCK
+        volatile uint32_t edges;
+        volatile uint64_t lastEdgeMicro;
+        // Edges per interrupt, ESP32 counter counts the rest in hardware
+        volatile uint32_t divider;
+        // Reference edge of next frequency computation
+        uint32_t startEdges;
+        uint64_t startMicro;
+        bool started;
+        float frequency;
+    };
+
+    static void pulseIsr(void* arg);
+
+    bool attachChannel(PulseChannel& channel, uint8_t pin, uint8_t unit);
+
+    void detachChannel(PulseChannel& channel);
+
+    // Next frequency is computed from the first edge after restart
+    void restartChannel(PulseChannel& channel);
+
+    // Returns false when there was no new edge, frequency is decayed then
+    bool updateFrequency(PulseChannel& channel, uint64_t nowMicro);
+
+#ifdef ESP32
+    void adaptDivider(PulseChannel& channel);
+#endif
+
+    void setCf1Mode(Cf1Mode mode, uint64_t now);
+
+    void updateMultipliers();
+
+    Model m_model;
+    uint8_t m_cfGpio;
+    uint8_t m_cf1Gpio;
+    uint8_t m_selGpio;
+    // SEL level selecting current measurement
+    bool m_selCurrentHigh;
+    float m_voltageDivider;
+    float m_currentResistor;
+    uint32_t m_refreshPeriod;
+    // Values per Hz of pulse frequency
+    float m_powerMultiplier;
+    float m_currentMultiplier;
+    float m_voltageMultiplier;
+    bool m_attached;
+    PulseChannel m_cf;
+    PulseChannel m_cf1;
+    Cf1Mode m_cf1Mode;
+    float m_cf1Frequencies[2];
+    uint64_t m_cf1ModeTimestamp;
+    uint64_t m_voltageTimestamp;
+    uint64_t m_lastReadTimestamp;
+};
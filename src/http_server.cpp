@@ -1,4 +1,5 @@
 #include "http_server.h"
+#include <memory>
 #ifdef ESP32
   #include <WiFi.h>
   #include <AsyncTCP.h>
@@ -15,6 +16,11 @@
 #include "module.h"
 #include "mqtt.h"
 #include "power_meas.h"
+#include "power_meas_archive.h"
+#include "motion_analyzer.h"
+#include "movement_stats.h"
+#include "power_meas_capture.h"
+#include "scheduler.h"
 
 static String htmlEscape(String str)
 {
@@ -112,6 +118,17 @@ void HttpServer::configureClient(const char* ssid, const char* password, const c
     Config::flush();
 }
 
+void HttpServer::sendConfigSaved(AsyncWebServerRequest* request, const char* page)
+{
+    // Changes are applied, but would be lost with the next reboot
+    if (!Config::isSaved())
+    {
+        request->send(507, "text/plain", "Configuration was not saved, it does not fit into EEPROM");
+        return;
+    }
+    request->send_P(200, "text/html", page, defaultProcessor);
+}
+
 void HttpServer::getConfig(WifiConfig& wifiConfig, String& ssidAp, String& passAp, String& ssidClient, String& passClient, String& hostname)
 {
     HttpServer& inst = getInstance();
@@ -194,7 +211,7 @@ void HttpServer::initPrivate()
         }
         Module::setName(name.c_str());
         Log::setLoggingLevelOverride(logLevelOverride);
-        request->send_P(200, "text/html", getHttpConfigSaved(), defaultProcessor);
+        sendConfigSaved(request, getHttpConfigSaved());
     });
     m_server.on("/gpioConfig", HTTP_GET, [](AsyncWebServerRequest *request){
         request->send_P(200, "text/html", getHttpGpioConfig(), gpioConfigProcessor);
@@ -304,7 +321,7 @@ void HttpServer::initPrivate()
         Louver::configureGpio(Louver::DIR_DOWN, pinKeyDown, relayDown, highKeyDown, highRelayDown, pinKeyDownPullEnabled);
         Module::setResetGpioConfig(pinKeyReset, highKeyReset, keyResetPullEnabled);
         Module::setLedGpioConfig(pinLed);
-        request->send_P(200, "text/html", getHttpConfigSaved(), defaultProcessor);
+        sendConfigSaved(request, getHttpConfigSaved());
     });
     m_server.on("/movementConfig", HTTP_GET, [](AsyncWebServerRequest *request){
         request->send_P(200, "text/html", getHttpMovementConfig(), movementConfigProcessor);
@@ -318,9 +335,20 @@ void HttpServer::initPrivate()
         float timeOpenLamellasSecs;
         float shortMovementSecs;
         Louver::getTimesConfig(timeFullOpenSecs, timeFullCloseSecs, timeOpenLamellasSecs, shortMovementSecs);
-        bool stopCond1;
-        bool stopCond2;
-        Louver::getPowerCondStop(stopCond1, stopCond2);
+        String stopCondUp;
+        String stopCondDown;
+        Louver::getPowerCondStop(stopCondUp, stopCondDown);
+        bool positionAware;
+        float safetyOverrun;
+        uint32_t rehomeMoves;
+        float rehomeTravel;
+        Louver::getFullMovesConfig(positionAware, safetyOverrun, rehomeMoves, rehomeTravel);
+        uint32_t startLagUp;
+        uint32_t stopLagUp;
+        uint32_t startLagDown;
+        uint32_t stopLagDown;
+        Louver::getMotorLag(Louver::DIR_UP, startLagUp, stopLagUp);
+        Louver::getMotorLag(Louver::DIR_DOWN, startLagDown, stopLagDown);
         if (request->hasParam("timeFullOpen", true))
         {
             timeFullOpenSecs = request->getParam("timeFullOpen", true)->value().toFloat();
@@ -337,23 +365,55 @@ void HttpServer::initPrivate()
         {
             timeOpenLamellasSecs = request->getParam("timeOpenLamellas", true)->value().toFloat();
         }
-        if (request->hasParam("stopOpenOnPowerCond1", true))
+        if (request->hasParam("stopOpenCondition", true))
         {
-            if (request->getParam("stopOpenOnPowerCond1", true)->value() == "1")
-                stopCond1 = true;
-            else
-                stopCond1 = false;
+            stopCondUp = request->getParam("stopOpenCondition", true)->value();
+        }
+        if (request->hasParam("stopCloseCondition", true))
+        {
+            stopCondDown = request->getParam("stopCloseCondition", true)->value();
         }
-        if (request->hasParam("stopCloseOnPowerCond2", true))
+        if (request->hasParam("positionAware", true))
         {
-            if (request->getParam("stopCloseOnPowerCond2", true)->value() == "1")
-                stopCond2 = true;
+            if (request->getParam("positionAware", true)->value() == "1")
+                positionAware = true;
             else
-                stopCond2 = false;
+                positionAware = false;
+        }
+        if (request->hasParam("safetyOverrun", true))
+        {
+            safetyOverrun = request->getParam("safetyOverrun", true)->value().toFloat();
+        }
+        if (request->hasParam("rehomeMoves", true))
+        {
+            rehomeMoves = (uint32_t)request->getParam("rehomeMoves", true)->value().toInt();
+        }
+        if (request->hasParam("rehomeTravel", true))
+        {
+            rehomeTravel = request->getParam("rehomeTravel", true)->value().toFloat();
+        }
+        if (request->hasParam("startLagUp", true))
+        {
+            startLagUp = (uint32_t)request->getParam("startLagUp", true)->value().toInt();
+        }
+        if (request->hasParam("stopLagUp", true))
+        {
+            stopLagUp = (uint32_t)request->getParam("stopLagUp", true)->value().toInt();
+        }
+        if (request->hasParam("startLagDown", true))
+        {
+            startLagDown = (uint32_t)request->getParam("startLagDown", true)->value().toInt();
+        }
+        if (request->hasParam("stopLagDown", true))
+        {
+            stopLagDown = (uint32_t)request->getParam("stopLagDown", true)->value().toInt();
         }
         Louver::configureTimes(timeFullOpenSecs, timeFullCloseSecs, timeOpenLamellasSecs, shortMovementSecs);
-        Louver::configurePowerCondStop(stopCond1, stopCond2);
-        request->send_P(200, "text/html", getHttpConfigSaved(), defaultProcessor);
+        Louver::configurePowerCondStop(stopCondUp, stopCondDown);
+        Louver::configureFullMoves(positionAware, safetyOverrun, rehomeMoves, rehomeTravel);
+        Louver::configureMotorLag(Louver::DIR_UP, startLagUp, stopLagUp);
+        Louver::configureMotorLag(Louver::DIR_DOWN, startLagDown, stopLagDown);
+        sendConfigSaved(request, getHttpConfigSaved());
     });
     m_server.on("/networkConfig", HTTP_GET, [](AsyncWebServerRequest *request){
         request->send_P(200, "text/html", getHttpNetworkConfig(), networkConfigProcessor);
@@ -426,7 +486,7 @@ void HttpServer::initPrivate()
         WiFi.setHostname(host.c_str());
         Log::setTelnetLoggingEnabled(telnetLoggingEnabled);
         Log::info("HTTP", "Network config changed - requesting reboot");    
-        request->send_P(200, "text/html", getHttpNetworkConfigSaved(), defaultProcessor);
+        sendConfigSaved(request, getHttpNetworkConfigSaved());
     });
     m_server.on("/mqttConfig", HTTP_GET, [](AsyncWebServerRequest *request){
         request->send_P(200, "text/html", getHttpMqttConfig(), mqttConfigProcessor);
@@ -442,6 +502,7 @@ void HttpServer::initPrivate()
         String user = Mqtt::getAuthenticationUser();
         String pass = Mqtt::getAuthenticationPassword();
         uint32_t powerMeasPeriod = Mqtt::getPowerPublishPeriod();
+        uint32_t metricsPeriod = Mqtt::getMetricsPublishPeriod();
         if (request->hasParam("enabled", true))
         {
             if (request->getParam("enabled", true)->value() == "1")
@@ -473,13 +534,18 @@ void HttpServer::initPrivate()
         {
             powerMeasPeriod = (uint32_t)request->getParam("powerMeasPeriod", true)->value().toInt();
         }
+        if (request->hasParam("metricsPeriod", true)) 
+        {
+            metricsPeriod = (uint32_t)request->getParam("metricsPeriod", true)->value().toInt();
+        }
         Mqtt::setEnabled(enabled);
         Mqtt::setBrokerIp(brokerIp.c_str());
         Mqtt::setBrokerPort(brokerPort);
         Mqtt::setClientId(clientId.c_str());
         Mqtt::setAuthentication(user.c_str(), pass.c_str());
         Mqtt::setPowerPublishPeriod(powerMeasPeriod);
-        request->send_P(200, "text/html", getHttpConfigSaved(), defaultProcessor);
+        Mqtt::setMetricsPublishPeriod(metricsPeriod);
+        sendConfigSaved(request, getHttpConfigSaved());
     });
     m_server.on("/powerMeasConfig", HTTP_GET, [](AsyncWebServerRequest *request){
         request->send_P(200, "text/html", getHttpPowerMeasConfig(), powerMeasConfigProcessor);
@@ -492,8 +558,14 @@ void HttpServer::initPrivate()
         String bl0939Config = PowerMeas::getConfiguration(PowerMeas::DEV_BL0939);
         String ade7953Config = PowerMeas::getConfiguration(PowerMeas::DEV_ADE7953);
         String cse7761Config = PowerMeas::getConfiguration(PowerMeas::DEV_CSE7761);
-        String stopCond1 = PowerMeas::getConditionConfig(0);
-        String stopCond2 = PowerMeas::getConditionConfig(1);
+        String hlw8012Config = PowerMeas::getConfiguration(PowerMeas::DEV_HLW8012);
+        String extraDevices = PowerMeas::getExtraDevices();
+        String filters = PowerMeas::getFiltersConfig();
+        String conditions = PowerMeas::getConditionsConfig();
+        String motionAnalyzer = MotionAnalyzer::getConfig();
+        String movementStats = MovementStats::getConfig();
+        String capture = PowerMeasCapture::getConfig();
+        uint32_t archivePeriod = PowerMeasArchive::getPeriod();
         if (request->hasParam("deviceType", true))
         {
             deviceType = (PowerMeas::DeviceType)request->getParam("deviceType", true)->value().toInt();
@@ -510,21 +582,51 @@ void HttpServer::initPrivate()
         {
             cse7761Config = request->getParam("cse7761Config", true)->value();
         }
-        if (request->hasParam("powerMeasStopCond1", true))
+        if (request->hasParam("hlw8012Config", true))
+        {
+            hlw8012Config = request->getParam("hlw8012Config", true)->value();
+        }
+        if (request->hasParam("extraDevices", true))
+        {
+            extraDevices = request->getParam("extraDevices", true)->value();
+        }
+        if (request->hasParam("powerMeasFilters", true))
+        {
+            filters = request->getParam("powerMeasFilters", true)->value();
+        }
+        if (request->hasParam("powerMeasConditions", true))
+        {
+            conditions = request->getParam("powerMeasConditions", true)->value();
+        }
+        if (request->hasParam("motionAnalyzer", true))
+        {
+            motionAnalyzer = request->getParam("motionAnalyzer", true)->value();
+        }
+        if (request->hasParam("movementStats", true))
+        {
+            movementStats = request->getParam("movementStats", true)->value();
+        }
+        if (request->hasParam("powerMeasCapture", true))
         {
-            stopCond1 = request->getParam("powerMeasStopCond1", true)->value();
+            capture = request->getParam("powerMeasCapture", true)->value();
         }
-        if (request->hasParam("powerMeasStopCond2", true))
+        if (request->hasParam("archivePeriod", true))
         {
-            stopCond2 = request->getParam("powerMeasStopCond2", true)->value();
+            archivePeriod = (uint32_t)request->getParam("archivePeriod", true)->value().toInt();
         }
         PowerMeas::setActiveDeviceType(deviceType);
-        PowerMeas::setConfiguration(PowerMeas::DEV_BL0939, bl0939Config, deviceType == PowerMeas::DEV_BL0939);
-        PowerMeas::setConfiguration(PowerMeas::DEV_ADE7953, ade7953Config, deviceType == PowerMeas::DEV_ADE7953);
-        PowerMeas::setConfiguration(PowerMeas::DEV_CSE7761, cse7761Config, deviceType == PowerMeas::DEV_CSE7761);
-        PowerMeas::setConditionConfig(0, stopCond1);
-        PowerMeas::setConditionConfig(1, stopCond2);
-        request->send_P(200, "text/html", getHttpConfigSaved(), defaultProcessor);
+        PowerMeas::setExtraDevices(extraDevices);
+        PowerMeas::setConfiguration(PowerMeas::DEV_BL0939, bl0939Config, PowerMeas::isDeviceEnabled(PowerMeas::DEV_BL0939));
+        PowerMeas::setConfiguration(PowerMeas::DEV_ADE7953, ade7953Config, PowerMeas::isDeviceEnabled(PowerMeas::DEV_ADE7953));
+        PowerMeas::setConfiguration(PowerMeas::DEV_CSE7761, cse7761Config, PowerMeas::isDeviceEnabled(PowerMeas::DEV_CSE7761));
+        PowerMeas::setConfiguration(PowerMeas::DEV_HLW8012, hlw8012Config, PowerMeas::isDeviceEnabled(PowerMeas::DEV_HLW8012));
+        PowerMeas::setFiltersConfig(filters);
+        PowerMeas::setConditionsConfig(conditions);
+        MotionAnalyzer::setConfig(motionAnalyzer);
+        MovementStats::setConfig(movementStats);
+        PowerMeasCapture::setConfig(capture);
+        PowerMeasArchive::setPeriod(archivePeriod);
+        sendConfigSaved(request, getHttpConfigSaved());
     });
     m_server.on("/portal", HTTP_GET, [](AsyncWebServerRequest *request){
         request->send_P(200, "text/html", getHttpIndex(), defaultProcessor);
@@ -551,8 +653,21 @@ void HttpServer::initPrivate()
             else if (buttonId == "stop")
                 Louver::stop();
         }
+        else if (request->hasParam("position")) {
+            float position = request->getParam("position")->value().toFloat();
+            Log::info("HTTP", "Command to move to position %f %% received", position);
+            Louver::moveToPosition(position);
+        }
+        else if (request->hasParam("action")) {
+            String action = request->getParam("action")->value();
+            Log::info("HTTP", "Command action %s received", action.c_str());
+            if (action == "resetBaseline")
+                MovementStats::resetBaselines();
+            else
+                Log::error("HTTP", "Unknown command action %s", action.c_str());
+        }
         else {
-            Log::error("HTTP", "Command received but no button info provided");
+            Log::error("HTTP", "Command received but no button, position or action info provided");
         }
         request->send(200, "text/plain", "OK");
     });
@@ -560,6 +675,149 @@ void HttpServer::initPrivate()
         request->send(200, "text/json", PowerMeas::exportActiveDescriptorsToJSON());
         Log::debug("HTTP", "GET request, /powerMeasurementExport");
     });
+    m_server.on("/movementStats", HTTP_GET, [](AsyncWebServerRequest *request){
+        request->send(200, "text/json", MovementStats::exportToJSON());
+        Log::debug("HTTP", "GET request, /movementStats");
+    });
+    m_server.on("/powerMeasurementHistory", HTTP_GET, [](AsyncWebServerRequest *request){
+        Log::debug("HTTP", "GET request, /powerMeasurementHistory");
+        uint8_t index = 0;
+        PowerMeasHistory::Tier tier = PowerMeasHistory::TIER_RAW;
+        bool binary = false;
+        if (request->hasParam("index"))
+            index = (uint8_t)request->getParam("index")->value().toInt();
+        if (request->hasParam("tier"))
+            tier = PowerMeasHistory::stringToTier(request->getParam("tier")->value());
+        if (request->hasParam("format"))
+            binary = (request->getParam("format")->value() == "bin");
+        if (index >= PowerMeas::getValueCount())
+        {
+            request->send(404, "text/plain", "Invalid value index");
+            return;
+        }
+        uint32_t now = (uint32_t)Time::nowRelativeMilli();
+        uint16_t row = 0;
+        bool headerSent = binary;
+        // Rows are formatted directly into response chunks, no String is built
+        AsyncWebServerResponse *response = request->beginChunkedResponse(binary ? "application/octet-stream" : "text/csv", 
+            [index, tier, binary, now, row, headerSent](uint8_t *buffer, size_t maxLen, size_t sent) mutable -> size_t {
+            // Index is resolved again for every chunk, devices may be reconfigured meanwhile
+            uint8_t deviceValueIndex = 0;
+            const PowerMeasDevice* device = PowerMeas::getValueDevice(index, deviceValueIndex);
+            const PowerMeasHistory* history = (device != nullptr) ? device->getHistory(deviceValueIndex) : nullptr;
+            size_t length = 0;
+            if (!headerSent)
+            {
+                static const char header[] = "time_ms,min,avg,max\n";
+                if (maxLen < sizeof(header))
+                    return 0;
+                memcpy(buffer, header, sizeof(header) - 1);
+                length = sizeof(header) - 1;
+                headerSent = true;
+            }
+            PowerMeasHistory::Sample sample;
+            while ((history != nullptr) && history->getSample(tier, row, now, sample))
+            {
+                if (binary)
+                {
+                    if (length + sizeof(sample) > maxLen)
+                        break;
+                    memcpy(buffer + length, &sample, sizeof(sample));
+                    length += sizeof(sample);
+                }
+                else
+                {
+                    char line[64];
+                    int lineLength = snprintf(line, sizeof(line), "%u,%.3f,%.3f,%.3f\n", sample.timeMilli, sample.minValue, sample.avgValue, sample.maxValue);
+                    if ((lineLength <= 0) || (length + lineLength > maxLen))
+                        break;
+                    memcpy(buffer + length, line, lineLength);
+                    length += lineLength;
+                }
+                row++;
+            }
+            return length;
+        });
+        // Tier span differs between platforms, clients size their charts from these
+        response->addHeader("X-History-Capacity", String(PowerMeasHistory::getTierCapacity(tier)));
+        response->addHeader("X-History-Period-Ms", String(PowerMeasHistory::getTierPeriodMilli(tier)));
+        request->send(response);
+    });
+    m_server.on("/powerMeasCapture", HTTP_GET, [](AsyncWebServerRequest *request){
+        Log::debug("HTTP", "GET request, /powerMeasCapture");
+        bool binary = false;
+        if (request->hasParam("format"))
+            binary = (request->getParam("format")->value() == "bin");
+        uint32_t generation = PowerMeasCapture::getGeneration();
+        uint16_t row = 0;
+        bool headerSent = binary;
+        AsyncWebServerResponse *response = request->beginChunkedResponse(binary ? "application/octet-stream" : "text/csv", 
+            [binary, generation, row, headerSent](uint8_t *buffer, size_t maxLen, size_t sent) mutable -> size_t {
+            // Trace of the next step overwrites the buffer, response ends there
+            if (generation != PowerMeasCapture::getGeneration())
+                return 0;
+            size_t length = 0;
+            if (!headerSent)
+            {
+                static const char header[] = "time_us,value\n";
+                if (maxLen < sizeof(header))
+                    return 0;
+                memcpy(buffer, header, sizeof(header) - 1);
+                length = sizeof(header) - 1;
+                headerSent = true;
+            }
+            PowerMeasCapture::Sample sample;
+            while (PowerMeasCapture::getSample(row, sample))
+            {
+                if (binary)
+                {
+                    if (length + sizeof(sample) > maxLen)
+                        break;
+                    memcpy(buffer + length, &sample, sizeof(sample));
+                    length += sizeof(sample);
+                }
+                else
+                {
+                    char line[32];
+                    int lineLength = snprintf(line, sizeof(line), "%u,%.4f\n", sample.timeMicro, sample.value);
+                    if ((lineLength <= 0) || (length + lineLength > maxLen))
+                        break;
+                    memcpy(buffer + length, line, lineLength);
+                    length += lineLength;
+                }
+                row++;
+            }
+            return length;
+        });
+        response->addHeader("X-Capture-Samples", String(PowerMeasCapture::getSampleCount()));
+        response->addHeader("X-Capture-Rate-Hz", String(PowerMeasCapture::getSampleRate(), 1));
+        request->send(response);
+    });
+    m_server.on("/powerMeasurementArchive", HTTP_GET, [](AsyncWebServerRequest *request){
+        Log::debug("HTTP", "GET request, /powerMeasurementArchive");
+        uint8_t index = PowerMeasArchive::Reader::ALL_CHANNELS;
+        uint32_t fromTime = 0;
+        uint32_t toTime = UINT32_MAX;
+        if (request->hasParam("index"))
+            index = (uint8_t)request->getParam("index")->value().toInt();
+        if (request->hasParam("from"))
+            fromTime = (uint32_t)request->getParam("from")->value().toInt();
+        if (request->hasParam("to"))
+            toTime = (uint32_t)request->getParam("to")->value().toInt();
+        // Reader decodes one block at a time, the archive is never loaded to RAM as a whole
+        std::shared_ptr<PowerMeasArchive::Reader> reader = std::make_shared<PowerMeasArchive::Reader>(index, fromTime, toTime);
+        AsyncWebServerResponse *response = request->beginChunkedResponse("text/csv", 
+            [reader](uint8_t *buffer, size_t maxLen, size_t sent) -> size_t {
+            return reader->read(buffer, maxLen);
+        });
+        request->send(response);
+    });
+    m_server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request){
+        AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+        Scheduler::exportMetrics(*response);
+        request->send(response);
+        Log::debug("HTTP", "GET request, /metrics");
+    });
     m_httpUpdater.setup(&m_server, "/update", "", "", getHttpOTA(), defaultProcessor);
     m_server.onNotFound([&](AsyncWebServerRequest *request){
         Log::debug("HTTP", "GET request, not found, redirecting");
@@ -693,9 +951,20 @@ String HttpServer::movementConfigProcessor(const String& var)
     float timeOpenLamellasSecs;
     float shortMovementSecs;
     Louver::getTimesConfig(timeFullOpenSecs, timeFullCloseSecs, timeOpenLamellasSecs, shortMovementSecs);
-    bool upCond;
-    bool downCond;
+    String upCond;
+    String downCond;
     Louver::getPowerCondStop(upCond, downCond);
+    bool positionAware;
+    float safetyOverrun;
+    uint32_t rehomeMoves;
+    float rehomeTravel;
+    Louver::getFullMovesConfig(positionAware, safetyOverrun, rehomeMoves, rehomeTravel);
+    uint32_t startLagUp;
+    uint32_t stopLagUp;
+    uint32_t startLagDown;
+    uint32_t stopLagDown;
+    Louver::getMotorLag(Louver::DIR_UP, startLagUp, stopLagUp);
+    Louver::getMotorLag(Louver::DIR_DOWN, startLagDown, stopLagDown);
     if (var == "TIME_FULL_OPEN")
         return String(timeFullOpenSecs);
     if (var == "TIME_FULL_CLOSE")
@@ -704,14 +973,28 @@ String HttpServer::movementConfigProcessor(const String& var)
         return String(timeOpenLamellasSecs);
     if (var == "TIME_SHORT")
         return String(shortMovementSecs);
-    if ((var == "SELECTED_OPEN_STOP_PWRCOND1_NO") && (!upCond))
-        return "selected";
-    if ((var == "SELECTED_OPEN_STOP_PWRCOND1_YES") && (upCond))
+    if (var == "STOP_OPEN_CONDITION")
+        return htmlEscape(upCond);
+    if (var == "STOP_CLOSE_CONDITION")
+        return htmlEscape(downCond);
+    if ((var == "SELECTED_POSITION_AWARE_NO") && (!positionAware))
         return "selected";
-    if ((var == "SELECTED_CLOSE_STOP_PWRCOND2_NO") && (!downCond))
-        return "selected";
-    if ((var == "SELECTED_CLOSE_STOP_PWRCOND2_YES") && (downCond))
+    if ((var == "SELECTED_POSITION_AWARE_YES") && (positionAware))
         return "selected";
+    if (var == "SAFETY_OVERRUN")
+        return String(safetyOverrun);
+    if (var == "REHOME_MOVES")
+        return String(rehomeMoves);
+    if (var == "REHOME_TRAVEL")
+        return String(rehomeTravel);
+    if (var == "START_LAG_UP")
+        return String(startLagUp);
+    if (var == "STOP_LAG_UP")
+        return String(stopLagUp);
+    if (var == "START_LAG_DOWN")
+        return String(startLagDown);
+    if (var == "STOP_LAG_DOWN")
+        return String(stopLagDown);
     return defaultProcessor(var);
 }
 
@@ -762,6 +1045,8 @@ String HttpServer::mqttConfigProcessor(const String& var)
         return String(Mqtt::getAuthenticationPassword());
     if (var == "MQTT_POWER_MEAS_PERIOD")
         return htmlEscape(String(Mqtt::getPowerPublishPeriod()));
+    if (var == "MQTT_METRICS_PERIOD")
+        return htmlEscape(String(Mqtt::getMetricsPublishPeriod()));
     return defaultProcessor(var);
 }
 
@@ -775,16 +1060,30 @@ String HttpServer::powerMeasConfigProcessor(const String& var)
         return "selected";
     if ((var == "POWER_MEAS_DRIVER_3") && (PowerMeas::getActiveDeviceType() == PowerMeas::DEV_CSE7761))
         return "selected";
+    if ((var == "POWER_MEAS_DRIVER_4") && (PowerMeas::getActiveDeviceType() == PowerMeas::DEV_HLW8012))
+        return "selected";
     if (var == "POWER_MEAS_BL0939_CONFIG")
         return htmlEscape(String(PowerMeas::getConfiguration(PowerMeas::DEV_BL0939)));
     if (var == "POWER_MEAS_ADE7953_CONFIG")
         return htmlEscape(String(PowerMeas::getConfiguration(PowerMeas::DEV_ADE7953)));
     if (var == "POWER_MEAS_CSE7761_CONFIG")
         return htmlEscape(String(PowerMeas::getConfiguration(PowerMeas::DEV_CSE7761)));
-    if (var == "POWER_MEAS_STOP_COND_1")
-        return htmlEscape(String(PowerMeas::getConditionConfig(0)));
-    if (var == "POWER_MEAS_STOP_COND_2")
-        return htmlEscape(String(PowerMeas::getConditionConfig(1)));
+    if (var == "POWER_MEAS_HLW8012_CONFIG")
+        return htmlEscape(String(PowerMeas::getConfiguration(PowerMeas::DEV_HLW8012)));
+    if (var == "POWER_MEAS_EXTRA_DEVICES")
+        return htmlEscape(PowerMeas::getExtraDevices());
+    if (var == "POWER_MEAS_FILTERS")
+        return htmlEscape(PowerMeas::getFiltersConfig());
+    if (var == "POWER_MEAS_CONDITIONS")
+        return htmlEscape(PowerMeas::getConditionsConfig());
+    if (var == "POWER_MEAS_MOTION_ANALYZER")
+        return htmlEscape(MotionAnalyzer::getConfig());
+    if (var == "POWER_MEAS_MOVEMENT_STATS")
+        return htmlEscape(MovementStats::getConfig());
+    if (var == "POWER_MEAS_CAPTURE")
+        return htmlEscape(PowerMeasCapture::getConfig());
+    if (var == "POWER_MEAS_ARCHIVE_PERIOD")
+        return htmlEscape(String(PowerMeasArchive::getPeriod()));
     return defaultProcessor(var);
 }
 
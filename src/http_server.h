@@ -82,6 +82,9 @@ private:
 
     static String powerMeasConfigProcessor(const String& var);
 
+    // Saved page, or 507 when configuration could not be written to EEPROM
+    static void sendConfigSaved(AsyncWebServerRequest* request, const char* page);
+
     WifiConfig m_wifiConfig;
     WifiClientBehavior m_wifiClientBehavior;
     UpdateServer m_httpUpdater;
@@ -0,0 +1,135 @@
+#include "key_input.h"
+#include "time.h"
+#include "log.h"
+
+static KeyInput* s_instance = nullptr;
+
+KeyInput::KeyInput() :
+    m_edgeHead(0),
+    m_edgeTail(0),
+    m_droppedEdges(0),
+    m_lastDroppedEdges(0)
+{
+    s_instance = this;
+    for(uint8_t i = 0; i < KEY_COUNT; i++)
+    {
+        m_keys[i].configured = false;
+        m_keys[i].polled = false;
+        m_keys[i].pin = 0;
+        m_keys[i].activeHigh = true;
+        m_keys[i].active = false;
+        m_keys[i].lastChangeMicro = 0;
+    }
+}
+
+void KeyInput::configure(Key key, uint8_t pin, bool activeHigh)
+{
+    KeyInput& inst = getInstance();
+    if (key >= KEY_COUNT)
+        return;
+    KeyState& state = inst.m_keys[key];
+    if (state.configured && !state.polled)
+        detachInterrupt(digitalPinToInterrupt(state.pin));
+    state.pin = pin;
+    state.activeHigh = activeHigh;
+    state.active = (digitalRead(pin) == HIGH) == activeHigh;
+    state.lastChangeMicro = Time::nowRelativeMicro();
+    state.polled = digitalPinToInterrupt(pin) == NOT_AN_INTERRUPT;
+    state.configured = true;
+    if (state.polled)
+    {
+        Log::info("KeyInput", "Key %d, pin %d has no interrupt, using polling", key, pin);
+    }
+    else
+    {
+        attachInterruptArg(digitalPinToInterrupt(pin), edgeIsr, (void*)(uintptr_t)key, CHANGE);
+        Log::debug("KeyInput", "Key %d attached to pin %d", key, pin);
+    }
+}
+
+bool KeyInput::isActive(Key key)
+{
+    if (key >= KEY_COUNT)
+        return false;
+    return getInstance().m_keys[key].active;
+}
+
+uint64_t KeyInput::getLastChangeMilli(Key key)
+{
+    if (key >= KEY_COUNT)
+        return 0;
+    uint64_t changeMilli = getInstance().m_keys[key].lastChangeMicro / 1000;
+    uint64_t now = Time::nowRelativeMilli();
+    // Micro and milli clocks are not read atomically, do not let edge lie in future
+    if (changeMilli > now)
+        changeMilli = now;
+    return changeMilli;
+}
+
+uint32_t KeyInput::getDroppedEdges()
+{
+    return getInstance().m_droppedEdges;
+}
+
+void IRAM_ATTR KeyInput::edgeIsr(void* arg)
+{
+    KeyInput& inst = *s_instance;
+    uint8_t key = (uint8_t)(uintptr_t)arg;
+    uint8_t next = (inst.m_edgeHead + 1) % EDGE_QUEUE_SIZE;
+    if (next == inst.m_edgeTail)
+    {
+        inst.m_droppedEdges++;
+        return;
+    }
+    Edge& edge = inst.m_edges[inst.m_edgeHead];
+    edge.key = key;
+    edge.level = digitalRead(inst.m_keys[key].pin);
+    edge.timeMicro = Time::nowRelativeMicro();
+    inst.m_edgeHead = next;
+}
+
+void KeyInput::applyLevel(uint8_t key, uint8_t level, uint64_t timeMicro)
+{
+    KeyState& state = m_keys[key];
+    bool active = (level == HIGH) == state.activeHigh;
+    if (active != state.active)
+    {
+        state.active = active;
+        state.lastChangeMicro = timeMicro;
+    }
+}
+
+void KeyInput::resync()
+{
+    uint64_t now = Time::nowRelativeMicro();
+    for(uint8_t i = 0; i < KEY_COUNT; i++)
+    {
+        if (m_keys[i].configured)
+            applyLevel(i, digitalRead(m_keys[i].pin), now);
+    }
+}
+
+void KeyInput::process()
+{
+    KeyInput& inst = getInstance();
+    while (inst.m_edgeTail != inst.m_edgeHead)
+    {
+        const Edge& edge = inst.m_edges[inst.m_edgeTail];
+        if (edge.key < KEY_COUNT)
+            inst.applyLevel(edge.key, edge.level, edge.timeMicro);
+        inst.m_edgeTail = (inst.m_edgeTail + 1) % EDGE_QUEUE_SIZE;
+    }
+    if (inst.m_droppedEdges != inst.m_lastDroppedEdges)
+    {
+        // Some edges were lost, take actual levels
+        inst.m_lastDroppedEdges = inst.m_droppedEdges;
+        Log::warning("KeyInput", "Edge queue overflow, %d edges dropped", inst.m_lastDroppedEdges);
+        inst.resync();
+    }
+    uint64_t now = Time::nowRelativeMicro();
+    for(uint8_t i = 0; i < KEY_COUNT; i++)
+    {
+        if (inst.m_keys[i].configured && inst.m_keys[i].polled)
+            inst.applyLevel(i, digitalRead(inst.m_keys[i].pin), now);
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+
+class KeyInput
+{
+public:
+
+    enum Key
+    {
+        KEY_UP = 0,
+        KEY_DOWN,
+        KEY_RESET,
+        KEY_COUNT
+    };
+
+    static void configure(Key key, uint8_t pin, bool activeHigh);
+
+    static bool isActive(Key key);
+
+    static uint64_t getLastChangeMilli(Key key);
+
+    static uint32_t getDroppedEdges();
+
+    static void process();
+
+private:
+
+    static constexpr uint8_t EDGE_QUEUE_SIZE = 32;
+
+    struct Edge
+    {
+        uint8_t key;
+        uint8_t level;
+        uint64_t timeMicro;
+    };
+
+    struct KeyState
+    {
+        bool configured;
+        bool polled;
+        uint8_t pin;
+        bool activeHigh;
+        bool active;
+        uint64_t lastChangeMicro;
+    };
+
+    KeyInput();
+
+    static inline KeyInput& getInstance()
+    {
+        static KeyInput keyInput;
+        return keyInput;
+    }
+
+    static void edgeIsr(void* arg);
+
+    void applyLevel(uint8_t key, uint8_t level, uint64_t timeMicro);
+
+    void resync();
+
+    KeyState m_keys[KEY_COUNT];
+    Edge m_edges[EDGE_QUEUE_SIZE];
+    // Single producer (GPIO ISR) / single consumer (process) ring buffer
+    volatile uint8_t m_edgeHead;
+    volatile uint8_t m_edgeTail;
+    volatile uint32_t m_droppedEdges;
+    uint32_t m_lastDroppedEdges;
+};
@@ -5,14 +5,49 @@
 #include "config.h"
 #include "power_meas.h"
 #include "mqtt.h"
+#include "key_input.h"
+#include "position_store.h"
+#include "motion_analyzer.h"
+#include "movement_stats.h"
+#include "power_meas_capture.h"
+
+#ifdef ESP32
+static portMUX_TYPE s_relayMux = portMUX_INITIALIZER_UNLOCKED;
+#define RELAY_LOCK() portENTER_CRITICAL(&s_relayMux)
+#define RELAY_UNLOCK() portEXIT_CRITICAL(&s_relayMux)
+// Step timer callback is dispatched from the esp_timer task
+#define RELAY_LOCK_TIMER() portENTER_CRITICAL(&s_relayMux)
+#define RELAY_UNLOCK_TIMER() portEXIT_CRITICAL(&s_relayMux)
+#else
+#define RELAY_LOCK() noInterrupts()
+#define RELAY_UNLOCK() interrupts()
+// Step timer runs in timer1 interrupt, interrupts must not be enabled there
+#define RELAY_LOCK_TIMER()
+#define RELAY_UNLOCK_TIMER()
+// Timer1 runs at 80 MHz / 256, 23 bit counter
+static const uint32_t TIMER1_TICKS_PER_MILLI_X2 = 625;
+static const uint32_t TIMER1_MAX_TICKS = 0x7fffff;
+#endif
+
+static Louver* s_timerInstance = nullptr;
 
 Louver::Louver() :
+    m_positionFixed(0),
+    m_relayState(RELAY_IDLE),
+    m_relayOnMicro(0),
+    m_segmentOnMicro(0),
+    m_segmentOffMicro(0),
+    m_segmentState(RELAY_IDLE),
+    m_segmentPending(false),
+    m_relayCycles(0),
+    m_motorRuntimeMilli(0),
+    m_saveStatePending(false),
     m_lastKeyUpState(false),
     m_lastKeyDownState(false),
     m_lastKeyUpChangeTime(0),
     m_lastKeyDownChangeTime(0),
-    m_stopUpOnPowerCond1(false),
-    m_stopDownOnPowerCond2(false),
+    m_partialMovesSinceHome(0),
+    m_travelSinceHome(0),
     m_state(ST_IDLE),
     m_closePercent(0),
     m_keyUpReleased(false),
@@ -22,9 +57,26 @@ Louver::Louver() :
     m_mqttKeyUpHoldReported(false),
     m_mqttKeyDownHoldReported(false),
     m_lastPositionReportTime(0),
-    m_lastPositionUpdateTime(0)
+    m_stepTimerArmed(false),
+    m_stepTimerFired(false),
+    m_stepConditionMet(false),
+    m_stepCutOffMicro(0),
+    m_stepTimerRemainingTicks(0),
+    m_stepStartMicro(0),
+    m_lastOvershootMicro(0),
+    m_maxOvershootMicro(0)
 {
     m_position = 0;
+    s_timerInstance = this;
+#ifdef ESP32
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = stepTimerCallback;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "louver_step";
+    if (esp_timer_create(&timerArgs, &m_stepTimer) != ESP_OK)
+        m_stepTimer = nullptr;
+#endif
     setDefaultsPrivate();
 }
 
@@ -38,6 +90,20 @@ void Louver::loadConfig()
     getInstance().loadConfigPrivate();
 }
 
+void Louver::init()
+{
+    Louver& inst = getInstance();
+    PowerMeas::setConditionListener(onPowerCondition);
+    PositionStore::State state;
+    if (PositionStore::load(state))
+    {
+        inst.setPosition(state.position);
+        inst.m_relayCycles = state.relayCycles;
+        inst.m_motorRuntimeMilli = state.motorRuntimeMilli;
+        Log::info("Louver", "Restored position %f %%, relay cycles %d, motor runtime %d s", inst.m_position, inst.m_relayCycles, (uint32_t)(inst.m_motorRuntimeMilli / 1000));
+    }
+}
+
 void Louver::setDefaultsPrivate()
 {
     m_pinKeyUp = DEFAULT_PIN_KEY_UP;
@@ -54,8 +120,16 @@ void Louver::setDefaultsPrivate()
     m_timeDown = (uint32_t)(DEFAULT_TIME_DOWN_SECS * 1000);
     m_timeOpenLamellas = (uint32_t)(DEFAULT_TIME_OPEN_LAMELLAS_SECS * 1000);
     m_timeShortMovement = (uint32_t)(DEFAULT_TIME_SHORT_MOVEMENT_SECS * 1000);
-    m_stopUpOnPowerCond1 = false;
-    m_stopDownOnPowerCond2 = false;
+    m_stopUpCondition = "";
+    m_stopDownCondition = "";
+    m_positionAwareFullMoves = false;
+    m_safetyOverrunPercent = DEFAULT_SAFETY_OVERRUN_PERCENT;
+    m_rehomeMoves = DEFAULT_REHOME_MOVES;
+    m_rehomeTravelPercent = DEFAULT_REHOME_TRAVEL_PERCENT;
+    m_startLagUp = DEFAULT_START_LAG_MILLI;
+    m_stopLagUp = DEFAULT_STOP_LAG_MILLI;
+    m_startLagDown = DEFAULT_START_LAG_MILLI;
+    m_stopLagDown = DEFAULT_STOP_LAG_MILLI;
     recalculatePercents();
     initPins();
     Log::info("Louver", "Defaults set");
@@ -77,8 +151,17 @@ void Louver::loadConfigPrivate()
     m_timeDown = (uint32_t)(Config::getFloat("timing/down", DEFAULT_TIME_DOWN_SECS) * 1000);
     m_timeOpenLamellas = (uint32_t)(Config::getFloat("timing/open_lamellas", DEFAULT_TIME_OPEN_LAMELLAS_SECS) * 1000);
     m_timeShortMovement = (uint32_t)(Config::getFloat("timing/short_movement", DEFAULT_TIME_SHORT_MOVEMENT_SECS) * 1000);
-    m_stopUpOnPowerCond1 = Config::getBool("timing/stop_up_on_power_cond_1", false);
-    m_stopDownOnPowerCond2 = Config::getBool("timing/stop_down_on_power_cond_2", false);
+    // Older configurations enabled numbered conditions 1 and 2
+    m_stopUpCondition = Config::getString("timing/stop_up_cond", Config::getBool("timing/stop_up_on_power_cond_1", false) ? "cond1" : "");
+    m_stopDownCondition = Config::getString("timing/stop_down_cond", Config::getBool("timing/stop_down_on_power_cond_2", false) ? "cond2" : "");
+    m_positionAwareFullMoves = Config::getBool("timing/position_aware", false);
+    m_safetyOverrunPercent = Config::getFloat("timing/safety_overrun", DEFAULT_SAFETY_OVERRUN_PERCENT);
+    m_rehomeMoves = (uint32_t)Config::getInt("timing/rehome_moves", DEFAULT_REHOME_MOVES);
+    m_rehomeTravelPercent = Config::getFloat("timing/rehome_travel", DEFAULT_REHOME_TRAVEL_PERCENT);
+    m_startLagUp = (uint32_t)Config::getInt("timing/start_lag_up", DEFAULT_START_LAG_MILLI);
+    m_stopLagUp = (uint32_t)Config::getInt("timing/stop_lag_up", DEFAULT_STOP_LAG_MILLI);
+    m_startLagDown = (uint32_t)Config::getInt("timing/start_lag_down", DEFAULT_START_LAG_MILLI);
+    m_stopLagDown = (uint32_t)Config::getInt("timing/stop_lag_down", DEFAULT_STOP_LAG_MILLI);
     recalculatePercents();
     initPins();
     Log::info("Louver", "Configuration loaded");
@@ -172,20 +255,91 @@ float Louver::getShortMovementSecs()
     return (float)getInstance().m_timeShortMovement / 1000;
 }
 
-void Louver::configurePowerCondStop(bool upStopCond1, bool downStopCodn2)
+void Louver::configurePowerCondStop(String upCondition, String downCondition)
+{
+    Louver& inst = getInstance();
+    upCondition.trim();
+    downCondition.trim();
+    inst.m_stopUpCondition = upCondition;
+    inst.m_stopDownCondition = downCondition;
+    Config::setString("timing/stop_up_cond", upCondition);
+    Config::setString("timing/stop_down_cond", downCondition);
+    Config::flush();
+    Log::info("Louver", "Power stop condition set, up=%s, down=%s", upCondition.c_str(), downCondition.c_str());
+}
+
+void Louver::getPowerCondStop(String& upCondition, String& downCondition)
+{
+    upCondition = getInstance().m_stopUpCondition;
+    downCondition = getInstance().m_stopDownCondition;
+}
+
+uint8_t Louver::getStopCondition(Direction direction)
+{
+    uint8_t condition = PowerMeas::findCondition((direction == DIR_UP) ? m_stopUpCondition : m_stopDownCondition);
+    if ((condition == PowerMeas::NO_CONDITION) && (((direction == DIR_UP) ? m_stopUpCondition : m_stopDownCondition).length() > 0))
+        Log::error("Louver", "Stop condition for direction %d not found", direction);
+    return condition;
+}
+
+void Louver::configureFullMoves(bool positionAware, float safetyOverrunPercent, uint32_t rehomeMoves, float rehomeTravelPercent)
+{
+    Louver& inst = getInstance();
+    inst.m_positionAwareFullMoves = positionAware;
+    inst.m_safetyOverrunPercent = safetyOverrunPercent;
+    inst.m_rehomeMoves = rehomeMoves;
+    inst.m_rehomeTravelPercent = rehomeTravelPercent;
+    Config::setBool("timing/position_aware", positionAware);
+    Config::setFloat("timing/safety_overrun", safetyOverrunPercent);
+    Config::setInt("timing/rehome_moves", rehomeMoves);
+    Config::setFloat("timing/rehome_travel", rehomeTravelPercent);
+    Config::flush();
+    Log::info("Louver", "Full moves set, position aware=%d, overrun=%f %%, rehome after %d moves or %f %% travel", positionAware, safetyOverrunPercent, rehomeMoves, rehomeTravelPercent);
+}
+
+void Louver::configureMotorLag(Direction dir, uint32_t startLagMilli, uint32_t stopLagMilli)
+{
+    Louver& inst = getInstance();
+    if (dir == DIR_UP)
+    {
+        inst.m_startLagUp = startLagMilli;
+        inst.m_stopLagUp = stopLagMilli;
+        Config::setInt("timing/start_lag_up", startLagMilli);
+        Config::setInt("timing/stop_lag_up", stopLagMilli);
+    }
+    else
+    {
+        inst.m_startLagDown = startLagMilli;
+        inst.m_stopLagDown = stopLagMilli;
+        Config::setInt("timing/start_lag_down", startLagMilli);
+        Config::setInt("timing/stop_lag_down", stopLagMilli);
+    }
+    Config::flush();
+    Log::info("Louver", "Motor lag set, direction %d, start=%d ms, stop=%d ms", dir, startLagMilli, stopLagMilli);
+}
+
+void Louver::getMotorLag(Direction dir, uint32_t& startLagMilli, uint32_t& stopLagMilli)
 {
     Louver& inst = getInstance();
-    inst.m_stopUpOnPowerCond1 = upStopCond1;
-    inst.m_stopDownOnPowerCond2 = downStopCodn2;
-    Config::setBool("timing/stop_up_on_power_cond_1", upStopCond1);
-    Config::setBool("timing/stop_down_on_power_cond_2", downStopCodn2);
-    Log::info("Louver", "Power stop condition set, up=%d, down=%d", inst.m_stopUpOnPowerCond1, inst.m_stopDownOnPowerCond2);
+    if (dir == DIR_UP)
+    {
+        startLagMilli = inst.m_startLagUp;
+        stopLagMilli = inst.m_stopLagUp;
+    }
+    else
+    {
+        startLagMilli = inst.m_startLagDown;
+        stopLagMilli = inst.m_stopLagDown;
+    }
 }
 
-void Louver::getPowerCondStop(bool& upStopCond1, bool& downStopCodn2)
+void Louver::getFullMovesConfig(bool& positionAware, float& safetyOverrunPercent, uint32_t& rehomeMoves, float& rehomeTravelPercent)
 {
-    upStopCond1 = getInstance().m_stopUpOnPowerCond1;
-    downStopCodn2 = getInstance().m_stopDownOnPowerCond2;
+    Louver& inst = getInstance();
+    positionAware = inst.m_positionAwareFullMoves;
+    safetyOverrunPercent = inst.m_safetyOverrunPercent;
+    rehomeMoves = inst.m_rehomeMoves;
+    rehomeTravelPercent = inst.m_rehomeTravelPercent;
 }
 
 void Louver::fullOpen()
@@ -193,8 +347,9 @@ void Louver::fullOpen()
     Louver& inst = getInstance();
     MovementStep step;
     step.direction = DIR_UP;
-    step.timeMilli = inst.m_timeUp;
-    step.checkConditions = true;
+    step.timeMilli = inst.getFullMoveTime(DIR_UP);
+    step.stopCondition = inst.getStopCondition(DIR_UP);
+    step.endStop = true;
     inst.m_movement.clear();
     inst.m_movement.push_back(step);
     Mqtt::publishMovement("open");
@@ -207,8 +362,9 @@ void Louver::fullClose()
     Louver& inst = getInstance();
     MovementStep step;
     step.direction = DIR_DOWN;
-    step.timeMilli = inst.m_timeDown;
-    step.checkConditions = true;
+    step.timeMilli = inst.getFullMoveTime(DIR_DOWN);
+    step.stopCondition = inst.getStopCondition(DIR_DOWN);
+    step.endStop = true;
     inst.m_movement.clear();
     inst.m_movement.push_back(step);
     Mqtt::publishMovement("close");
@@ -224,7 +380,8 @@ void Louver::shortOpen(float timeSecs)
         timeSecs = (float)inst.m_timeShortMovement / 1000;
     step.direction = DIR_UP;
     step.timeMilli = (uint32_t)(timeSecs * 1000);
-    step.checkConditions = false;
+    step.stopCondition = PowerMeas::NO_CONDITION;
+    step.endStop = false;
     inst.m_movement.clear();
     inst.m_movement.push_back(step);
     Mqtt::publishMovement("up");
@@ -240,7 +397,8 @@ void Louver::shortClose(float timeSecs)
         timeSecs = (float)inst.m_timeShortMovement / 1000;
     step.direction = DIR_DOWN;
     step.timeMilli = (uint32_t)(timeSecs * 1000);
-    step.checkConditions = false;
+    step.stopCondition = PowerMeas::NO_CONDITION;
+    step.endStop = false;
     inst.m_movement.clear();
     inst.m_movement.push_back(step);
     Mqtt::publishMovement("down");
@@ -254,24 +412,105 @@ void Louver::fullCloseAndOpenLamellas()
     Louver& inst = getInstance();
     MovementStep step;
     step.direction = DIR_DOWN;
-    step.timeMilli = inst.m_timeDown;
-    step.checkConditions = true;
+    step.timeMilli = inst.getFullMoveTime(DIR_DOWN);
+    step.stopCondition = inst.getStopCondition(DIR_DOWN);
+    step.endStop = true;
     inst.m_movement.clear();
     inst.m_movement.push_back(step);
     step.direction = DIR_UP;
     step.timeMilli = inst.m_timeOpenLamellas;
-    step.checkConditions = false;
+    step.stopCondition = PowerMeas::NO_CONDITION;
+    step.endStop = false;
     inst.m_movement.push_back(step);
     Mqtt::publishMovement("close_open_lamellas");
     Log::info("Louver", "Full close and open lamellas movement");
     inst.startMovement();
 }
 
+void Louver::moveToPosition(float percent)
+{
+    Louver& inst = getInstance();
+    if (percent < 0)
+        percent = 0;
+    if (percent > 100)
+        percent = 100;
+    float delta = percent - inst.m_position;
+    bool endPosition = (percent == 0) || (percent == 100);
+    if (!endPosition && (fabsf(delta) < POSITION_TOLERANCE_PERCENT))
+    {
+        Log::info("Louver", "Position %f %% already reached", percent);
+        return;
+    }
+    MovementStep step;
+    float percentPerMilli;
+    int32_t lagMilli;
+    if (delta < 0)
+    {
+        step.direction = DIR_UP;
+        percentPerMilli = inst.m_percentPerMilliUp;
+        lagMilli = (int32_t)inst.m_startLagUp - (int32_t)inst.m_stopLagUp;
+    }
+    else
+    {
+        step.direction = DIR_DOWN;
+        percentPerMilli = inst.m_percentPerMilliDown;
+        lagMilli = (int32_t)inst.m_startLagDown - (int32_t)inst.m_stopLagDown;
+    }
+    if (percentPerMilli == 0)
+    {
+        Log::error("Louver", "Unable to move to position, travel time not configured");
+        return;
+    }
+    float distance = fabsf(delta);
+    if (endPosition)
+        distance += POSITION_END_OVERRUN_PERCENT;
+    // Relay on time covering motor start lag and coasting after relay off
+    int32_t timeMilli = (int32_t)(distance / percentPerMilli) + lagMilli;
+    if (timeMilli <= 0)
+    {
+        Log::info("Louver", "Position %f %% is closer than motor lag", percent);
+        return;
+    }
+    step.timeMilli = (uint32_t)timeMilli;
+    step.stopCondition = endPosition ? inst.getStopCondition(step.direction) : PowerMeas::NO_CONDITION;
+    step.endStop = endPosition;
+    inst.m_movement.clear();
+    inst.m_movement.push_back(step);
+    Mqtt::publishMovement("position");
+    Log::info("Louver", "Move to position %f %%, direction %d, time %d ms", percent, step.direction, step.timeMilli);
+    inst.startMovement();
+}
+
+float Louver::getPosition()
+{
+    return getInstance().m_position;
+}
+
+uint32_t Louver::getRelayCycles()
+{
+    return getInstance().m_relayCycles;
+}
+
+uint64_t Louver::getMotorRuntimeMilli()
+{
+    return getInstance().m_motorRuntimeMilli;
+}
+
 void Louver::stop()
 {
     getInstance().delay(ST_WAIT_RELEASE);
 }
 
+int32_t Louver::getLastOvershootMicro()
+{
+    return getInstance().m_lastOvershootMicro;
+}
+
+int32_t Louver::getMaxOvershootMicro()
+{
+    return getInstance().m_maxOvershootMicro;
+}
+
 void Louver::initPins()
 {
     uint8_t pull = INPUT_PULLUP;
@@ -298,6 +537,8 @@ void Louver::initPins()
     if (!m_keyDownPullEnabled)
         pull = 0;
     pinMode(m_pinKeyDown, INPUT | pull);
+    KeyInput::configure(KeyInput::KEY_UP, m_pinKeyUp, m_keyUpActiveHigh);
+    KeyInput::configure(KeyInput::KEY_DOWN, m_pinKeyDown, m_keyDownActiveHigh);
     pinMode(m_pinRelayUp, OUTPUT);
     pinMode(m_pinRelayDown, OUTPUT);
     if (m_relayUpActiveHigh)
@@ -335,7 +576,8 @@ void Louver::updateRelays()
                 {
                     dir = m_movement[index].direction;
                 }
-                if (index == -1)
+                RELAY_LOCK();
+                if ((index == -1) || m_stepTimerFired || m_stepConditionMet)
                 {
                     relaysIdle();
                 }
@@ -346,9 +588,14 @@ void Louver::updateRelays()
                     else
                         relaysDown();
                 }
+                RELAY_UNLOCK();
             }
             break;
     }
+    // Measurement refresh follows motor state, steps are separated by short delays
+    bool motion = (m_state == ST_UP) || (m_state == ST_DOWN) || (m_state == ST_MOVEMENT) ||
+        ((m_state == ST_DELAY) && (m_nextState == ST_MOVEMENT));
+    PowerMeas::setMotionActive(motion);
 }
 
 void Louver::recalculatePercents()
@@ -363,32 +610,118 @@ void Louver::recalculatePercents()
         m_percentPerMilliDown = 0;
 }
 
-void Louver::updatePosition(Direction direction)
+int32_t Louver::getTravel(RelayState relayState, uint64_t onTimeMicro, bool stopped)
 {
-    uint64_t now = Time::nowRelativeMilli();
-    if (m_lastPositionUpdateTime == 0)
-        m_lastPositionUpdateTime = now;
-    uint64_t delta = now - m_lastPositionUpdateTime;
-    if (delta >= POSITION_UPDATE_PERIOD_MILLI)
+    uint32_t fullTime = (relayState == RELAY_UP) ? m_timeUp : m_timeDown;
+    uint32_t startLag = (relayState == RELAY_UP) ? m_startLagUp : m_startLagDown;
+    uint32_t stopLag = (relayState == RELAY_UP) ? m_stopLagUp : m_stopLagDown;
+    if (fullTime == 0)
+        return 0;
+    int64_t effective = (int64_t)onTimeMicro - (int64_t)startLag * 1000;
+    if (effective <= 0)
+        return 0;
+    if (stopped)
+        effective += (int64_t)stopLag * 1000;
+    // Travel is calculated from the whole relay on time, so there is no rounding accumulation
+    uint64_t travel = ((uint64_t)effective * (uint64_t)POSITION_FULL) / ((uint64_t)fullTime * 1000);
+    if (travel > (uint64_t)POSITION_FULL)
+        travel = POSITION_FULL;
+    return (int32_t)travel;
+}
+
+void Louver::setPosition(int32_t position)
+{
+    if (position < 0)
+        position = 0;
+    if (position > POSITION_FULL)
+        position = POSITION_FULL;
+    m_positionFixed = position;
+    m_position = (float)((int64_t)position * 100) / (float)POSITION_FULL;
+}
+
+void Louver::saveState()
+{
+    PositionStore::State state;
+    state.position = m_positionFixed;
+    state.relayCycles = m_relayCycles;
+    state.motorRuntimeMilli = m_motorRuntimeMilli;
+    PositionStore::save(state);
+}
+
+void Louver::updatePosition()
+{
+    RELAY_LOCK();
+    RelayState relayState = m_relayState;
+    uint64_t onMicro = m_relayOnMicro;
+    uint64_t segmentOnMicro = m_segmentOnMicro;
+    uint64_t segmentOffMicro = m_segmentOffMicro;
+    RelayState segmentState = m_segmentState;
+    bool segmentPending = m_segmentPending;
+    m_segmentPending = false;
+    RELAY_UNLOCK();
+    if (segmentPending)
     {
-        m_lastPositionUpdateTime = now;
-        if (direction == DIR_UP)
-        {
-            m_position -= (float)delta * m_percentPerMilliUp;
-            if (m_position < 0)
-                m_position = 0;
-        }
-        else if (direction == DIR_DOWN)
-        {
-            m_position += (float)delta * m_percentPerMilliDown;
-            if (m_position > 100)
-                m_position = 100;
-        }
+        // Relays switched off - commit finished segment including stop lag
+        int32_t travel = getTravel(segmentState, segmentOffMicro - segmentOnMicro, true);
+        m_motorRuntimeMilli += (segmentOffMicro - segmentOnMicro) / 1000;
+        m_saveStatePending = true;
+        m_travelSinceHome += (float)((int64_t)travel * 100) / (float)POSITION_FULL;
+        if (segmentState == RELAY_UP)
+            setPosition(m_positionFixed - travel);
+        else
+            setPosition(m_positionFixed + travel);
+    }
+    if (relayState != RELAY_IDLE)
+    {
+        int32_t travel = getTravel(relayState, Time::nowRelativeMicro() - onMicro, false);
+        int32_t position = (relayState == RELAY_UP) ? (m_positionFixed - travel) : (m_positionFixed + travel);
+        if (position < 0)
+            position = 0;
+        if (position > POSITION_FULL)
+            position = POSITION_FULL;
+        m_position = (float)((int64_t)position * 100) / (float)POSITION_FULL;
+    }
+}
+
+uint32_t Louver::getFullMoveTime(Direction direction)
+{
+    uint32_t fullTime = (direction == DIR_UP) ? m_timeUp : m_timeDown;
+    if (!m_positionAwareFullMoves)
+        return fullTime;
+    if (((m_rehomeMoves != 0) && (m_partialMovesSinceHome >= m_rehomeMoves)) ||
+        ((m_rehomeTravelPercent != 0) && (m_travelSinceHome >= m_rehomeTravelPercent)))
+    {
+        Log::info("Louver", "Re-homing full movement, %d partial moves, %f %% travel since last home", m_partialMovesSinceHome, m_travelSinceHome);
+        return fullTime;
     }
+    float remaining = (direction == DIR_UP) ? m_position : (100 - m_position);
+    remaining += m_safetyOverrunPercent;
+    if (remaining >= 100)
+        return fullTime;
+    return (uint32_t)((float)fullTime * remaining / 100);
+}
+
+void Louver::onPartialMove()
+{
+    m_partialMovesSinceHome++;
+}
+
+void Louver::onHomed()
+{
+    m_partialMovesSinceHome = 0;
+    m_travelSinceHome = 0;
 }
 
 void Louver::relaysUp()
 {
+    if (m_relayState != RELAY_UP)
+    {
+        if (m_relayState != RELAY_IDLE)
+            relaysIdle();
+        m_relayOnMicro = Time::nowRelativeMicro();
+        m_relayState = RELAY_UP;
+        m_relayCycles++;
+    }
     if (m_relayDownActiveHigh)
         digitalWrite(m_pinRelayDown, 0);
     else
@@ -401,6 +734,14 @@ void Louver::relaysUp()
 
 void Louver::relaysDown()
 {
+    if (m_relayState != RELAY_DOWN)
+    {
+        if (m_relayState != RELAY_IDLE)
+            relaysIdle();
+        m_relayOnMicro = Time::nowRelativeMicro();
+        m_relayState = RELAY_DOWN;
+        m_relayCycles++;
+    }
     if (m_relayUpActiveHigh)
         digitalWrite(m_pinRelayUp, 0);
     else
@@ -411,7 +752,9 @@ void Louver::relaysDown()
         digitalWrite(m_pinRelayDown, 0);
 }
 
-void Louver::relaysIdle()
+// Runs from step timer interrupt, everything called here must be in IRAM
+// (digitalWrite is in both cores, Time::nowRelativeMicro is marked)
+void IRAM_ATTR Louver::relaysIdle()
 {
     if (m_relayUpActiveHigh)
         digitalWrite(m_pinRelayUp, 0);
@@ -421,12 +764,23 @@ void Louver::relaysIdle()
         digitalWrite(m_pinRelayDown, 0);
     else
         digitalWrite(m_pinRelayDown, 1);
+    if (m_relayState != RELAY_IDLE)
+    {
+        // May run from step timer, position is committed later by updatePosition
+        m_segmentOnMicro = m_relayOnMicro;
+        m_segmentOffMicro = Time::nowRelativeMicro();
+        m_segmentState = m_relayState;
+        m_segmentPending = true;
+        m_relayState = RELAY_IDLE;
+    }
 }
 
 void Louver::startMovement()
 {
+    disarmStepTimer();
+    m_stepTimerFired = false;
+    m_stepConditionMet = false;
     m_movementStartTime = Time::nowRelativeMilli();
-    m_lastPositionUpdateTime = 0;
     m_keyUpReleased = false;
     m_keyDownReleased = false;
     m_state = ST_MOVEMENT;
@@ -435,8 +789,116 @@ void Louver::startMovement()
     Log::info("Louver", "Starting movement, number of steps = %d", m_movement.size());
 }
 
+void Louver::armStepTimer(uint32_t timeMilli)
+{
+    disarmStepTimer();
+    RELAY_LOCK();
+    m_stepTimerFired = false;
+    m_stepTimerArmed = true;
+    RELAY_UNLOCK();
+    m_stepStartMicro = Time::nowRelativeMicro();
+#ifdef ESP32
+    if (m_stepTimer)
+        esp_timer_start_once(m_stepTimer, (uint64_t)timeMilli * 1000);
+    else
+        m_stepTimerArmed = false;
+#else
+    uint64_t ticks = ((uint64_t)timeMilli * TIMER1_TICKS_PER_MILLI_X2) / 2;
+    uint32_t first = (ticks > TIMER1_MAX_TICKS) ? TIMER1_MAX_TICKS : (uint32_t)ticks;
+    m_stepTimerRemainingTicks = (uint32_t)(ticks - first);
+    timer1_disable();
+    timer1_attachInterrupt(stepTimerIsr);
+    timer1_enable(TIM_DIV256, TIM_EDGE, TIM_SINGLE);
+    timer1_write(first);
+#endif
+}
+
+void Louver::disarmStepTimer()
+{
+    if (!m_stepTimerArmed)
+        return;
+#ifdef ESP32
+    if (m_stepTimer)
+        esp_timer_stop(m_stepTimer);
+#else
+    timer1_disable();
+#endif
+    RELAY_LOCK();
+    m_stepTimerArmed = false;
+    RELAY_UNLOCK();
+}
+
+void IRAM_ATTR Louver::onStepTimer()
+{
+    RELAY_LOCK_TIMER();
+    if (m_stepTimerArmed)
+    {
+        relaysIdle();
+        m_stepCutOffMicro = Time::nowRelativeMicro();
+        m_stepTimerFired = true;
+        m_stepTimerArmed = false;
+    }
+    RELAY_UNLOCK_TIMER();
+}
+
+void IRAM_ATTR Louver::stepTimerCallback(void* arg)
+{
+    static_cast<Louver*>(arg)->onStepTimer();
+}
+
+void Louver::onPowerCondition(uint8_t conditionIndex)
+{
+    Louver& inst = getInstance();
+    if ((inst.m_state != ST_MOVEMENT) || !inst.m_stepTimerArmed || (inst.m_stepIndex >= inst.m_movement.size()))
+        return;
+    if (inst.m_movement[inst.m_stepIndex].stopCondition != conditionIndex)
+        return;
+    inst.disarmStepTimer();
+    RELAY_LOCK();
+    inst.relaysIdle();
+    inst.m_stepConditionMet = true;
+    RELAY_UNLOCK();
+    // Step is finished by the next process() pass
+    Log::debug("Louver", "Relays cut off by stop condition %s", PowerMeas::getConditionName(conditionIndex));
+}
+
+#ifndef ESP32
+void IRAM_ATTR Louver::stepTimerIsr()
+{
+    Louver* inst = s_timerInstance;
+    if (inst->m_stepTimerRemainingTicks > 0)
+    {
+        // Step is longer than timer1 range, continue with the rest
+        uint32_t ticks = inst->m_stepTimerRemainingTicks;
+        if (ticks > TIMER1_MAX_TICKS)
+            ticks = TIMER1_MAX_TICKS;
+        inst->m_stepTimerRemainingTicks -= ticks;
+        timer1_write(ticks);
+        return;
+    }
+    inst->onStepTimer();
+}
+#endif
+
+void Louver::reportOvershoot(uint32_t timeMilli)
+{
+    uint64_t cutOff = m_stepTimerFired ? m_stepCutOffMicro : Time::nowRelativeMicro();
+    int64_t overshoot = (int64_t)(cutOff - m_stepStartMicro) - (int64_t)timeMilli * 1000;
+    m_lastOvershootMicro = (int32_t)overshoot;
+    if (m_lastOvershootMicro > m_maxOvershootMicro)
+        m_maxOvershootMicro = m_lastOvershootMicro;
+    Log::debug("Louver", "Step stop overshoot %d us (%s)", m_lastOvershootMicro, m_stepTimerFired ? "timer" : "loop");
+    Mqtt::publishOvershoot(m_lastOvershootMicro);
+}
+
 void Louver::delay(State nextState)
 {
+    disarmStepTimer();
+    m_stepConditionMet = false;
+    MotionAnalyzer::stop();
+    // Step terminated by key or stop command, finished steps are already closed
+    MovementStats::finish(MovementStats::REASON_INTERRUPTED);
+    PowerMeasCapture::stop();
     m_nextState = nextState;
     m_delayTimeout = Time::nowRelativeMilli() + MOVEMENT_DELAY_MILLI;
     m_state = ST_DELAY;
@@ -446,24 +908,16 @@ void Louver::delay(State nextState)
 void Louver::process()
 {
     Louver& inst = getInstance();
-    bool isKeyUpActive = digitalRead(inst.m_pinKeyUp) == HIGH;
-    if (!inst.m_keyUpActiveHigh)
-        isKeyUpActive = !isKeyUpActive;
-    bool isKeyDownActive = digitalRead(inst.m_pinKeyDown) == HIGH;
-    if (!inst.m_keyDownActiveHigh)
-        isKeyDownActive = !isKeyDownActive;
+    // Key levels and change times come from edge interrupts, not from loop sampling
+    KeyInput::process();
+    bool isKeyUpActive = KeyInput::isActive(KeyInput::KEY_UP);
+    bool isKeyDownActive = KeyInput::isActive(KeyInput::KEY_DOWN);
     uint64_t now = Time::nowRelativeMilli();
 
-    if (isKeyUpActive != inst.m_lastKeyUpState)
-    {
-        inst.m_lastKeyUpState = isKeyUpActive;
-        inst.m_lastKeyUpChangeTime = now;
-    }
-    if (isKeyDownActive != inst.m_lastKeyDownState)
-    {
-        inst.m_lastKeyDownState = isKeyDownActive;
-        inst.m_lastKeyDownChangeTime = now;
-    }
+    inst.m_lastKeyUpState = isKeyUpActive;
+    inst.m_lastKeyUpChangeTime = KeyInput::getLastChangeMilli(KeyInput::KEY_UP);
+    inst.m_lastKeyDownState = isKeyDownActive;
+    inst.m_lastKeyDownChangeTime = KeyInput::getLastChangeMilli(KeyInput::KEY_DOWN);
 
     bool isUpPressDebounced = (now - inst.m_lastKeyUpChangeTime) >= DEBOUNCE_PRESS_MILLI;
     bool isUpHoldDebounced = (now - inst.m_lastKeyUpChangeTime) >= DEBOUNCE_HOLD_MILLI;
@@ -528,25 +982,21 @@ void Louver::process()
             if (isKeyUpActive && isUpPressDebounced)
             {
                 inst.m_state = ST_UP;
-                inst.m_lastPositionUpdateTime = 0;
-                inst.updatePosition(DIR_UP);
                 Mqtt::publishMovement("up");
                 Log::info("Louver", "Up pressed");
             }
             else if (isKeyDownActive && isDownPressDebounced)
             {
                 inst.m_state = ST_DOWN;
-                inst.m_lastPositionUpdateTime = 0;
-                inst.updatePosition(DIR_DOWN);
                 Mqtt::publishMovement("down");
                 Log::info("Louver", "Down pressed");
             }
             break;
         case ST_UP:
-            inst.updatePosition(DIR_UP);
             if (!isKeyUpActive && isUpPressDebounced)
             {
                 Log::info("Louver", "Up released");
+                inst.onPartialMove();
                 Mqtt::publishMovement("stop");
                 inst.delay(ST_IDLE);
                 break;
@@ -558,10 +1008,10 @@ void Louver::process()
             }
             break;
         case ST_DOWN:
-            inst.updatePosition(DIR_DOWN);
             if (!isKeyDownActive && isDownPressDebounced)
             {
                 Log::info("Louver", "Down released");
+                inst.onPartialMove();
                 Mqtt::publishMovement("stop");
                 inst.delay(ST_IDLE);
                 break;
@@ -580,8 +1030,6 @@ void Louver::process()
             break;
         case ST_MOVEMENT:
             {
-                bool upCond = PowerMeas::getConditionResult(0);
-                bool downCond = PowerMeas::getConditionResult(1);
                 if (!isKeyUpActive && isUpPressDebounced)
                 {
                     inst.m_keyUpReleased = true;
@@ -612,32 +1060,94 @@ void Louver::process()
                 }
                 else
                 {
-                    inst.updatePosition(inst.m_movement[index].direction);
+                    if (!inst.m_stepTimerArmed && !inst.m_stepTimerFired)
+                    {
+                        // Relays are switched on at the end of this pass, step timer cuts them off
+                        inst.m_movementStartTime = now;
+                        inst.armStepTimer(inst.m_movement[index].timeMilli);
+                        MotionAnalyzer::start(inst.m_movement[index].direction == DIR_UP);
+                        MovementStats::start(inst.m_movement[index].direction == DIR_UP, inst.m_movement[index].endStop &&
+                            (inst.m_movement[index].timeMilli >= ((inst.m_movement[index].direction == DIR_UP) ? inst.m_timeUp : inst.m_timeDown)));
+                        PowerMeasCapture::start(inst.m_movement[index].direction == DIR_UP);
+                    }
                 }
                 // Stop conditions check
                 bool stopFlag = false;
-                if (inst.m_stopUpOnPowerCond1 && inst.m_movement[index].checkConditions && (inst.m_movement[index].direction == DIR_UP) && upCond)
+                MovementStats::StopReason reason = MovementStats::REASON_TIME;
+                const MovementStep& step = inst.m_movement[index];
+                if ((step.stopCondition != PowerMeas::NO_CONDITION) && (inst.m_stepConditionMet || PowerMeas::getConditionResult(step.stopCondition)))
                 {
                     stopFlag = true;
-                    inst.m_position = 0;
-                    Log::info("Louver", "Stop condition 1 satisfied, stopping movement");
+                    reason = MovementStats::REASON_CONDITION;
+                    if (step.endStop)
+                    {
+                        inst.setPosition((step.direction == DIR_UP) ? 0 : POSITION_FULL);
+                        inst.onHomed();
+                    }
+                    else
+                    {
+                        inst.onPartialMove();
+                    }
+                    Log::info("Louver", "Stop condition %s satisfied, stopping movement", PowerMeas::getConditionName(step.stopCondition));
                 }
-                if (inst.m_stopDownOnPowerCond2 && inst.m_movement[index].checkConditions && (inst.m_movement[index].direction == DIR_DOWN) && downCond)
+                // Current curve analysis, events are detected with every new sample
+                bool obstruction = false;
+                MotionAnalyzer::Event event = MotionAnalyzer::takeEvent();
+                if (!stopFlag && (event == MotionAnalyzer::EV_END_STOP))
                 {
                     stopFlag = true;
-                    inst.m_position = 100;
-                    Log::info("Louver", "Stop condition 2 satisfied, stopping movement");
+                    reason = MovementStats::REASON_END_STOP;
+                    inst.setPosition((step.direction == DIR_UP) ? 0 : POSITION_FULL);
+                    inst.onHomed();
+                    Log::info("Louver", "End stop detected, stopping movement");
                 }
-                // Time check
-                if (stopFlag || (now >= inst.m_movementStartTime + inst.m_movement[index].timeMilli))
+                else if (!stopFlag && (event == MotionAnalyzer::EV_OBSTRUCTION))
                 {
-                    if (!stopFlag && (inst.m_movement.size() == 1))
+                    stopFlag = true;
+                    obstruction = true;
+                    reason = MovementStats::REASON_OBSTRUCTION;
+                    inst.onPartialMove();
+                    Log::info("Louver", "Obstruction detected, stopping movement");
+                }
+                // Time check - step timer cuts relays off, loop check is just a fallback
+                uint32_t guard = inst.m_stepTimerArmed ? STEP_TIMER_GUARD_MILLI : 0;
+                bool timeElapsed = inst.m_stepTimerFired || (now >= inst.m_movementStartTime + inst.m_movement[index].timeMilli + guard);
+                if (stopFlag || timeElapsed)
+                {
+                    MovementStats::finish(reason);
+                    PowerMeasCapture::stop();
+                    if (!stopFlag)
+                        inst.reportOvershoot(inst.m_movement[index].timeMilli);
+                    inst.disarmStepTimer();
+                    inst.m_stepTimerFired = false;
+                    inst.m_stepConditionMet = false;
+                    if (!stopFlag && inst.m_movement[index].endStop)
                     {
-                        // Check just for single direction movement
-                        if (inst.m_movement[index].direction == DIR_UP)
-                            inst.m_position = 0;
-                        else if (inst.m_movement[index].direction == DIR_DOWN)
-                            inst.m_position = 100;
+                        Direction dir = inst.m_movement[index].direction;
+                        if (dir == DIR_UP)
+                            inst.setPosition(0);
+                        else if (dir == DIR_DOWN)
+                            inst.setPosition(POSITION_FULL);
+                        // Shortened position aware moves do not bound the estimate
+                        if (inst.m_movement[index].timeMilli >= ((dir == DIR_UP) ? inst.m_timeUp : inst.m_timeDown))
+                            inst.onHomed();
+                    }
+                    else if (!stopFlag)
+                    {
+                        inst.onPartialMove();
+                    }
+                    if (obstruction && (MotionAnalyzer::getReverseMilli() > 0))
+                    {
+                        // Release the obstacle, remaining steps are dropped
+                        MovementStep reverse;
+                        reverse.direction = (step.direction == DIR_UP) ? DIR_DOWN : DIR_UP;
+                        reverse.timeMilli = MotionAnalyzer::getReverseMilli();
+                        reverse.stopCondition = PowerMeas::NO_CONDITION;
+                        reverse.endStop = false;
+                        inst.m_movement.clear();
+                        inst.m_movement.push_back(reverse);
+                        inst.m_stepIndex = -1;
+                        Mqtt::publishMovement("reverse");
                     }
                     inst.m_stepIndex++;
                     inst.m_movementStartTime = now;
@@ -648,10 +1158,6 @@ void Louver::process()
                     }
                     inst.delay(ST_MOVEMENT);
                 }
-                else if (inst.m_movement[index].checkConditions)
-                {
-
-                }
             }
             break;
         case ST_WAIT_RELEASE:
@@ -671,6 +1177,17 @@ void Louver::process()
             break;
     }
 
+    inst.updatePosition();
+    // State is persisted only when motion is finished to limit flash writes
+    if ((inst.m_relayState == RELAY_IDLE) && ((inst.m_state == ST_IDLE) || (inst.m_state == ST_WAIT_RELEASE)))
+    {
+        if (inst.m_saveStatePending)
+        {
+            inst.m_saveStatePending = false;
+            inst.saveState();
+        }
+        MovementStats::saveBaselines(now);
+    }
     if ((now - inst.m_lastPositionReportTime) > POSITION_REPORT_PERIOD_MILLI)
     {
         inst.m_lastPositionReportTime = now;
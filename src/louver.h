@@ -1,6 +1,10 @@
 #pragma once
+#include <Arduino.h>
 #include <stdint.h>
 #include <vector>
+#ifdef ESP32
+#include <esp_timer.h>
+#endif
 #include "profiles.h"
 
 class Louver
@@ -17,6 +21,11 @@ public:
     static constexpr float DEFAULT_TIME_DOWN_SECS = 30;
     static constexpr float DEFAULT_TIME_OPEN_LAMELLAS_SECS = 2;
     static constexpr float DEFAULT_TIME_SHORT_MOVEMENT_SECS = 0.25;
+    static constexpr float DEFAULT_SAFETY_OVERRUN_PERCENT = 15;
+    static constexpr uint32_t DEFAULT_REHOME_MOVES = 10;
+    static constexpr uint32_t DEFAULT_START_LAG_MILLI = 0;
+    static constexpr uint32_t DEFAULT_STOP_LAG_MILLI = 0;
+    static constexpr float DEFAULT_REHOME_TRAVEL_PERCENT = 500;
 
     enum Direction
     {
@@ -28,7 +37,10 @@ public:
     {
         Direction direction;
         uint32_t timeMilli;
-        bool checkConditions;
+        // Power measurement condition index stopping the step, PowerMeas::NO_CONDITION = none
+        uint8_t stopCondition;
+        // Step runs into end stop, position is set to 0 or 100 when finished
+        bool endStop;
     };
 
     Louver();
@@ -37,6 +49,9 @@ public:
 
     static void loadConfig();
 
+    // Restores position and counters stored before reboot
+    static void init();
+
     static void configureGpio(Direction dir, uint8_t pinKey, uint8_t pinRelay, bool keyActiveHigh = true, bool relayActiveHigh = true, bool enablePull = true);
 
     static void getGpioConfig(Direction dir, uint8_t& pinKey, uint8_t& pinRelay, bool& keyActiveHigh, bool& relayActiveHigh, bool& pullEnabled);
@@ -47,9 +62,18 @@ public:
 
     static float getShortMovementSecs();
 
-    static void configurePowerCondStop(bool upStopCond1, bool downStopCodn2);
+    // Names of power measurement conditions stopping full moves, empty = none
+    static void configurePowerCondStop(String upCondition, String downCondition);
+
+    static void getPowerCondStop(String& upCondition, String& downCondition);
+
+    static void configureFullMoves(bool positionAware, float safetyOverrunPercent, uint32_t rehomeMoves, float rehomeTravelPercent);
+
+    static void getFullMovesConfig(bool& positionAware, float& safetyOverrunPercent, uint32_t& rehomeMoves, float& rehomeTravelPercent);
 
-    static void getPowerCondStop(bool& upStopCond1, bool& downStopCodn2);
+    static void configureMotorLag(Direction dir, uint32_t startLagMilli, uint32_t stopLagMilli);
+
+    static void getMotorLag(Direction dir, uint32_t& startLagMilli, uint32_t& stopLagMilli);
 
     static void fullOpen();
 
@@ -61,8 +85,20 @@ public:
 
     static void shortClose(float timeSecs = -1);
 
+    static void moveToPosition(float percent);
+
+    static float getPosition();
+
+    static uint32_t getRelayCycles();
+
+    static uint64_t getMotorRuntimeMilli();
+
     static void stop();
 
+    static int32_t getLastOvershootMicro();
+
+    static int32_t getMaxOvershootMicro();
+
     static void process();
 
 private:
@@ -71,7 +107,22 @@ private:
     static constexpr uint64_t DEBOUNCE_HOLD_MILLI = 2000; 
     static constexpr uint32_t MOVEMENT_DELAY_MILLI = 200;
     static constexpr uint32_t POSITION_REPORT_PERIOD_MILLI = 1000;
-    static constexpr uint32_t POSITION_UPDATE_PERIOD_MILLI = 10;
+    // Position is integrated in Q16 fixed point per-mille, full scale = 100 %
+    static constexpr uint8_t POSITION_FRACTION_BITS = 16;
+    static constexpr int32_t POSITION_FULL = (int32_t)1000 << POSITION_FRACTION_BITS;
+    // Movement to end position runs longer by this part of full travel time
+    static constexpr float POSITION_END_OVERRUN_PERCENT = 10;
+    // Smaller position changes are ignored
+    static constexpr float POSITION_TOLERANCE_PERCENT = 0.5;
+    // Loop fallback margin used when step timer is armed but did not fire
+    static constexpr uint32_t STEP_TIMER_GUARD_MILLI = 20;
+
+    enum RelayState
+    {
+        RELAY_IDLE = 0,
+        RELAY_UP,
+        RELAY_DOWN
+    };
 
     enum State
     {
@@ -99,7 +150,21 @@ private:
 
     void recalculatePercents();
 
-    void updatePosition(Direction direction);
+    void updatePosition();
+
+    int32_t getTravel(RelayState relayState, uint64_t onTimeMicro, bool stopped);
+
+    void setPosition(int32_t position);
+
+    void saveState();
+
+    uint32_t getFullMoveTime(Direction direction);
+
+    void onPartialMove();
+
+    void onHomed();
+
+    uint8_t getStopCondition(Direction direction);
 
     void relaysUp();
 
@@ -109,9 +174,40 @@ private:
 
     void startMovement();
 
+    void armStepTimer(uint32_t timeMilli);
+
+    void disarmStepTimer();
+
+    void onStepTimer();
+
+    void reportOvershoot(uint32_t timeMilli);
+
+    static void stepTimerCallback(void* arg);
+
+    // Stop condition of running step cuts relays off without waiting for the loop
+    static void onPowerCondition(uint8_t conditionIndex);
+
+#ifndef ESP32
+    static void stepTimerIsr();
+#endif
+
     void delay(State nextState);
 
     float m_position;
+    int32_t m_positionFixed;
+    uint32_t m_startLagUp;
+    uint32_t m_stopLagUp;
+    uint32_t m_startLagDown;
+    uint32_t m_stopLagDown;
+    volatile RelayState m_relayState;
+    volatile uint64_t m_relayOnMicro;
+    volatile uint64_t m_segmentOnMicro;
+    volatile uint64_t m_segmentOffMicro;
+    volatile RelayState m_segmentState;
+    volatile bool m_segmentPending;
+    uint32_t m_relayCycles;
+    uint64_t m_motorRuntimeMilli;
+    bool m_saveStatePending;
     uint8_t m_pinKeyUp;
     uint8_t m_pinKeyDown;
     uint8_t m_pinRelayUp;
@@ -130,8 +226,14 @@ private:
     uint32_t m_timeDown;
     uint32_t m_timeOpenLamellas;
     uint32_t m_timeShortMovement;
-    bool m_stopUpOnPowerCond1;
-    bool m_stopDownOnPowerCond2;
+    String m_stopUpCondition;
+    String m_stopDownCondition;
+    bool m_positionAwareFullMoves;
+    float m_safetyOverrunPercent;
+    uint32_t m_rehomeMoves;
+    float m_rehomeTravelPercent;
+    uint32_t m_partialMovesSinceHome;
+    float m_travelSinceHome;
     State m_state;
     State m_nextState;
     uint8_t m_closePercent;
@@ -148,5 +250,15 @@ private:
     float m_percentPerMilliUp;
     float m_percentPerMilliDown;
     uint64_t m_lastPositionReportTime;
-    uint64_t m_lastPositionUpdateTime;
+#ifdef ESP32
+    esp_timer_handle_t m_stepTimer;
+#endif
+    volatile bool m_stepTimerArmed;
+    volatile bool m_stepTimerFired;
+    bool m_stepConditionMet;
+    volatile uint64_t m_stepCutOffMicro;
+    volatile uint32_t m_stepTimerRemainingTicks;
+    uint64_t m_stepStartMicro;
+    int32_t m_lastOvershootMicro;
+    int32_t m_maxOvershootMicro;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "profiles.h"
 #include "time.h"
 #include "http_server.h"
+#include "key_input.h"
 
 Module::Module() :
     m_name(DEFAULT_NAME),
@@ -110,6 +111,7 @@ void Module::initPins()
     if (!m_pinKeyResetPullEnabled)
         pull = 0;
     pinMode(m_pinKeyReset, INPUT | pull);
+    KeyInput::configure(KeyInput::KEY_RESET, m_pinKeyReset, m_pinKeyResetActiveHigh);
     pinMode(m_pinLed, OUTPUT);
 }
 
@@ -128,14 +130,13 @@ bool Module::isRebootRequested()
 void Module::process()
 {
     Module& inst = getInstance();
-    bool isKeyResetActive = digitalRead(inst.m_pinKeyReset) == HIGH;
-    if (!inst.m_pinKeyResetActiveHigh)
-        isKeyResetActive = !isKeyResetActive;
+    KeyInput::process();
+    bool isKeyResetActive = KeyInput::isActive(KeyInput::KEY_RESET);
     uint64_t now = Time::nowRelativeMilli();
     if ((isKeyResetActive != inst.m_lastKeyResetState) && (now >= inst.m_lastKeyResetChangeTime + 100))
     {
         inst.m_lastKeyResetState = isKeyResetActive;
-        inst.m_lastKeyResetChangeTime = now;
+        inst.m_lastKeyResetChangeTime = KeyInput::getLastChangeMilli(KeyInput::KEY_RESET);
         Log::debug("Module", "Reset key state changed, active=%d", isKeyResetActive);
     }
     if ((isKeyResetActive) && !inst.m_reboot && (now >= inst.m_lastKeyResetChangeTime + RESET_HOLD_TIME_MILLI))
@@ -151,6 +152,12 @@ void Module::process()
         delay(1000);
         ESP.restart();
     }
+}
+
+void Module::processLed()
+{
+    Module& inst = getInstance();
+    uint64_t now = Time::nowRelativeMilli();
     uint32_t blinkPeriod = 2000;
     if (HttpServer::isApMode())
         blinkPeriod = 500;
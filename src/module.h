@@ -25,6 +25,8 @@ public:
 
     static void process();
 
+    static void processLed();
+
     static void reboot();
 
     static bool isRebootRequested();
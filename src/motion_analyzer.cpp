@@ -0,0 +1,205 @@
+#include "motion_analyzer.h"
+#include <ArduinoJson.h>
+#include <math.h>
+#include "config.h"
+#include "time.h"
+#include "log.h"
+#include "mqtt.h"
+
+static const uint8_t NO_VALUE = 0xff;
+
+MotionAnalyzer::MotionAnalyzer() :
+    m_enabled(false),
+    m_valueUp("current1"),
+    m_valueDown("current2"),
+    m_inrushMilli(DEFAULT_INRUSH_MILLI),
+    m_dropRatio(DEFAULT_DROP_RATIO),
+    m_riseRatio(DEFAULT_RISE_RATIO),
+    m_minPlateau(DEFAULT_MIN_PLATEAU),
+    m_minPlateauSamples(DEFAULT_MIN_PLATEAU_SAMPLES),
+    m_reverseMilli(DEFAULT_REVERSE_MILLI),
+    m_phase(PH_IDLE),
+    m_directionUp(true),
+    m_valueIndex(NO_VALUE),
+    m_startTime(0),
+    m_plateau(0),
+    m_plateauSamples(0),
+    m_event(EV_NONE),
+    m_eventTimeMilli(0)
+{
+
+}
+
+void MotionAnalyzer::loadConfig()
+{
+    MotionAnalyzer& inst = getInstance();
+    inst.m_config = Config::getString("power_meas/motion_analyzer", "{\"enabled\":false}");
+    inst.applyConfig();
+    Log::info("MotionAnalyzer", "Configuration loaded, %s", inst.m_config.c_str());
+}
+
+String MotionAnalyzer::getConfig()
+{
+    return getInstance().m_config;
+}
+
+void MotionAnalyzer::setConfig(String config)
+{
+    MotionAnalyzer& inst = getInstance();
+    if (config == inst.m_config)
+        return;
+    inst.m_config = config;
+    inst.applyConfig();
+    Config::setString("power_meas/motion_analyzer", config);
+    Config::flush();
+    Log::info("MotionAnalyzer", "Configuration set, %s", config.c_str());
+}
+
+void MotionAnalyzer::applyConfig()
+{
+    DynamicJsonDocument json(512);
+    DeserializationError error = deserializeJson(json, m_config);
+    if (error)
+    {
+        Log::error("MotionAnalyzer", "Error while parsing config JSON: %s", error.c_str());
+        m_enabled = false;
+        return;
+    }
+    m_enabled = json["enabled"] | false;
+    m_valueUp = json["value_up"] | "current1";
+    m_valueDown = json["value_down"] | "current2";
+    m_inrushMilli = json["inrush_milli"] | (uint32_t)DEFAULT_INRUSH_MILLI;
+    m_dropRatio = json["drop_ratio"] | (float)DEFAULT_DROP_RATIO;
+    m_riseRatio = json["rise_ratio"] | (float)DEFAULT_RISE_RATIO;
+    m_minPlateau = json["min_plateau"] | (float)DEFAULT_MIN_PLATEAU;
+    m_minPlateauSamples = json["min_plateau_samples"] | (uint8_t)DEFAULT_MIN_PLATEAU_SAMPLES;
+    m_reverseMilli = json["reverse_milli"] | (uint32_t)DEFAULT_REVERSE_MILLI;
+    if (m_minPlateauSamples < 1)
+        m_minPlateauSamples = 1;
+}
+
+bool MotionAnalyzer::isEnabled()
+{
+    return getInstance().m_enabled;
+}
+
+uint32_t MotionAnalyzer::getReverseMilli()
+{
+    return getInstance().m_reverseMilli;
+}
+
+void MotionAnalyzer::start(bool directionUp)
+{
+    MotionAnalyzer& inst = getInstance();
+    if (!inst.m_enabled)
+        return;
+    inst.m_directionUp = directionUp;
+    inst.m_valueIndex = NO_VALUE;
+    inst.m_startTime = Time::nowRelativeMilli();
+    inst.m_plateau = 0;
+    inst.m_plateauSamples = 0;
+    inst.m_event = EV_NONE;
+    inst.m_phase = PH_INRUSH;
+}
+
+void MotionAnalyzer::stop()
+{
+    MotionAnalyzer& inst = getInstance();
+    inst.m_phase = PH_IDLE;
+    inst.m_event = EV_NONE;
+}
+
+uint8_t MotionAnalyzer::findValue(const PowerMeasDevice& device, const String& name)
+{
+    for(uint8_t i = 0; i < device.getDescriptorCount(); i++)
+    {
+        if (strcmp_P(name.c_str(), (PGM_P)device.getMqttTopic(i)) == 0)
+            return i;
+    }
+    return NO_VALUE;
+}
+
+void MotionAnalyzer::onSample(const PowerMeasDevice& device, uint64_t now)
+{
+    MotionAnalyzer& inst = getInstance();
+    if ((inst.m_phase == PH_IDLE) || (inst.m_phase == PH_DONE))
+        return;
+    if (inst.m_valueIndex == NO_VALUE)
+    {
+        inst.m_valueIndex = inst.findValue(device, inst.m_directionUp ? inst.m_valueUp : inst.m_valueDown);
+        if (inst.m_valueIndex == NO_VALUE)
+        {
+            Log::error("MotionAnalyzer", "Value %s not found", (inst.m_directionUp ? inst.m_valueUp : inst.m_valueDown).c_str());
+            inst.m_phase = PH_DONE;
+            return;
+        }
+    }
+    float value = device.getLastValue(inst.m_valueIndex);
+    if (isnan(value))
+        return;
+    if (inst.m_phase == PH_INRUSH)
+    {
+        // Starting current is much higher than plateau, it is ignored
+        if (now < inst.m_startTime + inst.m_inrushMilli)
+            return;
+        inst.m_phase = PH_PLATEAU;
+    }
+    if (inst.m_plateauSamples >= inst.m_minPlateauSamples)
+    {
+        if (inst.m_plateau >= inst.m_minPlateau)
+        {
+            if (value < inst.m_plateau * inst.m_dropRatio)
+            {
+                inst.report(EV_END_STOP, now, value);
+                return;
+            }
+            if (value > inst.m_plateau * inst.m_riseRatio)
+            {
+                inst.report(EV_OBSTRUCTION, now, value);
+                return;
+            }
+        }
+        inst.m_plateau += PLATEAU_ALPHA * (value - inst.m_plateau);
+    }
+    else
+    {
+        // Plain average of first plateau samples
+        inst.m_plateau = (inst.m_plateau * inst.m_plateauSamples + value) / (inst.m_plateauSamples + 1);
+        inst.m_plateauSamples++;
+    }
+}
+
+void MotionAnalyzer::report(Event event, uint64_t now, float value)
+{
+    m_event = event;
+    m_eventTimeMilli = (uint32_t)(now - m_startTime);
+    m_phase = PH_DONE;
+    Log::info("MotionAnalyzer", "%s detected after %d ms, value=%f, plateau=%f", eventToString(event), m_eventTimeMilli, value, m_plateau);
+    Mqtt::queueMovementEvent(eventToString(event), m_eventTimeMilli, value, m_plateau);
+}
+
+MotionAnalyzer::Event MotionAnalyzer::takeEvent()
+{
+    MotionAnalyzer& inst = getInstance();
+    Event event = inst.m_event;
+    inst.m_event = EV_NONE;
+    return event;
+}
+
+uint32_t MotionAnalyzer::getEventTimeMilli()
+{
+    return getInstance().m_eventTimeMilli;
+}
+
+const char* MotionAnalyzer::eventToString(Event event)
+{
+    switch(event)
+    {
+        case EV_END_STOP:
+            return "end_stop";
+        case EV_OBSTRUCTION:
+            return "obstruction";
+        default:
+            return "none";
+    }
+}
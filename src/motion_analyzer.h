@@ -0,0 +1,97 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include "power_meas_device.h"
+
+// Watches motor current (or power) of running movement step. After inrush the
+// plateau level is tracked, sudden drop means end stop, sudden rise obstruction.
+class MotionAnalyzer
+{
+public:
+
+    enum Event
+    {
+        EV_NONE = 0,
+        EV_END_STOP,
+        EV_OBSTRUCTION
+    };
+
+    static constexpr uint32_t DEFAULT_INRUSH_MILLI = 700;
+    static constexpr float DEFAULT_DROP_RATIO = 0.3;
+    static constexpr float DEFAULT_RISE_RATIO = 1.6;
+    static constexpr float DEFAULT_MIN_PLATEAU = 0.05;
+    static constexpr uint8_t DEFAULT_MIN_PLATEAU_SAMPLES = 3;
+    static constexpr uint32_t DEFAULT_REVERSE_MILLI = 0;
+
+    static void loadConfig();
+
+    static String getConfig();
+
+    static void setConfig(String config);
+
+    static bool isEnabled();
+
+    // Time of reverse movement after obstruction, 0 = stop only
+    static uint32_t getReverseMilli();
+
+    // Called by Louver when relays of a step are switched on and off
+    static void start(bool directionUp);
+
+    static void stop();
+
+    // Called by PowerMeas for every new sample of the active device, now is sample time
+    static void onSample(const PowerMeasDevice& device, uint64_t now);
+
+    // Returns detected event once, EV_NONE when nothing happened
+    static Event takeEvent();
+
+    static uint32_t getEventTimeMilli();
+
+    static const char* eventToString(Event event);
+
+private:
+
+    enum Phase
+    {
+        PH_IDLE = 0,
+        PH_INRUSH,
+        PH_PLATEAU,
+        PH_DONE
+    };
+
+    // Weight of new sample in plateau level
+    static constexpr float PLATEAU_ALPHA = 0.2;
+
+    MotionAnalyzer();
+
+    static inline MotionAnalyzer& getInstance()
+    {
+        static MotionAnalyzer analyzer;
+        return analyzer;
+    }
+
+    void applyConfig();
+
+    uint8_t findValue(const PowerMeasDevice& device, const String& name);
+
+    void report(Event event, uint64_t now, float value);
+
+    String m_config;
+    bool m_enabled;
+    String m_valueUp;
+    String m_valueDown;
+    uint32_t m_inrushMilli;
+    float m_dropRatio;
+    float m_riseRatio;
+    float m_minPlateau;
+    uint8_t m_minPlateauSamples;
+    uint32_t m_reverseMilli;
+    Phase m_phase;
+    bool m_directionUp;
+    uint8_t m_valueIndex;
+    uint64_t m_startTime;
+    float m_plateau;
+    uint8_t m_plateauSamples;
+    Event m_event;
+    uint32_t m_eventTimeMilli;
+};
@@ -0,0 +1,300 @@
+#include "movement_stats.h"
+#include <ArduinoJson.h>
+#include <math.h>
+#include "config.h"
+#include "time.h"
+#include "log.h"
+#include "mqtt.h"
+
+// Baseline is used for deviation check after this number of full moves
+static const uint32_t BASELINE_MIN_COUNT = 3;
+
+MovementStats::MovementStats() :
+    m_currentUp("current1"),
+    m_currentDown("current2"),
+    m_powerUp("power1"),
+    m_powerDown("power2"),
+    m_deviationPercent(DEFAULT_DEVIATION_PERCENT),
+    m_running(false),
+    m_resolved(false),
+    m_currentIndex(NO_VALUE),
+    m_powerIndex(NO_VALUE),
+    m_startTime(0),
+    m_lastSampleTime(0),
+    m_lastPower(0),
+    m_lastCurrent(NAN),
+    m_currentSum(0),
+    m_currentTime(0),
+    m_sampleCount(0),
+    m_recordHead(0),
+    m_recordCount(0),
+    m_baselinesChanged(false),
+    m_lastBaselineSave(0)
+{
+    memset(&m_current, 0, sizeof(m_current));
+    memset(m_baselines, 0, sizeof(m_baselines));
+}
+
+void MovementStats::loadConfig()
+{
+    MovementStats& inst = getInstance();
+    inst.m_config = Config::getString("power_meas/movement_stats", "{}");
+    inst.applyConfig();
+    inst.m_baselines[0].energyWh = Config::getFloat("power_meas/baseline_up", 0);
+    inst.m_baselines[0].count = (uint32_t)Config::getInt("power_meas/baseline_up_count", 0);
+    inst.m_baselines[1].energyWh = Config::getFloat("power_meas/baseline_down", 0);
+    inst.m_baselines[1].count = (uint32_t)Config::getInt("power_meas/baseline_down_count", 0);
+    Log::info("MovementStats", "Configuration loaded, %s, baseline up=%f Wh, down=%f Wh", inst.m_config.c_str(), inst.m_baselines[0].energyWh, inst.m_baselines[1].energyWh);
+}
+
+String MovementStats::getConfig()
+{
+    return getInstance().m_config;
+}
+
+void MovementStats::setConfig(String config)
+{
+    MovementStats& inst = getInstance();
+    if (config == inst.m_config)
+        return;
+    inst.m_config = config;
+    inst.applyConfig();
+    Config::setString("power_meas/movement_stats", config);
+    Config::flush();
+    Log::info("MovementStats", "Configuration set, %s", config.c_str());
+}
+
+void MovementStats::applyConfig()
+{
+    DynamicJsonDocument json(512);
+    DeserializationError error = deserializeJson(json, m_config);
+    if (error)
+    {
+        Log::error("MovementStats", "Error while parsing config JSON: %s", error.c_str());
+        return;
+    }
+    m_currentUp = json["current_up"] | "current1";
+    m_currentDown = json["current_down"] | "current2";
+    m_powerUp = json["power_up"] | "power1";
+    m_powerDown = json["power_down"] | "power2";
+    m_deviationPercent = json["deviation_percent"] | (float)DEFAULT_DEVIATION_PERCENT;
+}
+
+void MovementStats::resetBaselines()
+{
+    MovementStats& inst = getInstance();
+    memset(inst.m_baselines, 0, sizeof(inst.m_baselines));
+    inst.m_baselinesChanged = false;
+    Config::remove("power_meas/baseline_up");
+    Config::remove("power_meas/baseline_up_count");
+    Config::remove("power_meas/baseline_down");
+    Config::remove("power_meas/baseline_down_count");
+    Config::flush();
+    Log::info("MovementStats", "Baselines reset");
+}
+
+void MovementStats::saveBaselines(uint64_t now)
+{
+    MovementStats& inst = getInstance();
+    if (!inst.m_baselinesChanged || (now < inst.m_lastBaselineSave + BASELINE_SAVE_PERIOD_MILLI))
+        return;
+    inst.m_baselinesChanged = false;
+    inst.m_lastBaselineSave = now;
+    Config::setFloat("power_meas/baseline_up", inst.m_baselines[0].energyWh);
+    Config::setInt("power_meas/baseline_up_count", inst.m_baselines[0].count);
+    Config::setFloat("power_meas/baseline_down", inst.m_baselines[1].energyWh);
+    Config::setInt("power_meas/baseline_down_count", inst.m_baselines[1].count);
+    Config::flush();
+    Log::info("MovementStats", "Baselines saved");
+}
+
+uint8_t MovementStats::findValue(const PowerMeasDevice& device, const String& name)
+{
+    for(uint8_t i = 0; i < device.getDescriptorCount(); i++)
+    {
+        if (strcmp_P(name.c_str(), (PGM_P)device.getMqttTopic(i)) == 0)
+            return i;
+    }
+    return NO_VALUE;
+}
+
+void MovementStats::start(bool directionUp, bool fullMove)
+{
+    MovementStats& inst = getInstance();
+    uint64_t now = Time::nowRelativeMilli();
+    memset(&inst.m_current, 0, sizeof(inst.m_current));
+    inst.m_current.startTime = (uint32_t)now;
+    inst.m_current.directionUp = directionUp;
+    inst.m_current.fullMove = fullMove;
+    inst.m_running = true;
+    inst.m_resolved = false;
+    inst.m_startTime = now;
+    inst.m_lastSampleTime = now;
+    inst.m_lastPower = 0;
+    inst.m_lastCurrent = NAN;
+    inst.m_currentSum = 0;
+    inst.m_currentTime = 0;
+    inst.m_sampleCount = 0;
+}
+
+void MovementStats::onSample(const PowerMeasDevice& device, uint64_t now)
+{
+    MovementStats& inst = getInstance();
+    // Reading requested before relays were switched on
+    if (!inst.m_running || (now < inst.m_lastSampleTime))
+        return;
+    if (!inst.m_resolved)
+    {
+        bool up = inst.m_current.directionUp;
+        inst.m_currentIndex = findValue(device, up ? inst.m_currentUp : inst.m_currentDown);
+        inst.m_powerIndex = findValue(device, up ? inst.m_powerUp : inst.m_powerDown);
+        inst.m_resolved = true;
+    }
+    // Energy and current integrated from previous sample over the elapsed time
+    uint32_t elapsed = (uint32_t)(now - inst.m_lastSampleTime);
+    inst.m_current.energyWh += inst.m_lastPower * (float)elapsed / 3600000.0f;
+    if (!isnan(inst.m_lastCurrent))
+    {
+        inst.m_currentSum += inst.m_lastCurrent * elapsed;
+        inst.m_currentTime += elapsed;
+    }
+    inst.m_lastSampleTime = now;
+    if (inst.m_powerIndex != NO_VALUE)
+    {
+        float power = device.getLastValue(inst.m_powerIndex);
+        inst.m_lastPower = isnan(power) ? 0 : power;
+    }
+    if (inst.m_currentIndex != NO_VALUE)
+    {
+        float current = device.getLastValue(inst.m_currentIndex);
+        inst.m_lastCurrent = current;
+        if (!isnan(current))
+        {
+            if (current > inst.m_current.peakCurrent)
+                inst.m_current.peakCurrent = current;
+            inst.m_sampleCount++;
+        }
+    }
+}
+
+void MovementStats::finish(StopReason reason)
+{
+    MovementStats& inst = getInstance();
+    if (!inst.m_running)
+        return;
+    inst.m_running = false;
+    uint64_t now = Time::nowRelativeMilli();
+    Record& record = inst.m_current;
+    uint32_t elapsed = (uint32_t)(now - inst.m_lastSampleTime);
+    record.energyWh += inst.m_lastPower * (float)elapsed / 3600000.0f;
+    if (!isnan(inst.m_lastCurrent))
+    {
+        inst.m_currentSum += inst.m_lastCurrent * elapsed;
+        inst.m_currentTime += elapsed;
+    }
+    record.durationMilli = (uint32_t)(now - inst.m_startTime);
+    record.reason = reason;
+    if ((reason == REASON_END_STOP) || (reason == REASON_CONDITION))
+        record.endStopMilli = record.durationMilli;
+    if (inst.m_currentTime > 0)
+        record.meanCurrent = inst.m_currentSum / inst.m_currentTime;
+    else if (inst.m_sampleCount > 0)
+        record.meanCurrent = inst.m_current.peakCurrent;
+    // Only complete full travels are comparable
+    Baseline& baseline = inst.m_baselines[record.directionUp ? 0 : 1];
+    if (record.fullMove && (reason != REASON_INTERRUPTED) && (reason != REASON_OBSTRUCTION) && (inst.m_sampleCount > 0))
+    {
+        if ((baseline.count >= BASELINE_MIN_COUNT) && (baseline.energyWh > 0))
+        {
+            record.deviationPercent = (record.energyWh - baseline.energyWh) * 100 / baseline.energyWh;
+            record.deviation = (fabsf(record.deviationPercent) > inst.m_deviationPercent);
+        }
+        if (baseline.count == 0)
+            baseline.energyWh = record.energyWh;
+        else
+            baseline.energyWh += BASELINE_ALPHA * (record.energyWh - baseline.energyWh);
+        baseline.count++;
+        inst.m_baselinesChanged = true;
+    }
+    inst.m_records[inst.m_recordHead] = record;
+    inst.m_recordHead = (inst.m_recordHead + 1) % MAX_RECORDS;
+    if (inst.m_recordCount < MAX_RECORDS)
+        inst.m_recordCount++;
+    if (record.deviation)
+        Log::warning("MovementStats", "Movement energy %f Wh differs from baseline by %f %%", record.energyWh, record.deviationPercent);
+    Log::info("MovementStats", "Movement finished, %s, %d ms, %f Wh", reasonToString(reason), record.durationMilli, record.energyWh);
+    Mqtt::publishMovementRecord(recordToJSON(record).c_str());
+}
+
+uint8_t MovementStats::getRecordCount()
+{
+    return getInstance().m_recordCount;
+}
+
+const MovementStats::Record& MovementStats::getRecord(uint8_t index)
+{
+    MovementStats& inst = getInstance();
+    return inst.m_records[(inst.m_recordHead + MAX_RECORDS - 1 - (index % MAX_RECORDS)) % MAX_RECORDS];
+}
+
+float MovementStats::getBaselineWh(bool directionUp)
+{
+    return getInstance().m_baselines[directionUp ? 0 : 1].energyWh;
+}
+
+String MovementStats::recordToJSON(const Record& record)
+{
+    char buffer[320];
+    snprintf(buffer, sizeof(buffer),
+        "{\"direction\":\"%s\",\"full\":%s,\"reason\":\"%s\",\"duration_milli\":%u,\"end_stop_milli\":%u,"
+        "\"energy_wh\":%.4f,\"peak_current\":%.3f,\"mean_current\":%.3f,\"deviation_percent\":%.1f,\"deviation\":%s}",
+        record.directionUp ? "up" : "down",
+        record.fullMove ? "true" : "false",
+        reasonToString(record.reason),
+        record.durationMilli,
+        record.endStopMilli,
+        record.energyWh,
+        record.peakCurrent,
+        record.meanCurrent,
+        record.deviationPercent,
+        record.deviation ? "true" : "false");
+    return String(buffer);
+}
+
+String MovementStats::exportToJSON()
+{
+    MovementStats& inst = getInstance();
+    String result;
+    result.reserve(96 + inst.m_recordCount * 240);
+    result += "{\"baseline_up_wh\":";
+    result += String(inst.m_baselines[0].energyWh, 4);
+    result += ",\"baseline_down_wh\":";
+    result += String(inst.m_baselines[1].energyWh, 4);
+    result += ",\"records\":[";
+    for(uint8_t i = 0; i < inst.m_recordCount; i++)
+    {
+        if (i > 0)
+            result += ",";
+        result += recordToJSON(getRecord(i));
+    }
+    result += "]}";
+    return result;
+}
+
+const char* MovementStats::reasonToString(StopReason reason)
+{
+    switch(reason)
+    {
+        case REASON_TIME:
+            return "time";
+        case REASON_CONDITION:
+            return "condition";
+        case REASON_END_STOP:
+            return "end_stop";
+        case REASON_OBSTRUCTION:
+            return "obstruction";
+        case REASON_INTERRUPTED:
+            return "interrupted";
+    }
+    return "time";
+}
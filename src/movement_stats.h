@@ -0,0 +1,131 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include "power_meas_device.h"
+
+// Energy and current statistics of movement steps computed from samples of the
+// active power measurement device, with rolling baseline per direction
+class MovementStats
+{
+public:
+
+    enum StopReason
+    {
+        REASON_TIME = 0,
+        REASON_CONDITION,
+        REASON_END_STOP,
+        REASON_OBSTRUCTION,
+        REASON_INTERRUPTED
+    };
+
+    struct Record
+    {
+        uint32_t startTime;
+        uint32_t durationMilli;
+        // Time until end stop was detected, 0 = not detected
+        uint32_t endStopMilli;
+        float energyWh;
+        float peakCurrent;
+        float meanCurrent;
+        // Energy difference from baseline in percents
+        float deviationPercent;
+        bool directionUp;
+        bool fullMove;
+        bool deviation;
+        StopReason reason;
+    };
+
+#ifdef ESP32
+    static constexpr uint8_t MAX_RECORDS = 16;
+#else
+    static constexpr uint8_t MAX_RECORDS = 8;
+#endif
+    static constexpr float DEFAULT_DEVIATION_PERCENT = 15;
+
+    static void loadConfig();
+
+    static String getConfig();
+
+    static void setConfig(String config);
+
+    // Called by Louver when relays of a step are switched on
+    static void start(bool directionUp, bool fullMove);
+
+    // Closes running record, ignored when no step is running
+    static void finish(StopReason reason);
+
+    // Called by PowerMeas for every new sample of the active device, now is sample time
+    static void onSample(const PowerMeasDevice& device, uint64_t now);
+
+    // Records from the newest one
+    static uint8_t getRecordCount();
+
+    static const Record& getRecord(uint8_t index);
+
+    static float getBaselineWh(bool directionUp);
+
+    // Clears learned baselines in RAM and flash
+    static void resetBaselines();
+
+    // Called by Louver when motor is idle, changed baselines are written with
+    // limited rate to save flash
+    static void saveBaselines(uint64_t now);
+
+    static String exportToJSON();
+
+    static String recordToJSON(const Record& record);
+
+    static const char* reasonToString(StopReason reason);
+
+private:
+
+    static constexpr uint8_t NO_VALUE = 0xff;
+    // Weight of new full move in baseline
+    static constexpr float BASELINE_ALPHA = 0.1;
+    static constexpr uint32_t BASELINE_SAVE_PERIOD_MILLI = 10 * 60 * 1000;
+
+    struct Baseline
+    {
+        float energyWh;
+        uint32_t count;
+    };
+
+    MovementStats();
+
+    static inline MovementStats& getInstance()
+    {
+        static MovementStats stats;
+        return stats;
+    }
+
+    void applyConfig();
+
+    static uint8_t findValue(const PowerMeasDevice& device, const String& name);
+
+    String m_config;
+    String m_currentUp;
+    String m_currentDown;
+    String m_powerUp;
+    String m_powerDown;
+    float m_deviationPercent;
+    bool m_running;
+    bool m_resolved;
+    uint8_t m_currentIndex;
+    uint8_t m_powerIndex;
+    uint64_t m_startTime;
+    uint64_t m_lastSampleTime;
+    float m_lastPower;
+    // Current is integrated over time like power, fast capture samples must
+    // not outweigh regular ones
+    float m_lastCurrent;
+    float m_currentSum;
+    uint32_t m_currentTime;
+    uint32_t m_sampleCount;
+    Record m_current;
+    Record m_records[MAX_RECORDS];
+    uint8_t m_recordHead;
+    uint8_t m_recordCount;
+    Baseline m_baselines[2];
+    bool m_baselinesChanged;
+    uint64_t m_lastBaselineSave;
+};
@@ -4,6 +4,8 @@
 #include "log.h"
 #include "louver.h"
 #include "power_meas.h"
+#include "movement_stats.h"
+#include "scheduler.h"
 
 Mqtt::Mqtt() :
     m_client(m_wifiClient),
@@ -14,8 +16,12 @@ Mqtt::Mqtt() :
     m_user(""),
     m_password(""),
     m_powerPublishPeriod(DEFAULT_POWER_PUBLISH_PERIOD_MILLI),
+    m_metricsPublishPeriod(DEFAULT_METRICS_PUBLISH_PERIOD_MILLI),
     m_lastReconnectTime(0),
-    m_lastPowerPublishTime(0)
+    m_lastPowerPublishTime(0),
+    m_lastMetricsPublishTime(0),
+    m_eventHead(0),
+    m_eventCount(0)
 {
 
 }
@@ -30,6 +36,7 @@ void Mqtt::loadConfig()
     inst.m_user = Config::getString("mqtt/user", "");
     inst.m_password = Config::getString("mqtt/password", "");
     inst.m_powerPublishPeriod = (uint32_t)Config::getInt("mqtt/power_period", DEFAULT_POWER_PUBLISH_PERIOD_MILLI);
+    inst.m_metricsPublishPeriod = (uint32_t)Config::getInt("mqtt/metrics_period", DEFAULT_METRICS_PUBLISH_PERIOD_MILLI);
     Log::info("MQTT", "Configuration loaded, broker=%s:%d, client ID=\"%s\", user=\"%s\"", inst.m_brokerIp.c_str(), inst.m_brokerPort, inst.m_clientId.c_str(), inst.m_user.c_str());
 }
 
@@ -123,6 +130,21 @@ uint32_t Mqtt::getPowerPublishPeriod()
     return getInstance().m_powerPublishPeriod;
 }
 
+void Mqtt::setMetricsPublishPeriod(uint32_t periodMilli)
+{
+    if ((periodMilli != 0) && (periodMilli < 1000))
+        periodMilli = 1000;
+    Log::info("MQTT", "Metrics publish period set to %dms", periodMilli);
+    Config::setInt("mqtt/metrics_period", periodMilli);
+    Config::flush();
+    getInstance().m_metricsPublishPeriod = periodMilli;
+}
+
+uint32_t Mqtt::getMetricsPublishPeriod()
+{
+    return getInstance().m_metricsPublishPeriod;
+}
+
 void Mqtt::reconnect()
 {
     IPAddress ip;
@@ -141,6 +163,10 @@ void Mqtt::reconnect()
         String topic;
         topic = m_clientId + "/movement";
         m_client.subscribe(topic.c_str());
+        topic = m_clientId + "/movement/position/set";
+        m_client.subscribe(topic.c_str());
+        topic = m_clientId + "/movement/baseline/reset";
+        m_client.subscribe(topic.c_str());
     }
 }
 
@@ -188,6 +214,18 @@ void Mqtt::mqttCallback(char* topic, byte* message, unsigned int length)
             Louver::stop();
         }
     }
+    requiredTopic = inst.m_clientId + "/movement/position/set";
+    if (String(topic) == requiredTopic)
+    {
+        Log::info("MQTT", "Movement to position %s %% requested", messageStr.c_str());
+        Louver::moveToPosition(messageStr.toFloat());
+    }
+    requiredTopic = inst.m_clientId + "/movement/baseline/reset";
+    if (String(topic) == requiredTopic)
+    {
+        Log::info("MQTT", "Movement energy baseline reset requested");
+        MovementStats::resetBaselines();
+    }
 }
 
 void Mqtt::publishMovement(const char* value)
@@ -220,6 +258,58 @@ void Mqtt::publishPosition(uint8_t position)
     }
 }
 
+void Mqtt::publishOvershoot(int32_t overshootMicro)
+{
+    Mqtt& inst = getInstance();
+    if (inst.m_enabled && inst.m_client.connected())
+    {
+        String topic = inst.m_clientId + "/movement/overshoot";
+        inst.m_client.publish(topic.c_str(), String(overshootMicro).c_str());
+    }
+}
+
+void Mqtt::queueMovementEvent(const char* event, uint32_t timeMilli, float value, float plateau)
+{
+    Mqtt& inst = getInstance();
+    if (!inst.m_enabled)
+        return;
+    if (inst.m_eventCount >= EVENT_QUEUE_SIZE)
+    {
+        Log::error("MQTT", "Movement event queue full, %s dropped", event);
+        return;
+    }
+    MovementEvent& item = inst.m_events[(inst.m_eventHead + inst.m_eventCount) % EVENT_QUEUE_SIZE];
+    item.event = event;
+    item.timeMilli = timeMilli;
+    item.value = value;
+    item.plateau = plateau;
+    inst.m_eventCount++;
+}
+
+void Mqtt::publishMovementEvents()
+{
+    String topic = m_clientId + "/movement/event";
+    while ((m_eventCount > 0) && m_client.connected())
+    {
+        const MovementEvent& item = m_events[m_eventHead];
+        char payload[128];
+        snprintf(payload, sizeof(payload), "{\"event\":\"%s\",\"time_milli\":%u,\"value\":%.3f,\"plateau\":%.3f}", item.event, item.timeMilli, item.value, item.plateau);
+        m_client.publish(topic.c_str(), payload);
+        m_eventHead = (m_eventHead + 1) % EVENT_QUEUE_SIZE;
+        m_eventCount--;
+    }
+}
+
+void Mqtt::publishMovementRecord(const char* record)
+{
+    Mqtt& inst = getInstance();
+    if (inst.m_enabled && inst.m_client.connected())
+    {
+        String topic = inst.m_clientId + "/movement/record";
+        inst.m_client.publish(topic.c_str(), record);
+    }
+}
+
 void Mqtt::process()
 {
     Mqtt& inst = getInstance();
@@ -233,30 +323,48 @@ void Mqtt::process()
             Log::info("MQTT", "Trying to reconnect");
             inst.reconnect();
         }
-        if ((PowerMeas::getActiveDeviceType() != PowerMeas::DEV_NONE) && 
+        if (inst.m_eventCount > 0)
+            inst.publishMovementEvents();
+        if ((PowerMeas::getValueCount() > 0) && 
             inst.m_client.connected() && 
             (now >= inst.m_lastPowerPublishTime + inst.m_powerPublishPeriod))
         {
             inst.m_lastPowerPublishTime = now;
             Log::debug("MQTT", "Publishing power measurement data");
-            ::std::vector<PowerMeasDevice::ValueDescriptor> descriptors = PowerMeas::getActiveDescriptors();
+            // Values of all enabled devices, extra device values are named with device prefix
+            uint8_t count = PowerMeas::getValueCount();
             String topic = inst.m_clientId + "/power_meas/count";
-            inst.m_client.publish(topic.c_str(), String(descriptors.size()).c_str());
-            for(size_t i = 0; i < descriptors.size(); i++)
+            inst.m_client.publish(topic.c_str(), String(count).c_str());
+            for(uint8_t i = 0; i < count; i++)
             {
-                if (descriptors[i].mqttPublish)
+                uint8_t index = 0;
+                const PowerMeasDevice* device = PowerMeas::getValueDevice(i, index);
+                if ((device != nullptr) && device->isMqttPublished(index))
                 {
-                    topic = inst.m_clientId + "/power_meas/" + descriptors[i].mqttTopic;
-                    inst.m_client.publish(topic.c_str(), String(descriptors[i].lastValue).c_str());
+                    String name = PowerMeas::getValueName(i);
+                    topic = inst.m_clientId + "/power_meas/" + name;
+                    inst.m_client.publish(topic.c_str(), String(device->getLastValue(index)).c_str());
                     topic = inst.m_clientId + "/power_meas/" + String(i);
-                    String value = "{ \"description\":\"" + descriptors[i].description + "\"," +
-                        "\"mqtt\":\"" + descriptors[i].mqttTopic + "\"," +
-                        "\"unit\":\"" + descriptors[i].unit + "\","+
-                        "\"format\":\"" + descriptors[i].valueFormat + "\","+
-                        "\"value\":" + descriptors[i].lastValue + "}";
+                    String value = String("{ \"description\":\"") + device->getDescription(index) + "\"," +
+                        "\"mqtt\":\"" + name + "\"," +
+                        "\"unit\":\"" + device->getUnit(index) + "\","+
+                        "\"format\":\"" + device->getValueFormat(index) + "\","+
+                        "\"value\":" + device->getLastValue(index) + "}";
                     inst.m_client.publish(topic.c_str(), value.c_str());
                 }
             }
         }
+        if ((inst.m_metricsPublishPeriod != 0) &&
+            inst.m_client.connected() && 
+            (now >= inst.m_lastMetricsPublishTime + inst.m_metricsPublishPeriod))
+        {
+            inst.m_lastMetricsPublishTime = now;
+            Log::debug("MQTT", "Publishing loop timing metrics");
+            for(uint8_t i = 0; i < Scheduler::getTaskCount(); i++)
+            {
+                String topic = inst.m_clientId + "/metrics/" + Scheduler::getTaskName(i);
+                inst.m_client.publish(topic.c_str(), Scheduler::exportMetricsToJSON(i).c_str());
+            }
+        }
     }
 }
@@ -18,6 +18,9 @@ public:
 
     static constexpr uint32_t DEFAULT_POWER_PUBLISH_PERIOD_MILLI = 2000;
 
+    // 0 = loop timing metrics are not published
+    static constexpr uint32_t DEFAULT_METRICS_PUBLISH_PERIOD_MILLI = 0;
+
     static void loadConfig();
 
     static bool getEnabled();
@@ -46,17 +49,38 @@ public:
 
     static uint32_t getPowerPublishPeriod();
 
+    static void setMetricsPublishPeriod(uint32_t periodMilli);
+
+    static uint32_t getMetricsPublishPeriod();
+
     static void publishMovement(const char* value);
 
     static void publishKey(const char* key, const char* value);
 
     static void publishPosition(uint8_t position);
 
+    static void publishOvershoot(int32_t overshootMicro);
+
+    // Event is detected in sample processing, it is published later from process()
+    static void queueMovementEvent(const char* event, uint32_t timeMilli, float value, float plateau);
+
+    static void publishMovementRecord(const char* record);
+
     static void process();
 
 private:
 
     static constexpr uint32_t RECONNECT_PERIOD_MILLI = (30 * 1000);
+    static constexpr uint8_t EVENT_QUEUE_SIZE = 4;
+
+    struct MovementEvent
+    {
+        // Static string of MotionAnalyzer
+        const char* event;
+        uint32_t timeMilli;
+        float value;
+        float plateau;
+    };
 
     Mqtt();
 
@@ -70,6 +94,8 @@ private:
 
     static void mqttCallback(char* topic, byte* message, unsigned int length);
 
+    void publishMovementEvents();
+
     WiFiClient m_wifiClient;
     PubSubClient m_client;
     bool m_enabled;
@@ -79,6 +105,11 @@ private:
     String m_user;
     String m_password;
     uint32_t m_powerPublishPeriod;
+    uint32_t m_metricsPublishPeriod;
     uint64_t m_lastReconnectTime;
     uint64_t m_lastPowerPublishTime;
+    uint64_t m_lastMetricsPublishTime;
+    MovementEvent m_events[EVENT_QUEUE_SIZE];
+    uint8_t m_eventHead;
+    uint8_t m_eventCount;
 };
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "position_store.h"
+#include <LittleFS.h>
+#include "log.h"
+
+#ifdef ESP32
+// Survives software reset, content is random after power on (checked by CRC)
+RTC_NOINIT_ATTR static uint8_t s_rtcRecord[32];
+#endif
+
+PositionStore::PositionStore() :
+    m_fsMounted(false),
+    m_sequence(0),
+    m_journalFile(JOURNAL_FILE_A),
+    m_journalRecords(0)
+{
+    static_assert(sizeof(Record) <= sizeof(uint32_t) * 8, "Record does not fit RTC area");
+#ifdef ESP32
+    m_fsMounted = LittleFS.begin(true);
+#else
+    m_fsMounted = LittleFS.begin();
+#endif
+    if (!m_fsMounted)
+        Log::error("PositionStore", "Unable to mount file system, position kept in RTC memory only");
+}
+
+uint32_t PositionStore::calculateCrc(const Record& record)
+{
+    // CRC32 of everything except crc field
+    const uint8_t* data = (const uint8_t*)&record;
+    size_t length = offsetof(Record, crc);
+    uint32_t crc = 0xffffffff;
+    for(size_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+        for(uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+bool PositionStore::isValid(const Record& record)
+{
+    return (record.magic == RECORD_MAGIC) && (record.crc == calculateCrc(record));
+}
+
+bool PositionStore::readRtc(Record& record)
+{
+#ifdef ESP32
+    memcpy(&record, s_rtcRecord, sizeof(record));
+#else
+    if (!ESP.rtcUserMemoryRead(RTC_OFFSET_BLOCKS, (uint32_t*)&record, sizeof(record)))
+        return false;
+#endif
+    return isValid(record);
+}
+
+void PositionStore::writeRtc(const Record& record)
+{
+#ifdef ESP32
+    memcpy(s_rtcRecord, &record, sizeof(record));
+#else
+    ESP.rtcUserMemoryWrite(RTC_OFFSET_BLOCKS, (uint32_t*)&record, sizeof(record));
+#endif
+}
+
+bool PositionStore::readJournal(const char* fileName, Record& record, uint32_t& recordCount)
+{
+    recordCount = 0;
+    if (!LittleFS.exists(fileName))
+        return false;
+    File file = LittleFS.open(fileName, "r");
+    if (!file)
+        return false;
+    recordCount = file.size() / sizeof(Record);
+    bool result = false;
+    // Only the last record is read, torn write at the end falls back to the previous one
+    for(uint32_t i = 0; (i < 2) && (i < recordCount) && !result; i++)
+    {
+        file.seek((recordCount - 1 - i) * sizeof(Record));
+        result = (file.read((uint8_t*)&record, sizeof(record)) == sizeof(record)) && isValid(record);
+    }
+    file.close();
+    return result;
+}
+
+void PositionStore::writeJournal(const Record& record)
+{
+    if (!m_fsMounted)
+        return;
+    const char* mode = "a";
+    const char* oldFile = nullptr;
+    if (m_journalRecords >= JOURNAL_MAX_RECORDS)
+    {
+        // Start the other file, the old one is removed once the new record is written
+        oldFile = m_journalFile;
+        m_journalFile = (m_journalFile == JOURNAL_FILE_A) ? JOURNAL_FILE_B : JOURNAL_FILE_A;
+        m_journalRecords = 0;
+        mode = "w";
+    }
+    File file = LittleFS.open(m_journalFile, mode);
+    if (!file)
+    {
+        Log::error("PositionStore", "Unable to open journal %s", m_journalFile);
+        return;
+    }
+    size_t written = file.write((const uint8_t*)&record, sizeof(record));
+    file.close();
+    if (written != sizeof(record))
+    {
+        Log::error("PositionStore", "Journal write failed");
+        return;
+    }
+    m_journalRecords++;
+    if (oldFile)
+        LittleFS.remove(oldFile);
+}
+
+bool PositionStore::load(State& state)
+{
+    PositionStore& inst = getInstance();
+    Record best;
+    bool found = false;
+    Record record;
+    if (inst.readRtc(record))
+    {
+        best = record;
+        found = true;
+    }
+    if (inst.m_fsMounted)
+    {
+        uint32_t countA;
+        uint32_t countB;
+        bool validA = inst.readJournal(JOURNAL_FILE_A, record, countA);
+        if (validA && (!found || (record.sequence > best.sequence)))
+        {
+            best = record;
+            found = true;
+        }
+        Record recordB;
+        bool validB = inst.readJournal(JOURNAL_FILE_B, recordB, countB);
+        if (validB && (!found || (recordB.sequence > best.sequence)))
+        {
+            best = recordB;
+            found = true;
+        }
+        // Continue the journal which holds the newest record
+        if (validB && (!validA || (recordB.sequence > record.sequence)))
+        {
+            inst.m_journalFile = JOURNAL_FILE_B;
+            inst.m_journalRecords = countB;
+        }
+        else
+        {
+            inst.m_journalFile = JOURNAL_FILE_A;
+            inst.m_journalRecords = countA;
+        }
+    }
+    if (!found)
+    {
+        Log::info("PositionStore", "No stored state found");
+        return false;
+    }
+    inst.m_sequence = best.sequence;
+    state = best.state;
+    Log::info("PositionStore", "State restored, sequence=%d", best.sequence);
+    return true;
+}
+
+void PositionStore::save(const State& state)
+{
+    PositionStore& inst = getInstance();
+    Record record;
+    memset(&record, 0, sizeof(record));
+    record.magic = RECORD_MAGIC;
+    record.sequence = ++inst.m_sequence;
+    record.state = state;
+    record.crc = calculateCrc(record);
+    inst.writeRtc(record);
+    inst.writeJournal(record);
+    Log::debug("PositionStore", "State saved, sequence=%d", record.sequence);
+}
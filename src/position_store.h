@@ -0,0 +1,63 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+
+// Louver state kept across reboots, RTC memory for warm resets and append
+// only flash journal for cold boots
+class PositionStore
+{
+public:
+
+    struct State
+    {
+        int32_t position;
+        uint32_t relayCycles;
+        uint64_t motorRuntimeMilli;
+    };
+
+    static bool load(State& state);
+
+    static void save(const State& state);
+
+private:
+
+    static constexpr uint32_t RECORD_MAGIC = 0x4c565053;
+    static constexpr uint32_t JOURNAL_MAX_RECORDS = 128;
+    static constexpr const char* JOURNAL_FILE_A = "/position_a.jnl";
+    static constexpr const char* JOURNAL_FILE_B = "/position_b.jnl";
+    // RTC user memory offset in 4 byte blocks (ESP8266)
+    static constexpr uint32_t RTC_OFFSET_BLOCKS = 32;
+
+    struct Record
+    {
+        uint32_t magic;
+        uint32_t sequence;
+        State state;
+        uint32_t crc;
+    };
+
+    PositionStore();
+
+    static inline PositionStore& getInstance()
+    {
+        static PositionStore store;
+        return store;
+    }
+
+    static uint32_t calculateCrc(const Record& record);
+
+    static bool isValid(const Record& record);
+
+    bool readRtc(Record& record);
+
+    void writeRtc(const Record& record);
+
+    bool readJournal(const char* fileName, Record& record, uint32_t& recordCount);
+
+    void writeJournal(const Record& record);
+
+    bool m_fsMounted;
+    uint32_t m_sequence;
+    const char* m_journalFile;
+    uint32_t m_journalRecords;
+};
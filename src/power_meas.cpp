@@ -3,12 +3,41 @@
 #include "bl0939.h"
 #include "ade7953.h"
 #include "cse7761.h"
+#include "hlw8012.h"
 #include "time.h"
 #include "log.h"
 #include "config.h"
+#include "motion_analyzer.h"
+#include "movement_stats.h"
+
+static const char* const DEVICE_NAMES[PowerMeas::DEV_COUNT] = { "none", "bl0939", "ade7953", "cse7761", "hlw8012" };
+
+// Checks comma separated list of names
+static bool isListed(const String& list, const char* name)
+{
+    int start = 0;
+    while (start <= (int)list.length())
+    {
+        int end = list.indexOf(',', start);
+        if (end < 0)
+            end = list.length();
+        String item = list.substring(start, end);
+        item.trim();
+        if (item == name)
+            return true;
+        start = end + 1;
+    }
+    return false;
+}
 
 PowerMeas::PowerMeas() :
-    m_activeDevice(DEV_NONE)
+    m_activeDevice(DEV_NONE),
+    m_enabledCount(0),
+    m_processIndex(0),
+    m_conditionsResetFlag(false),
+    m_conditionListener(nullptr),
+    m_motionActive(false),
+    m_fastRefreshUntil(0)
 {
     PowerMeasDevice* device = new PowerMeasDevice;
     m_devices.push_back(device);
@@ -18,19 +47,14 @@ PowerMeas::PowerMeas() :
     m_devices.push_back(ade7953); 
     CSE7761* cse7761 = new CSE7761;
     m_devices.push_back(cse7761); 
-
-    // Stop conditions defaults
-    for(size_t i = 0; i < STOP_CONDITION_COUNT; i++)
+    HLW8012* hlw8012 = new HLW8012;
+    m_devices.push_back(hlw8012); 
+    for(size_t i = 0; i < m_devices.size(); i++)
     {
-        m_stopConditions[i].valueIndex = 0;
-        m_stopConditions[i].comparator = CMP_EQUAL;
-        m_stopConditions[i].valueToCheck = 0;
-        m_stopConditions[i].durationMilli = 100;
-        m_stopConditions[i].result = false;
-        m_stopConditions[i].__timer = 0;
-        m_stopConditions[i].__resetFlag = false;
-        m_stopConditions[i].__lastCompare = false;
+        m_devices[i]->setSampleListener(onSample);
+        m_devices[i]->setValueListener(onValue);
     }
+    updateEnabledDevices();
 }
 
 void PowerMeas::loadConfig()
@@ -38,26 +62,66 @@ void PowerMeas::loadConfig()
     PowerMeas& inst = getInstance();
 
     setActiveDeviceType((PowerMeas::DeviceType)Config::getInt("power_meas/device", DEV_NONE));
+    inst.m_extraDevices = Config::getString("power_meas/extra_devices", "");
+    inst.updateEnabledDevices();
+    for(uint8_t i = 1; i < inst.m_enabledCount; i++)
+        inst.m_devices[inst.m_enabledDevices[i]]->init();
 
-    inst.m_stopConditions[0].valueIndex = Config::getInt("power_meas/cond1_index", 0);
-    inst.m_stopConditions[0].valueToCheck = Config::getFloat("power_meas/cond1_threshold", 0);
-    inst.m_stopConditions[0].comparator = (Comparator)Config::getInt("power_meas/cond1_comparator", CMP_EQUAL);
-    inst.m_stopConditions[0].durationMilli = (uint32_t)Config::getInt("power_meas/cond1_duration", 100);
-    inst.m_stopConditions[1].valueIndex = Config::getInt("power_meas/cond2_index", 0);
-    inst.m_stopConditions[1].valueToCheck = Config::getFloat("power_meas/cond2_threshold", 0);
-    inst.m_stopConditions[1].comparator = (Comparator)Config::getInt("power_meas/cond2_comparator", CMP_EQUAL);
-    inst.m_stopConditions[1].durationMilli = (uint32_t)Config::getInt("power_meas/cond2_duration", 100);
-    Log::info("PowerMeas", "Configuration loaded, driver=%d", getInstance().m_activeDevice);
-    Log::info("PowerMeas", "Stop condition 1 set, value index=%d, threshold=%f, comparator=%d, duration=%dms", 
-        inst.m_stopConditions[0].valueIndex,
-        inst.m_stopConditions[0].valueToCheck,
-        inst.m_stopConditions[0].comparator,
-        inst.m_stopConditions[0].durationMilli);
-    Log::info("PowerMeas", "Stop condition 2 set, value index=%d, threshold=%f, comparator=%d, duration=%dms", 
-        inst.m_stopConditions[1].valueIndex,
-        inst.m_stopConditions[1].valueToCheck,
-        inst.m_stopConditions[1].comparator,
-        inst.m_stopConditions[1].durationMilli);
+    inst.m_filtersConfig = Config::getString("power_meas/filters", "[]");
+    inst.applyFilters();
+    inst.m_conditionsConfig = Config::getString("power_meas/conditions", "");
+    if (inst.m_conditionsConfig.length() == 0)
+        inst.m_conditionsConfig = getLegacyConditionsConfig();
+    inst.compileConditions();
+    Log::info("PowerMeas", "Configuration loaded, driver=%d, extra devices=%s", getInstance().m_activeDevice, inst.m_extraDevices.c_str());
+    Log::info("PowerMeas", "Stop conditions set, %s", inst.m_conditionsConfig.c_str());
+}
+
+String PowerMeas::getLegacyConditionsConfig()
+{
+    // Two conditions configured by separate keys before named conditions existed
+    String result = "[";
+    for(uint8_t i = 1; i <= 2; i++)
+    {
+        String prefix = "power_meas/cond" + String(i) + "_";
+        if (i > 1)
+            result += ",";
+        result = result + "{\"name\":\"cond" + String(i) + "\",";
+        result = result + "\"index\":" + String(Config::getInt((prefix + "index").c_str(), 0)) + ",";
+        result = result + "\"threshold\":" + String(Config::getFloat((prefix + "threshold").c_str(), 0)) + ",";
+        result = result + "\"comparator\":\"" + PowerMeasCondition::comparatorToString((PowerMeasCondition::Comparator)Config::getInt((prefix + "comparator").c_str(), PowerMeasCondition::CMP_EQUAL)) + "\",";
+        result = result + "\"duration_milli\":" + String(Config::getInt((prefix + "duration").c_str(), 100));
+        result = result + "}";
+    }
+    result += "]";
+    return result;
+}
+
+void PowerMeas::compileConditions()
+{
+    for(uint8_t i = 0; i < MAX_CONDITIONS; i++)
+        m_conditions[i].clear();
+    if (m_conditionsConfig.length() == 0)
+        return;
+    DynamicJsonDocument json(1024);
+    DeserializationError error = deserializeJson(json, m_conditionsConfig);
+    if (error)
+    {
+        Log::error("PowerMeas", "Error while parsing conditions JSON: %s", error.c_str());
+        return;
+    }
+    JsonArrayConst conditions = json.as<JsonArrayConst>();
+    uint8_t index = 0;
+    for(JsonVariantConst condition : conditions)
+    {
+        if (index >= MAX_CONDITIONS)
+        {
+            Log::error("PowerMeas", "Too many conditions, maximum is %d", MAX_CONDITIONS);
+            break;
+        }
+        m_conditions[index].compile(condition);
+        index++;
+    }
 }
 
 ::std::vector<PowerMeas::Device> PowerMeas::getDevices()
@@ -97,7 +161,13 @@ void PowerMeas::setActiveDeviceType(DeviceType deviceType)
     inst.m_activeDevice = deviceType;
     if (last != deviceType)
     {
+        if (last < inst.m_devices.size())
+            inst.m_devices[last]->releaseHistory();
         inst.m_devices[deviceType]->init();
+        inst.updateEnabledDevices();
+        // Filters and value names in conditions are resolved against the active device
+        inst.applyFilters();
+        inst.compileConditions();
         Config::setInt("power_meas/device", deviceType);
         Log::info("PowerMeas", "Active device set to driver %d", getInstance().m_activeDevice);
     }
@@ -108,20 +178,197 @@ PowerMeas::DeviceType PowerMeas::getActiveDeviceType()
     return getInstance().m_activeDevice;
 }
 
+void PowerMeas::updateEnabledDevices()
+{
+    uint8_t count = 0;
+    m_enabledDevices[count++] = m_activeDevice;
+    for(uint8_t i = DEV_BL0939; (i < m_devices.size()) && (count < MAX_DEVICES); i++)
+    {
+        if ((i != m_activeDevice) && isListed(m_extraDevices, DEVICE_NAMES[i]))
+            m_enabledDevices[count++] = i;
+    }
+    m_enabledCount = count;
+    m_processIndex = 0;
+}
+
+String PowerMeas::getExtraDevices()
+{
+    return getInstance().m_extraDevices;
+}
+
+void PowerMeas::setExtraDevices(String devices)
+{
+    PowerMeas& inst = getInstance();
+    devices.trim();
+    if (devices == inst.m_extraDevices)
+        return;
+    bool wasEnabled[DEV_COUNT];
+    for(uint8_t i = 0; i < DEV_COUNT; i++)
+        wasEnabled[i] = isDeviceEnabled((DeviceType)i);
+    inst.m_extraDevices = devices;
+    inst.updateEnabledDevices();
+    for(uint8_t i = 1; i < inst.m_enabledCount; i++)
+    {
+        if (!wasEnabled[inst.m_enabledDevices[i]])
+            inst.m_devices[inst.m_enabledDevices[i]]->init();
+    }
+    // Indexes of extra device values follow active device values
+    inst.applyFilters();
+    inst.compileConditions();
+    Config::setString("power_meas/extra_devices", devices);
+    Config::flush();
+    Log::info("PowerMeas", "Extra devices set, %s, enabled devices=%d", devices.c_str(), inst.m_enabledCount);
+}
+
+bool PowerMeas::isDeviceEnabled(DeviceType deviceType)
+{
+    PowerMeas& inst = getInstance();
+    for(uint8_t i = 0; i < inst.m_enabledCount; i++)
+    {
+        if (inst.m_enabledDevices[i] == deviceType)
+            return true;
+    }
+    return false;
+}
+
+const char* PowerMeas::getDeviceName(DeviceType deviceType)
+{
+    if (deviceType < DEV_COUNT)
+        return DEVICE_NAMES[deviceType];
+    return "";
+}
+
+uint8_t PowerMeas::getValueCount()
+{
+    PowerMeas& inst = getInstance();
+    uint16_t count = 0;
+    for(uint8_t i = 0; i < inst.m_enabledCount; i++)
+        count += inst.m_devices[inst.m_enabledDevices[i]]->getDescriptorCount();
+    return (count < NO_VALUE) ? (uint8_t)count : (NO_VALUE - 1);
+}
+
+PowerMeasDevice* PowerMeas::getValueDevicePrivate(uint8_t index, uint8_t& deviceValueIndex)
+{
+    for(uint8_t i = 0; i < m_enabledCount; i++)
+    {
+        PowerMeasDevice* device = m_devices[m_enabledDevices[i]];
+        uint8_t count = device->getDescriptorCount();
+        if (index < count)
+        {
+            deviceValueIndex = index;
+            return device;
+        }
+        index -= count;
+    }
+    return nullptr;
+}
+
+const PowerMeasDevice* PowerMeas::getValueDevice(uint8_t index, uint8_t& deviceValueIndex)
+{
+    return getInstance().getValueDevicePrivate(index, deviceValueIndex);
+}
+
+uint8_t PowerMeas::findValue(const char* name)
+{
+    PowerMeas& inst = getInstance();
+    const char* separator = strchr(name, '/');
+    uint16_t base = 0;
+    for(uint8_t i = 0; (i < inst.m_enabledCount) && (base < NO_VALUE); i++)
+    {
+        const PowerMeasDevice& device = *inst.m_devices[inst.m_enabledDevices[i]];
+        const char* topic = name;
+        if (separator != nullptr)
+        {
+            const char* deviceName = DEVICE_NAMES[inst.m_enabledDevices[i]];
+            size_t length = separator - name;
+            if ((strlen(deviceName) != length) || (strncmp(name, deviceName, length) != 0))
+            {
+                base += device.getDescriptorCount();
+                continue;
+            }
+            topic = separator + 1;
+        }
+        else if (i > 0)
+        {
+            // Plain names belong to the active device
+            break;
+        }
+        for(uint8_t j = 0; j < device.getDescriptorCount(); j++)
+        {
+            if ((base + j < NO_VALUE) && (strcmp_P(topic, (PGM_P)device.getMqttTopic(j)) == 0))
+                return (uint8_t)(base + j);
+        }
+        base += device.getDescriptorCount();
+    }
+    return NO_VALUE;
+}
+
+String PowerMeas::getValueName(uint8_t index)
+{
+    PowerMeas& inst = getInstance();
+    for(uint8_t i = 0; i < inst.m_enabledCount; i++)
+    {
+        const PowerMeasDevice& device = *inst.m_devices[inst.m_enabledDevices[i]];
+        uint8_t count = device.getDescriptorCount();
+        if (index < count)
+        {
+            if (i == 0)
+                return String(device.getMqttTopic(index));
+            return String(DEVICE_NAMES[inst.m_enabledDevices[i]]) + "/" + device.getMqttTopic(index);
+        }
+        index -= count;
+    }
+    return "";
+}
+
 String PowerMeas::exportActiveDescriptorsToJSON()
 {
     PowerMeas& inst = getInstance();
-    if (inst.m_activeDevice < inst.m_devices.size())
-        return inst.m_devices[inst.m_activeDevice]->exportDescriptorsToJSON();
-    return "{\"power_meas\":[]}";
+    String result;
+    result.reserve(32 + getValueCount() * 160);
+    result += "{\"power_meas\":[";
+    bool first = true;
+    for(uint8_t i = 0; i < inst.m_enabledCount; i++)
+    {
+        const PowerMeasDevice& device = *inst.m_devices[inst.m_enabledDevices[i]];
+        // Values of extra devices are distinguished by chip name
+        String prefix = (i == 0) ? "" : device.getChipInfo() + " ";
+        String namePrefix = (i == 0) ? "" : String(DEVICE_NAMES[inst.m_enabledDevices[i]]) + "/";
+        for(uint8_t j = 0; j < device.getDescriptorCount(); j++)
+        {
+            if (!first)
+                result += ",";
+            first = false;
+            result += "{\"description\":\"";
+            result += prefix;
+            result += device.getDescription(j);
+            result += "\",\"name\":\"";
+            result += namePrefix;
+            result += device.getMqttTopic(j);
+            result += "\",\"unit\":\"";
+            result += device.getUnit(j);
+            result += "\",\"valueFormat\":\"";
+            result += device.getValueFormat(j);
+            result += "\",\"lastValue\":";
+            result += String(device.getLastValue(j));
+            result += ",\"minValue\":";
+            result += String(device.getMinValue(j));
+            result += ",\"maxValue\":";
+            result += String(device.getMaxValue(j));
+            result += "}";
+        }
+    }
+    result += "]}";
+    return result;
 }
 
-::std::vector<PowerMeasDevice::ValueDescriptor> PowerMeas::getActiveDescriptors()
+const PowerMeasDevice& PowerMeas::getActiveDeviceDriver()
 {
     PowerMeas& inst = getInstance();
     if (inst.m_activeDevice < inst.m_devices.size())
-        return inst.m_devices[inst.m_activeDevice]->getDescriptors();
-    return ::std::vector<PowerMeasDevice::ValueDescriptor>();
+        return *inst.m_devices[inst.m_activeDevice];
+    // Device without descriptors
+    return *inst.m_devices[DEV_NONE];
 }
 
 String PowerMeas::getActiveConfiguration()
@@ -155,184 +402,228 @@ void PowerMeas::setConfiguration(DeviceType deviceType, String config, bool perf
         return inst.m_devices[deviceType]->setConfiguration(config, true, performInit);
 }
 
-bool PowerMeas::getConditionResult(uint8_t conditionIndex)
+void PowerMeas::applyFilters()
 {
-    if (conditionIndex < STOP_CONDITION_COUNT)
+    uint8_t filterCount = 0;
+    for(uint8_t i = 0; i < m_enabledCount; i++)
+        m_devices[m_enabledDevices[i]]->clearFilters();
+    if (m_filtersConfig.length() == 0)
+        return;
+    DynamicJsonDocument json(1024);
+    DeserializationError error = deserializeJson(json, m_filtersConfig);
+    if (error)
     {
-        if (getInstance().m_stopConditions[conditionIndex].__resetFlag)
-            return false;
-        return getInstance().m_stopConditions[conditionIndex].result;
+        Log::error("PowerMeas", "Error while parsing filters JSON: %s", error.c_str());
+        return;
     }
-    return false;
+    JsonArrayConst filters = json.as<JsonArrayConst>();
+    for(JsonVariantConst filter : filters)
+    {
+        const char* name = filter["name"] | "";
+        uint8_t sourceIndex = filter["index"] | 0;
+        if (filter.containsKey("value"))
+        {
+            // Source referenced by its name, filter is added to the device measuring it
+            sourceIndex = findValue(filter["value"] | "");
+        }
+        uint8_t deviceValueIndex = 0;
+        PowerMeasDevice* device = getValueDevicePrivate(sourceIndex, deviceValueIndex);
+        PowerMeasFilter::Type type = PowerMeasFilter::stringToType(filter["type"] | "");
+        if ((strlen(name) == 0) || (device == nullptr) || 
+            !device->addFilter(deviceValueIndex, type, filter["window"] | 5, filter["alpha"] | 1.0f, name, filter["publish"] | false))
+            Log::error("PowerMeas", "Unable to add filter %s", name);
+        else
+            filterCount++;
+    }
+    Log::info("PowerMeas", "Filters set, count=%d", filterCount);
 }
 
-void PowerMeas::resetAllConditions()
+String PowerMeas::getFiltersConfig()
 {
-    uint64_t now = Time::nowRelativeMilli();
-    for(size_t i = 0; i < STOP_CONDITION_COUNT; i++)
+    return getInstance().m_filtersConfig;
+}
+
+void PowerMeas::setFiltersConfig(String config)
+{
+    PowerMeas& inst = getInstance();
+    DynamicJsonDocument json(1024);
+    DeserializationError error = deserializeJson(json, config);
+    if (error) 
     {
-        getInstance().m_stopConditions[i].__resetFlag = true;
+        Log::error("PowerMeas", "Error while parsing filters JSON: %s", error.c_str());
+        return;
     }
-    Log::debug("PowerMeas", "All conditions reset");
+    if (!json.is<JsonArray>())
+    {
+        Log::error("PowerMeas", "Filters must be JSON array");
+        return;
+    }
+    inst.m_filtersConfig = config;
+    inst.applyFilters();
+    // Conditions may reference filtered values
+    inst.compileConditions();
+    Config::setString("power_meas/filters", config);
+    Config::flush();
+    Log::info("PowerMeas", "Filters set, %s", config.c_str());
 }
 
-String PowerMeas::getConditionConfig(uint8_t conditionIndex)
+uint8_t PowerMeas::findCondition(const String& name)
 {
     PowerMeas& inst = getInstance();
-    if (conditionIndex < STOP_CONDITION_COUNT)
+    if (name.length() == 0)
+        return NO_CONDITION;
+    for(uint8_t i = 0; i < MAX_CONDITIONS; i++)
     {
-        String result = "{";
-        result = result + "\"index\":" + String(inst.m_stopConditions[conditionIndex].valueIndex) + ",";
-        result = result + "\"threshold\":" + String(inst.m_stopConditions[conditionIndex].valueToCheck) + ",";
-        result = result + "\"comparator\":\"" + comparatorToString(inst.m_stopConditions[conditionIndex].comparator) + "\",";
-        result = result + "\"duration_milli\":" + String(inst.m_stopConditions[conditionIndex].durationMilli);
-        result = result + "}";
-        return result;
+        if (inst.m_conditions[i].isDefined() && (name == inst.m_conditions[i].getName()))
+            return i;
     }
-    return "{}";
+    return NO_CONDITION;
+}
+
+const char* PowerMeas::getConditionName(uint8_t conditionIndex)
+{
+    if (conditionIndex < MAX_CONDITIONS)
+        return getInstance().m_conditions[conditionIndex].getName();
+    return "";
 }
 
-void PowerMeas::setConditionConfig(uint8_t conditionIndex, String config)
+bool PowerMeas::getConditionResult(uint8_t conditionIndex)
 {
     PowerMeas& inst = getInstance();
-    if (conditionIndex < STOP_CONDITION_COUNT)
+    if (conditionIndex < MAX_CONDITIONS)
     {
-        DynamicJsonDocument json(512);
-        DeserializationError error = deserializeJson(json, config);
-        if (error) 
-        {
-            Log::error("PowerMeas", "Error while parsing config JSON, condition %d: %s", conditionIndex, error.c_str());
-        }
-        else
-        {
-            if (json.containsKey("index"))
-                inst.m_stopConditions[conditionIndex].valueIndex = json["index"].as<uint8_t>();
-            if (json.containsKey("threshold"))
-                inst.m_stopConditions[conditionIndex].valueToCheck = json["threshold"].as<float>();
-            if (json.containsKey("comparator"))
-                inst.m_stopConditions[conditionIndex].comparator = stringToComparator(json["comparator"]);
-            if (json.containsKey("duration_milli"))
-                inst.m_stopConditions[conditionIndex].durationMilli = json["duration_milli"].as<uint32_t>();
-            if (conditionIndex == 0)
-            {
-                Config::setInt("power_meas/cond1_index", inst.m_stopConditions[conditionIndex].valueIndex);
-                Config::setFloat("power_meas/cond1_threshold", inst.m_stopConditions[conditionIndex].valueToCheck);
-                Config::setInt("power_meas/cond1_comparator", inst.m_stopConditions[conditionIndex].comparator);
-                Config::setInt("power_meas/cond1_duration", inst.m_stopConditions[conditionIndex].durationMilli);
-            }
-            else if (conditionIndex == 1)
-            {
-                Config::setInt("power_meas/cond2_index", inst.m_stopConditions[conditionIndex].valueIndex);
-                Config::setFloat("power_meas/cond2_threshold", inst.m_stopConditions[conditionIndex].valueToCheck);
-                Config::setInt("power_meas/cond2_comparator", inst.m_stopConditions[conditionIndex].comparator);
-                Config::setInt("power_meas/cond2_duration", inst.m_stopConditions[conditionIndex].durationMilli);
-            }
-            Log::info("PowerMeas", "Stop condition %d set, value index=%d, threshold=%f, comparator=%d, duration=%dms", 
-                conditionIndex, 
-                inst.m_stopConditions[conditionIndex].valueIndex,
-                inst.m_stopConditions[conditionIndex].valueToCheck,
-                inst.m_stopConditions[conditionIndex].comparator,
-                inst.m_stopConditions[conditionIndex].durationMilli);
-        }
+        if (inst.m_conditionsResetFlag)
+            return false;
+        return inst.m_conditions[conditionIndex].getResult();
+    }
+    return false;
+}
+
+void PowerMeas::resetAllConditions()
+{
+    getInstance().m_conditionsResetFlag = true;
+    Log::debug("PowerMeas", "All conditions reset");
+}
+
+void PowerMeas::setConditionListener(ConditionListener listener)
+{
+    getInstance().m_conditionListener = listener;
+}
+
+void PowerMeas::applyConditionsReset()
+{
+    if (m_conditionsResetFlag)
+    {
+        for(uint8_t i = 0; i < MAX_CONDITIONS; i++)
+            m_conditions[i].reset();
+        m_conditionsResetFlag = false;
     }
 }
 
-bool PowerMeas::compare(float value1, float value2, Comparator cmp)
+String PowerMeas::getConditionsConfig()
 {
-    switch(cmp)
+    return getInstance().m_conditionsConfig;
+}
+
+void PowerMeas::setConditionsConfig(String config)
+{
+    PowerMeas& inst = getInstance();
+    DynamicJsonDocument json(1024);
+    DeserializationError error = deserializeJson(json, config);
+    if (error) 
     {
-        case CMP_LESS:
-            return value1 < value2; 
-        case CMP_LESS_OR_EQUAL:
-            return value1 <= value2;
-        case CMP_EQUAL:
-            return value1 == value2;
-        case CMP_GREATER:
-            return value1 > value2;
-        case CMP_GREATER_OR_EQUAL:
-            return value1 >= value2;
-        case CMP_NOT_EQUAL:
-            return value1 != value2;
+        Log::error("PowerMeas", "Error while parsing conditions JSON: %s", error.c_str());
+        return;
     }
-    return false;
+    if (!json.is<JsonArray>())
+    {
+        Log::error("PowerMeas", "Conditions must be JSON array");
+        return;
+    }
+    inst.m_conditionsConfig = config;
+    inst.compileConditions();
+    Config::setString("power_meas/conditions", config);
+    Config::flush();
+    Log::info("PowerMeas", "Stop conditions set, %s", config.c_str());
 }
 
-String PowerMeas::comparatorToString(Comparator cmp)
+void PowerMeas::setMotionActive(bool active)
 {
-    switch(cmp)
+    PowerMeas& inst = getInstance();
+    if (inst.m_motionActive == active)
+        return;
+    inst.m_motionActive = active;
+    if (!active)
+        inst.m_fastRefreshUntil = Time::nowRelativeMilli() + FAST_REFRESH_HOLD_MILLI;
+    Log::debug("PowerMeas", "Motion %s", active ? "started" : "stopped");
+}
+
+void PowerMeas::onSample(const PowerMeasDevice& device, uint64_t sampleTimeMilli)
+{
+    PowerMeas& inst = getInstance();
+    inst.applyConditionsReset();
+    // Motor current analysis follows the active device only
+    if (&device == &getActiveDeviceDriver())
     {
-        case CMP_LESS:
-            return "<"; 
-        case CMP_LESS_OR_EQUAL:
-            return "<="; 
-        case CMP_EQUAL:
-            return "=="; 
-        case CMP_GREATER:
-            return ">"; 
-        case CMP_GREATER_OR_EQUAL:
-            return ">="; 
-        case CMP_NOT_EQUAL:
-            return "!="; 
+        MotionAnalyzer::onSample(device, sampleTimeMilli);
+        MovementStats::onSample(device, sampleTimeMilli);
     }
-    return "==";
+    inst.evaluateConditions(device, sampleTimeMilli, PowerMeasCondition::ALL_VALUES);
+}
+
+void PowerMeas::onValue(const PowerMeasDevice& device, uint8_t index, uint64_t sampleTimeMilli)
+{
+    PowerMeas& inst = getInstance();
+    inst.applyConditionsReset();
+    inst.evaluateConditions(device, sampleTimeMilli, index);
 }
 
-PowerMeas::Comparator PowerMeas::stringToComparator(String cmp)
+void PowerMeas::evaluateConditions(const PowerMeasDevice& device, uint64_t sampleTimeMilli, uint8_t valueIndex)
 {
-    if (cmp == "<")
-        return CMP_LESS;
-    else if (cmp == "<=")
-        return CMP_LESS_OR_EQUAL;
-    else if (cmp == "==")
-        return CMP_EQUAL;
-    else if (cmp == ">")
-        return CMP_GREATER;
-    else if (cmp == ">=")
-        return CMP_GREATER_OR_EQUAL;
-    else if (cmp == "!=")
-        return CMP_NOT_EQUAL;
-    return CMP_EQUAL;
+    // Hold timers run on sample time, loop timing does not affect the result
+    for(uint8_t i = 0; i < MAX_CONDITIONS; i++)
+    {
+        PowerMeasCondition& condition = m_conditions[i];
+        if (!condition.isDefined())
+            continue;
+        bool lastResult = condition.getResult();
+        if (condition.evaluate(device, sampleTimeMilli, true, valueIndex) && !lastResult)
+        {
+            Log::info("PowerMeas", "Condition %s met", condition.getName());
+            if (m_conditionListener)
+                m_conditionListener(i);
+        }
+    }
 }
 
 void PowerMeas::process()
 {
     PowerMeas& inst = getInstance();
-    if (inst.m_activeDevice < inst.m_devices.size())
+    uint64_t now = Time::nowRelativeMilli();
+    bool fast = inst.m_motionActive || (now < inst.m_fastRefreshUntil);
+    bool changed = false;
+    for(uint8_t i = 0; i < inst.m_enabledCount; i++)
     {
-        uint64_t now = Time::nowRelativeMilli();
-        inst.m_devices[inst.m_activeDevice]->process();
-        for(size_t i = 0; i < STOP_CONDITION_COUNT; i++)
+        PowerMeasDevice* device = inst.m_devices[inst.m_enabledDevices[i]];
+        if (fast != device->isFastRefresh())
         {
-            if (inst.m_stopConditions[i].__resetFlag)
-            {
-                    inst.m_stopConditions[i].result = false;
-                    inst.m_stopConditions[i].__timer = now;
-                    inst.m_stopConditions[i].__lastCompare = false;
-                    inst.m_stopConditions[i].__resetFlag = false;
-            }
-            if (inst.m_stopConditions[i].valueIndex < inst.m_devices[inst.m_activeDevice]->getDescriptorCount())
-            {
-                PowerMeasDevice::ValueDescriptor desc = inst.m_devices[inst.m_activeDevice]->getDescriptor(inst.m_stopConditions[i].valueIndex);
-                bool cmpResult = compare(inst.m_stopConditions[i].valueToCheck, desc.lastValue, inst.m_stopConditions[i].comparator);
-                if (!cmpResult)
-                {
-                    inst.m_stopConditions[i].result = false;
-                    inst.m_stopConditions[i].__timer = now;
-                }
-                else
-                {
-                    if (cmpResult != inst.m_stopConditions[i].__lastCompare)
-                    {
-                        inst.m_stopConditions[i].__timer = now;
-                    }
-                    if (!inst.m_stopConditions[i].result && (now > (inst.m_stopConditions[i].__timer + inst.m_stopConditions[i].durationMilli)))
-                    {
-                        inst.m_stopConditions[i].result = true;
-                        Log::info("PowerMeas", "Condition %d met", i);
-                    }
-                }
-                inst.m_stopConditions[i].__lastCompare = cmpResult;
-            }
+            device->setFastRefresh(fast);
+            changed = true;
         }
     }
-}
\ No newline at end of file
+    if (changed)
+        Log::info("PowerMeas", "%s refresh profile", fast ? "Fast" : "Idle");
+    inst.applyConditionsReset();
+    // Devices take turns, next device is processed only while the pass budget lasts.
+    // Samples are handed to onSample by the driver as soon as they are read.
+    uint32_t start = micros();
+    for(uint8_t i = 0; i < inst.m_enabledCount; i++)
+    {
+        if ((i > 0) && ((uint32_t)(micros() - start) >= PROCESS_BUDGET_MICRO))
+            break;
+        if (inst.m_processIndex >= inst.m_enabledCount)
+            inst.m_processIndex = 0;
+        inst.m_devices[inst.m_enabledDevices[inst.m_processIndex]]->process();
+        inst.m_processIndex++;
+    }
+}
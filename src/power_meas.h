@@ -1,29 +1,30 @@
 #pragma once
+#include <vector>
 #include "power_meas_device.h"
+#include "power_meas_condition.h"
 
 class PowerMeas
 {
 public:
 
-    static constexpr uint8_t STOP_CONDITION_COUNT = 2;
+    static constexpr uint8_t MAX_CONDITIONS = 8;
+    static constexpr uint8_t NO_CONDITION = 0xff;
+    // Enabled at once, active device included
+    static constexpr uint8_t MAX_DEVICES = 4;
+    static constexpr uint8_t NO_VALUE = 0xff;
 
     enum DeviceType
     {
         DEV_NONE = 0,
         DEV_BL0939,
         DEV_ADE7953,
-        DEV_CSE7761
+        DEV_CSE7761,
+        DEV_HLW8012,
+        DEV_COUNT
     };
 
-    enum Comparator
-    {
-        CMP_LESS = 0,
-        CMP_LESS_OR_EQUAL,
-        CMP_EQUAL,
-        CMP_GREATER,
-        CMP_GREATER_OR_EQUAL,
-        CMP_NOT_EQUAL
-    };
+    // Called when a stop condition becomes satisfied, right from sample processing
+    typedef void (*ConditionListener)(uint8_t conditionIndex);
 
     struct Device
     {
@@ -41,9 +42,31 @@ public:
 
     static DeviceType getActiveDeviceType();
 
+    // Devices measuring together with the active one, driver names separated by comma
+    static String getExtraDevices();
+
+    static void setExtraDevices(String devices);
+
+    static bool isDeviceEnabled(DeviceType deviceType);
+
+    static const char* getDeviceName(DeviceType deviceType);
+
+    // Values of all enabled devices share one index space, active device comes
+    // first. Values of extra devices are named with device prefix, e.g. "cse7761/current1".
+    static uint8_t getValueCount();
+
+    // Accepts plain MQTT topic of active device value or prefixed name, returns NO_VALUE if not found
+    static uint8_t findValue(const char* name);
+
+    static String getValueName(uint8_t index);
+
+    // Returns nullptr for invalid index
+    static const PowerMeasDevice* getValueDevice(uint8_t index, uint8_t& deviceValueIndex);
+
+    // Descriptors of all enabled devices
     static String exportActiveDescriptorsToJSON();
 
-    static ::std::vector<PowerMeasDevice::ValueDescriptor> getActiveDescriptors();
+    static const PowerMeasDevice& getActiveDeviceDriver();
 
     static String getActiveConfiguration();
 
@@ -53,37 +76,60 @@ public:
 
     static void setConfiguration(DeviceType deviceType, String config, bool performInit = false);
 
+    // Returns NO_CONDITION when there is no condition with this name
+    static uint8_t findCondition(const String& name);
+
+    static const char* getConditionName(uint8_t conditionIndex);
+
     static bool getConditionResult(uint8_t conditionIndex);
 
     static void resetAllConditions();
 
-    static String getConditionConfig(uint8_t conditionIndex);
+    static void setConditionListener(ConditionListener listener);
 
-    static void setConditionConfig(uint8_t conditionIndex, String config);
+    // JSON array of condition objects
+    static String getConditionsConfig();
+
+    static void setConditionsConfig(String config);
+
+    // JSON array of filtered values added to the active device
+    static String getFiltersConfig();
+
+    static void setFiltersConfig(String config);
+
+    // Called by Louver, fast refresh profile is used while motor runs
+    static void setMotionActive(bool active);
 
     static void process();
 
 private:
 
-    struct StopCondition
-    {
-        uint8_t valueIndex;
-        Comparator comparator;
-        float valueToCheck;
-        uint32_t durationMilli;
-        bool result;
-        bool __resetFlag;
-        uint64_t __timer;
-        bool __lastCompare;
-    };
+    // Fast profile is kept shortly after motor stops (step delays, motor coasting)
+    static constexpr uint32_t FAST_REFRESH_HOLD_MILLI = 2000;
+    // Time slice of one process pass shared by enabled devices
+    static constexpr uint32_t PROCESS_BUDGET_MICRO = 1000;
 
     PowerMeas();
 
-    static bool compare(float value1, float value2, Comparator cmp);
+    static String getLegacyConditionsConfig();
+
+    PowerMeasDevice* getValueDevicePrivate(uint8_t index, uint8_t& deviceValueIndex);
+
+    void updateEnabledDevices();
+
+    // Sample listener of all devices, conditions are evaluated per sample
+    static void onSample(const PowerMeasDevice& device, uint64_t sampleTimeMilli);
+
+    // Value listener of all devices, only conditions of that value are updated
+    static void onValue(const PowerMeasDevice& device, uint8_t index, uint64_t sampleTimeMilli);
+
+    void evaluateConditions(const PowerMeasDevice& device, uint64_t sampleTimeMilli, uint8_t valueIndex);
+
+    void applyConditionsReset();
 
-    static String comparatorToString(Comparator cmp);
+    void compileConditions();
 
-    static Comparator stringToComparator(String cmp);
+    void applyFilters();
 
     static inline PowerMeas& getInstance()
     {
@@ -93,6 +139,18 @@ private:
 
     ::std::vector<PowerMeasDevice*> m_devices;
     DeviceType m_activeDevice;
-    StopCondition m_stopConditions[STOP_CONDITION_COUNT];
+    String m_extraDevices;
+    // Active device first, then extra devices
+    uint8_t m_enabledDevices[MAX_DEVICES];
+    uint8_t m_enabledCount;
+    // Round robin index of device processed in next pass
+    uint8_t m_processIndex;
+    String m_filtersConfig;
+    String m_conditionsConfig;
+    PowerMeasCondition m_conditions[MAX_CONDITIONS];
+    bool m_conditionsResetFlag;
+    ConditionListener m_conditionListener;
+    bool m_motionActive;
+    uint64_t m_fastRefreshUntil;
 
 };
\ No newline at end of file
@@ -0,0 +1,478 @@
+#include "power_meas_archive.h"
+#include <LittleFS.h>
+#include "power_meas.h"
+#include "config.h"
+#include "time.h"
+#include "log.h"
+
+// Leading zero count of previous XOR, value means no window is known yet
+static const uint8_t NO_WINDOW = 0xff;
+
+PowerMeasArchive::PowerMeasArchive() :
+    m_periodSecs(DEFAULT_PERIOD_SECS),
+    m_initialized(false),
+    m_fsMounted(false),
+    m_block(nullptr),
+    m_writeSlot(0),
+    m_sequence(0),
+    m_lastSampleTime(0),
+    m_lastFlushTime(0),
+    m_dirty(false),
+    m_delta(0)
+{
+
+}
+
+void PowerMeasArchive::loadConfig()
+{
+    PowerMeasArchive& inst = getInstance();
+    inst.m_periodSecs = (uint32_t)Config::getInt("power_meas/archive_period", DEFAULT_PERIOD_SECS);
+    Log::info("PowerMeasArchive", "Configuration loaded, period=%d s", inst.m_periodSecs);
+}
+
+void PowerMeasArchive::setPeriod(uint32_t periodSecs)
+{
+    PowerMeasArchive& inst = getInstance();
+    if (inst.m_periodSecs == periodSecs)
+        return;
+    inst.m_periodSecs = periodSecs;
+    Config::setInt("power_meas/archive_period", periodSecs);
+    Config::flush();
+    Log::info("PowerMeasArchive", "Archive period set to %d s", periodSecs);
+}
+
+uint32_t PowerMeasArchive::getPeriod()
+{
+    return getInstance().m_periodSecs;
+}
+
+void PowerMeasArchive::writeBits(uint8_t* data, uint32_t& position, uint32_t value, uint8_t bits)
+{
+    // MSB first
+    for(int8_t i = bits - 1; i >= 0; i--)
+    {
+        uint8_t mask = 0x80 >> (position & 7);
+        if ((value >> i) & 1)
+            data[position >> 3] |= mask;
+        else
+            data[position >> 3] &= ~mask;
+        position++;
+    }
+}
+
+uint32_t PowerMeasArchive::readBits(const uint8_t* data, uint32_t& position, uint8_t bits)
+{
+    uint32_t value = 0;
+    for(uint8_t i = 0; i < bits; i++)
+    {
+        value = (value << 1) | ((data[position >> 3] >> (7 - (position & 7))) & 1);
+        position++;
+    }
+    return value;
+}
+
+uint8_t PowerMeasArchive::countLeadingZeros(uint32_t value)
+{
+    return (value == 0) ? 32 : __builtin_clz(value);
+}
+
+uint8_t PowerMeasArchive::countTrailingZeros(uint32_t value)
+{
+    return (value == 0) ? 32 : __builtin_ctz(value);
+}
+
+PowerMeasArchive::BlockHeader* PowerMeasArchive::getHeader()
+{
+    return (BlockHeader*)m_block;
+}
+
+void PowerMeasArchive::init()
+{
+    m_initialized = true;
+#ifdef ESP32
+    m_fsMounted = LittleFS.begin(true);
+#else
+    m_fsMounted = LittleFS.begin();
+#endif
+    if (!m_fsMounted)
+    {
+        Log::error("PowerMeasArchive", "Unable to mount file system, archive disabled");
+        return;
+    }
+    m_block = (uint8_t*)malloc(BLOCK_SIZE);
+    if (m_block == nullptr)
+    {
+        Log::error("PowerMeasArchive", "Unable to allocate block buffer, archive disabled");
+        return;
+    }
+    // Continue after the block with the highest sequence number
+    BlockHeader header;
+    bool found = false;
+    File file = LittleFS.open(ARCHIVE_FILE, "r");
+    if (file)
+    {
+        uint32_t slots = file.size() / BLOCK_SIZE;
+        for(uint32_t slot = 0; (slot < slots) && (slot < MAX_BLOCKS); slot++)
+        {
+            file.seek(slot * BLOCK_SIZE);
+            if ((file.read((uint8_t*)&header, sizeof(header)) == sizeof(header)) &&
+                (header.magic == BLOCK_MAGIC) &&
+                (!found || (header.sequence > m_sequence)))
+            {
+                found = true;
+                m_sequence = header.sequence;
+                m_writeSlot = slot;
+            }
+        }
+        file.close();
+    }
+    if (found)
+    {
+        m_sequence++;
+        m_writeSlot = (m_writeSlot + 1) % MAX_BLOCKS;
+    }
+    getHeader()->magic = 0;
+    Log::info("PowerMeasArchive", "Archive initialized, next block slot=%d, sequence=%d", m_writeSlot, m_sequence);
+}
+
+void PowerMeasArchive::startBlock(uint8_t channelCount)
+{
+    memset(m_block, 0, BLOCK_SIZE);
+    BlockHeader* header = getHeader();
+    header->magic = BLOCK_MAGIC;
+    header->sequence = m_sequence;
+    header->channelCount = channelCount;
+    m_dirty = false;
+}
+
+void PowerMeasArchive::writeBlock()
+{
+    File file = LittleFS.open(ARCHIVE_FILE, LittleFS.exists(ARCHIVE_FILE) ? "r+" : "w");
+    if (!file)
+    {
+        Log::error("PowerMeasArchive", "Unable to open archive file");
+        return;
+    }
+    file.seek(m_writeSlot * BLOCK_SIZE);
+    if (file.write(m_block, BLOCK_SIZE) != BLOCK_SIZE)
+        Log::error("PowerMeasArchive", "Archive block write failed, slot=%d", m_writeSlot);
+    file.close();
+    m_dirty = false;
+    m_lastFlushTime = Time::nowRelativeMilli();
+}
+
+void PowerMeasArchive::addSample(uint32_t time, const PowerMeasDevice& device)
+{
+    uint8_t channelCount = device.getDescriptorCount();
+    BlockHeader* header = getHeader();
+    // Worst case size of one sample
+    uint32_t maxBits = 4 + 32 + (uint32_t)channelCount * (2 + 5 + 5 + 32);
+    if ((header->magic == BLOCK_MAGIC) &&
+        ((header->channelCount != channelCount) || (header->bitCount + maxBits > BLOCK_DATA_BITS)))
+    {
+        // Block is complete, continue with next slot
+        writeBlock();
+        m_writeSlot = (m_writeSlot + 1) % MAX_BLOCKS;
+        m_sequence++;
+        header->magic = 0;
+    }
+    if (header->magic != BLOCK_MAGIC)
+        startBlock(channelCount);
+    uint8_t* data = m_block + sizeof(BlockHeader);
+    uint32_t position = header->bitCount;
+    if (header->sampleCount == 0)
+    {
+        header->startTime = time;
+        writeBits(data, position, time, 32);
+        for(uint8_t i = 0; i < channelCount; i++)
+        {
+            float value = device.getLastValue(i);
+            memcpy(&m_values[i], &value, sizeof(uint32_t));
+            writeBits(data, position, m_values[i], 32);
+            m_leading[i] = NO_WINDOW;
+            m_trailing[i] = 0;
+        }
+        m_delta = 0;
+    }
+    else
+    {
+        int32_t delta = (int32_t)(time - header->endTime);
+        int32_t deltaOfDelta = delta - m_delta;
+        m_delta = delta;
+        if (deltaOfDelta == 0)
+        {
+            writeBits(data, position, 0, 1);
+        }
+        else if ((deltaOfDelta >= -63) && (deltaOfDelta <= 64))
+        {
+            writeBits(data, position, 0x2, 2);
+            writeBits(data, position, (uint32_t)(deltaOfDelta + 63), 7);
+        }
+        else if ((deltaOfDelta >= -255) && (deltaOfDelta <= 256))
+        {
+            writeBits(data, position, 0x6, 3);
+            writeBits(data, position, (uint32_t)(deltaOfDelta + 255), 9);
+        }
+        else if ((deltaOfDelta >= -2047) && (deltaOfDelta <= 2048))
+        {
+            writeBits(data, position, 0xe, 4);
+            writeBits(data, position, (uint32_t)(deltaOfDelta + 2047), 12);
+        }
+        else
+        {
+            writeBits(data, position, 0xf, 4);
+            writeBits(data, position, (uint32_t)deltaOfDelta, 32);
+        }
+        for(uint8_t i = 0; i < channelCount; i++)
+        {
+            float value = device.getLastValue(i);
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            uint32_t xorValue = bits ^ m_values[i];
+            m_values[i] = bits;
+            if (xorValue == 0)
+            {
+                writeBits(data, position, 0, 1);
+                continue;
+            }
+            uint8_t leading = countLeadingZeros(xorValue);
+            uint8_t trailing = countTrailingZeros(xorValue);
+            if (leading > 31)
+                leading = 31;
+            if ((m_leading[i] != NO_WINDOW) && (leading >= m_leading[i]) && (trailing >= m_trailing[i]))
+            {
+                // Meaningful bits fit into previous window
+                writeBits(data, position, 0x2, 2);
+                writeBits(data, position, xorValue >> m_trailing[i], 32 - m_leading[i] - m_trailing[i]);
+            }
+            else
+            {
+                uint8_t length = 32 - leading - trailing;
+                writeBits(data, position, 0x3, 2);
+                writeBits(data, position, leading, 5);
+                writeBits(data, position, length - 1, 5);
+                writeBits(data, position, xorValue >> trailing, length);
+                m_leading[i] = leading;
+                m_trailing[i] = trailing;
+            }
+        }
+    }
+    // Header is updated last, readers copying the block see consistent data
+    header->bitCount = position;
+    header->endTime = time;
+    header->sampleCount++;
+    m_dirty = true;
+}
+
+bool PowerMeasArchive::copyCurrentBlock(uint8_t* buffer)
+{
+    if ((m_block == nullptr) || (getHeader()->magic != BLOCK_MAGIC))
+        return false;
+    memcpy(buffer, m_block, BLOCK_SIZE);
+    return true;
+}
+
+bool PowerMeasArchive::readBlock(uint32_t slot, uint8_t* buffer)
+{
+    if (!m_fsMounted)
+        return false;
+    File file = LittleFS.open(ARCHIVE_FILE, "r");
+    if (!file)
+        return false;
+    bool result = false;
+    if ((slot + 1) * BLOCK_SIZE <= file.size())
+    {
+        file.seek(slot * BLOCK_SIZE);
+        result = (file.read(buffer, BLOCK_SIZE) == BLOCK_SIZE) && (((BlockHeader*)buffer)->magic == BLOCK_MAGIC);
+    }
+    file.close();
+    return result;
+}
+
+void PowerMeasArchive::process()
+{
+    PowerMeasArchive& inst = getInstance();
+    if ((inst.m_periodSecs == 0) || (PowerMeas::getActiveDeviceType() == PowerMeas::DEV_NONE))
+        return;
+    uint32_t now = Time::nowEpoch();
+    if (now == 0)
+        return;
+    if (!inst.m_initialized)
+        inst.init();
+    if (inst.m_block == nullptr)
+        return;
+    if (now >= inst.m_lastSampleTime + inst.m_periodSecs)
+    {
+        inst.m_lastSampleTime = now;
+        const PowerMeasDevice& device = PowerMeas::getActiveDeviceDriver();
+        if (device.getDescriptorCount() > 0)
+            inst.addSample(now, device);
+    }
+    // Unfinished block is written periodically, so only a few minutes are lost on power failure
+    if (inst.m_dirty && (Time::nowRelativeMilli() >= inst.m_lastFlushTime + FLUSH_PERIOD_MILLI))
+        inst.writeBlock();
+}
+
+PowerMeasArchive::Reader::Reader(uint8_t channel, uint32_t fromTime, uint32_t toTime) :
+    m_channel(channel),
+    m_fromTime(fromTime),
+    m_toTime(toTime),
+    m_block((uint8_t*)malloc(BLOCK_SIZE)),
+    m_blockIndex(0),
+    m_finished(false),
+    m_headerSent(false),
+    m_bitPosition(0),
+    m_sampleIndex(0),
+    m_time(0),
+    m_delta(0),
+    m_lineLength(0)
+{
+    if (m_block == nullptr)
+        m_finished = true;
+    else
+        ((BlockHeader*)m_block)->magic = 0;
+}
+
+PowerMeasArchive::Reader::~Reader()
+{
+    free(m_block);
+}
+
+bool PowerMeasArchive::Reader::loadNextBlock()
+{
+    PowerMeasArchive& archive = getInstance();
+    BlockHeader* header = (BlockHeader*)m_block;
+    header->magic = 0;
+    // Stored blocks from the oldest one, the block being filled is the last
+    while (m_blockIndex <= MAX_BLOCKS)
+    {
+        uint32_t index = m_blockIndex++;
+        bool loaded;
+        if (index < MAX_BLOCKS - 1)
+            loaded = archive.readBlock((archive.m_writeSlot + 1 + index) % MAX_BLOCKS, m_block);
+        else if (index == MAX_BLOCKS - 1)
+            continue;
+        else
+            loaded = archive.copyCurrentBlock(m_block);
+        if (loaded && (header->sampleCount > 0) && (header->endTime >= m_fromTime) && (header->startTime <= m_toTime))
+        {
+            m_bitPosition = 0;
+            m_sampleIndex = 0;
+            return true;
+        }
+    }
+    header->magic = 0;
+    return false;
+}
+
+bool PowerMeasArchive::Reader::decodeSample()
+{
+    BlockHeader* header = (BlockHeader*)m_block;
+    const uint8_t* data = m_block + sizeof(BlockHeader);
+    uint8_t channelCount = header->channelCount;
+    if ((channelCount > PowerMeasDevice::MAX_VALUES) || (header->bitCount > BLOCK_DATA_BITS) ||
+        (m_bitPosition >= header->bitCount))
+    {
+        // Corrupted block, skip the rest of it
+        m_sampleIndex = header->sampleCount;
+        return false;
+    }
+    if (m_sampleIndex == 0)
+    {
+        m_time = readBits(data, m_bitPosition, 32);
+        m_delta = 0;
+        for(uint8_t i = 0; i < channelCount; i++)
+        {
+            m_values[i] = readBits(data, m_bitPosition, 32);
+            m_leading[i] = NO_WINDOW;
+            m_trailing[i] = 0;
+        }
+    }
+    else
+    {
+        int32_t deltaOfDelta = 0;
+        if (readBits(data, m_bitPosition, 1) != 0)
+        {
+            if (readBits(data, m_bitPosition, 1) == 0)
+                deltaOfDelta = (int32_t)readBits(data, m_bitPosition, 7) - 63;
+            else if (readBits(data, m_bitPosition, 1) == 0)
+                deltaOfDelta = (int32_t)readBits(data, m_bitPosition, 9) - 255;
+            else if (readBits(data, m_bitPosition, 1) == 0)
+                deltaOfDelta = (int32_t)readBits(data, m_bitPosition, 12) - 2047;
+            else
+                deltaOfDelta = (int32_t)readBits(data, m_bitPosition, 32);
+        }
+        m_delta += deltaOfDelta;
+        m_time += m_delta;
+        for(uint8_t i = 0; i < channelCount; i++)
+        {
+            if (readBits(data, m_bitPosition, 1) == 0)
+                continue;
+            if (readBits(data, m_bitPosition, 1) == 0)
+            {
+                uint8_t length = 32 - m_leading[i] - m_trailing[i];
+                m_values[i] ^= readBits(data, m_bitPosition, length) << m_trailing[i];
+            }
+            else
+            {
+                uint8_t leading = readBits(data, m_bitPosition, 5);
+                uint8_t length = readBits(data, m_bitPosition, 5) + 1;
+                m_leading[i] = leading;
+                m_trailing[i] = 32 - leading - length;
+                m_values[i] ^= readBits(data, m_bitPosition, length) << m_trailing[i];
+            }
+        }
+    }
+    m_sampleIndex++;
+    if ((m_time < m_fromTime) || (m_time > m_toTime))
+        return false;
+    int length = snprintf(m_line, sizeof(m_line), "%u", m_time);
+    for(uint8_t i = 0; i < channelCount; i++)
+    {
+        if ((m_channel != ALL_CHANNELS) && (m_channel != i))
+            continue;
+        float value;
+        memcpy(&value, &m_values[i], sizeof(value));
+        length += snprintf(m_line + length, sizeof(m_line) - length, ",%.3f", value);
+        if (length >= (int)sizeof(m_line) - 1)
+            break;
+    }
+    if (length < (int)sizeof(m_line) - 1)
+        m_line[length++] = '\n';
+    m_lineLength = length;
+    return true;
+}
+
+size_t PowerMeasArchive::Reader::read(uint8_t* buffer, size_t maxLen)
+{
+    size_t length = 0;
+    if (!m_headerSent)
+    {
+        m_lineLength = snprintf(m_line, sizeof(m_line), "time,%s\n", (m_channel == ALL_CHANNELS) ? "values" : "value");
+        m_headerSent = true;
+    }
+    while (true)
+    {
+        if (m_lineLength > 0)
+        {
+            if (length + m_lineLength > maxLen)
+                break;
+            memcpy(buffer + length, m_line, m_lineLength);
+            length += m_lineLength;
+            m_lineLength = 0;
+        }
+        if (m_finished)
+            break;
+        BlockHeader* header = (BlockHeader*)m_block;
+        if ((header->magic != BLOCK_MAGIC) || (m_sampleIndex >= header->sampleCount))
+        {
+            if (!loadNextBlock())
+            {
+                m_finished = true;
+                continue;
+            }
+        }
+        decodeSample();
+    }
+    return length;
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include "power_meas_device.h"
+
+// Long term archive of measured values on LittleFS. Samples are compressed
+// using delta-of-delta timestamps and XOR floats (Gorilla) in fixed size
+// blocks, blocks are stored as a ring in one file.
+class PowerMeasArchive
+{
+public:
+
+    static constexpr uint32_t DEFAULT_PERIOD_SECS = 10;
+
+#ifdef ESP32
+    static constexpr uint32_t BLOCK_SIZE = 4096;
+    static constexpr uint32_t MAX_BLOCKS = 256;
+#else
+    static constexpr uint32_t BLOCK_SIZE = 1024;
+    static constexpr uint32_t MAX_BLOCKS = 64;
+#endif
+
+    // Streams archived samples as CSV, one instance per HTTP request
+    class Reader
+    {
+    public:
+
+        static constexpr uint8_t ALL_CHANNELS = 0xff;
+
+        Reader(uint8_t channel, uint32_t fromTime, uint32_t toTime);
+
+        ~Reader();
+
+        // Fills buffer with whole CSV lines, returns 0 when finished
+        size_t read(uint8_t* buffer, size_t maxLen);
+
+    private:
+
+        bool loadNextBlock();
+
+        bool decodeSample();
+
+        uint8_t m_channel;
+        uint32_t m_fromTime;
+        uint32_t m_toTime;
+        uint8_t* m_block;
+        uint32_t m_blockIndex;
+        bool m_finished;
+        bool m_headerSent;
+        uint32_t m_bitPosition;
+        uint16_t m_sampleIndex;
+        uint32_t m_time;
+        int32_t m_delta;
+        uint32_t m_values[PowerMeasDevice::MAX_VALUES];
+        uint8_t m_leading[PowerMeasDevice::MAX_VALUES];
+        uint8_t m_trailing[PowerMeasDevice::MAX_VALUES];
+        char m_line[256];
+        size_t m_lineLength;
+    };
+
+    static void loadConfig();
+
+    static void setPeriod(uint32_t periodSecs);
+
+    static uint32_t getPeriod();
+
+    static void process();
+
+private:
+
+    static constexpr uint32_t BLOCK_MAGIC = 0x41504d47;
+    static constexpr uint32_t FLUSH_PERIOD_MILLI = 10 * 60 * 1000;
+    static constexpr const char* ARCHIVE_FILE = "/power_meas.arc";
+
+    struct BlockHeader
+    {
+        uint32_t magic;
+        uint32_t sequence;
+        uint32_t startTime;
+        uint32_t endTime;
+        uint32_t bitCount;
+        uint16_t sampleCount;
+        uint8_t channelCount;
+        uint8_t reserved;
+    };
+
+    static constexpr uint32_t BLOCK_DATA_BITS = (BLOCK_SIZE - sizeof(BlockHeader)) * 8;
+
+    PowerMeasArchive();
+
+    static inline PowerMeasArchive& getInstance()
+    {
+        static PowerMeasArchive archive;
+        return archive;
+    }
+
+    static void writeBits(uint8_t* data, uint32_t& position, uint32_t value, uint8_t bits);
+
+    static uint32_t readBits(const uint8_t* data, uint32_t& position, uint8_t bits);
+
+    static uint8_t countLeadingZeros(uint32_t value);
+
+    static uint8_t countTrailingZeros(uint32_t value);
+
+    void init();
+
+    void startBlock(uint8_t channelCount);
+
+    void writeBlock();
+
+    void addSample(uint32_t time, const PowerMeasDevice& device);
+
+    BlockHeader* getHeader();
+
+    bool copyCurrentBlock(uint8_t* buffer);
+
+    bool readBlock(uint32_t slot, uint8_t* buffer);
+
+    uint32_t m_periodSecs;
+    bool m_initialized;
+    bool m_fsMounted;
+    uint8_t* m_block;
+    uint32_t m_writeSlot;
+    uint32_t m_sequence;
+    uint32_t m_lastSampleTime;
+    uint64_t m_lastFlushTime;
+    bool m_dirty;
+    int32_t m_delta;
+    uint32_t m_values[PowerMeasDevice::MAX_VALUES];
+    uint8_t m_leading[PowerMeasDevice::MAX_VALUES];
+    uint8_t m_trailing[PowerMeasDevice::MAX_VALUES];
+};
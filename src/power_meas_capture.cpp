@@ -0,0 +1,203 @@
+#include "power_meas_capture.h"
+#include <ArduinoJson.h>
+#include <math.h>
+#include "power_meas.h"
+#include "config.h"
+#include "time.h"
+#include "log.h"
+
+PowerMeasCapture::PowerMeasCapture() :
+    m_enabled(false),
+    m_channelUp(0),
+    m_channelDown(1),
+    m_windowMicro(DEFAULT_WINDOW_MILLI * 1000),
+    m_emitMicro(DEFAULT_EMIT_MILLI * 1000),
+    m_gain(1),
+    m_running(false),
+    m_channel(0),
+    m_device(nullptr),
+    m_startMicro(0),
+    m_lastEmitMicro(0),
+    m_generation(0),
+    m_samples(nullptr),
+    m_head(0),
+    m_count(0),
+    m_windowCount(0),
+    m_windowSum(0)
+{
+
+}
+
+void PowerMeasCapture::loadConfig()
+{
+    PowerMeasCapture& inst = getInstance();
+    inst.m_config = Config::getString("power_meas/capture", "{\"enabled\":false}");
+    inst.applyConfig();
+    Log::info("PowerMeasCapture", "Configuration loaded, %s", inst.m_config.c_str());
+}
+
+String PowerMeasCapture::getConfig()
+{
+    return getInstance().m_config;
+}
+
+void PowerMeasCapture::setConfig(String config)
+{
+    PowerMeasCapture& inst = getInstance();
+    if (config == inst.m_config)
+        return;
+    inst.m_config = config;
+    inst.applyConfig();
+    Config::setString("power_meas/capture", config);
+    Config::flush();
+    Log::info("PowerMeasCapture", "Configuration set, %s", config.c_str());
+}
+
+void PowerMeasCapture::applyConfig()
+{
+    DynamicJsonDocument json(512);
+    DeserializationError error = deserializeJson(json, m_config);
+    if (error)
+    {
+        Log::error("PowerMeasCapture", "Error while parsing config JSON: %s", error.c_str());
+        m_enabled = false;
+        return;
+    }
+    m_running = false;
+    m_enabled = json["enabled"] | false;
+    m_channelUp = json["channel_up"] | (uint8_t)0;
+    m_channelDown = json["channel_down"] | (uint8_t)1;
+    m_windowMicro = (json["window_milli"] | (uint32_t)DEFAULT_WINDOW_MILLI) * 1000;
+    m_emitMicro = (json["emit_milli"] | (uint32_t)DEFAULT_EMIT_MILLI) * 1000;
+    m_gain = json["gain"] | 1.0f;
+    if ((m_windowMicro == 0) || (m_emitMicro == 0))
+    {
+        Log::error("PowerMeasCapture", "Window and emit period must be set, capture disabled");
+        m_enabled = false;
+    }
+    if (m_enabled && !m_samples)
+    {
+        m_samples = new (std::nothrow) Sample[MAX_SAMPLES];
+        if (!m_samples)
+        {
+            Log::error("PowerMeasCapture", "Unable to allocate %d samples", MAX_SAMPLES);
+            m_enabled = false;
+        }
+    }
+}
+
+bool PowerMeasCapture::isEnabled()
+{
+    return getInstance().m_enabled;
+}
+
+void PowerMeasCapture::start(bool directionUp)
+{
+    PowerMeasCapture& inst = getInstance();
+    if (!inst.m_enabled)
+        return;
+    inst.m_channel = directionUp ? inst.m_channelUp : inst.m_channelDown;
+    inst.m_device = &PowerMeas::getActiveDeviceDriver();
+    inst.m_startMicro = Time::nowRelativeMicro();
+    inst.m_lastEmitMicro = 0;
+    inst.m_head = 0;
+    inst.m_count = 0;
+    inst.m_windowCount = 0;
+    inst.m_windowSum = 0;
+    inst.m_generation++;
+    inst.m_running = true;
+}
+
+void PowerMeasCapture::stop()
+{
+    PowerMeasCapture& inst = getInstance();
+    if (!inst.m_running)
+        return;
+    inst.m_running = false;
+    uint64_t duration = Time::nowRelativeMicro() - inst.m_startMicro;
+    Log::info("PowerMeasCapture", "Capture finished, %d samples, %d ms, %.0f Hz", inst.m_count, (uint32_t)(duration / 1000), getSampleRate());
+}
+
+bool PowerMeasCapture::isCapturing(const PowerMeasDevice& device, uint8_t& channel)
+{
+    PowerMeasCapture& inst = getInstance();
+    if (!inst.m_running || (inst.m_device != &device))
+        return false;
+    channel = inst.m_channel;
+    return true;
+}
+
+bool PowerMeasCapture::addSample(const PowerMeasDevice& device, float value)
+{
+    PowerMeasCapture& inst = getInstance();
+    if (!inst.m_running || (inst.m_device != &device) || isnan(value))
+        return false;
+    uint32_t timeMicro = (uint32_t)(Time::nowRelativeMicro() - inst.m_startMicro);
+    value *= inst.m_gain;
+    // Oldest sample is overwritten, the trace keeps the end of the step
+    if ((inst.m_count == MAX_SAMPLES) && (inst.m_windowCount == MAX_SAMPLES))
+    {
+        float oldest = inst.m_samples[inst.m_head].value;
+        inst.m_windowSum -= (double)oldest * oldest;
+        inst.m_windowCount--;
+    }
+    inst.m_samples[inst.m_head].timeMicro = timeMicro;
+    inst.m_samples[inst.m_head].value = value;
+    inst.m_head = (inst.m_head + 1) % MAX_SAMPLES;
+    if (inst.m_count < MAX_SAMPLES)
+        inst.m_count++;
+    inst.m_windowSum += (double)value * value;
+    inst.m_windowCount++;
+    // Samples older than window leave the running sum
+    while (inst.m_windowCount > 1)
+    {
+        const Sample& oldest = inst.m_samples[(inst.m_head + MAX_SAMPLES - inst.m_windowCount) % MAX_SAMPLES];
+        if (timeMicro - oldest.timeMicro <= inst.m_windowMicro)
+            break;
+        inst.m_windowSum -= (double)oldest.value * oldest.value;
+        inst.m_windowCount--;
+    }
+    if (inst.m_windowSum < 0)
+        inst.m_windowSum = 0;
+    if ((inst.m_windowCount < 2) || (timeMicro < inst.m_lastEmitMicro + inst.m_emitMicro))
+        return false;
+    inst.m_lastEmitMicro = timeMicro;
+    return true;
+}
+
+float PowerMeasCapture::getRms()
+{
+    PowerMeasCapture& inst = getInstance();
+    if (inst.m_windowCount == 0)
+        return 0;
+    return sqrt(inst.m_windowSum / inst.m_windowCount);
+}
+
+uint32_t PowerMeasCapture::getGeneration()
+{
+    return getInstance().m_generation;
+}
+
+uint16_t PowerMeasCapture::getSampleCount()
+{
+    return getInstance().m_count;
+}
+
+bool PowerMeasCapture::getSample(uint16_t index, Sample& sample)
+{
+    PowerMeasCapture& inst = getInstance();
+    if (!inst.m_samples || (index >= inst.m_count))
+        return false;
+    sample = inst.m_samples[(inst.m_head + MAX_SAMPLES - inst.m_count + index) % MAX_SAMPLES];
+    return true;
+}
+
+float PowerMeasCapture::getSampleRate()
+{
+    PowerMeasCapture& inst = getInstance();
+    Sample first;
+    Sample last;
+    if ((inst.m_count < 2) || !getSample(0, first) || !getSample(inst.m_count - 1, last) || (last.timeMicro == first.timeMicro))
+        return 0;
+    return (inst.m_count - 1) * 1000000.0f / (last.timeMicro - first.timeMicro);
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include "power_meas_device.h"
+
+// Instantaneous current trace of movement steps. Register drivers read the
+// capture register of selected channel whenever their queue runs empty, samples
+// are kept in ring buffer and short window RMS is published as driver value.
+class PowerMeasCapture
+{
+public:
+
+    struct Sample
+    {
+        // Since capture start
+        uint32_t timeMicro;
+        float value;
+    };
+
+#ifdef ESP32
+    static constexpr uint16_t MAX_SAMPLES = 4096;
+#else
+    static constexpr uint16_t MAX_SAMPLES = 512;
+#endif
+    static constexpr uint32_t DEFAULT_WINDOW_MILLI = 40;
+    static constexpr uint32_t DEFAULT_EMIT_MILLI = 20;
+
+    static void loadConfig();
+
+    static String getConfig();
+
+    static void setConfig(String config);
+
+    static bool isEnabled();
+
+    // Called by Louver when relays of a step are switched on and off
+    static void start(bool directionUp);
+
+    static void stop();
+
+    // Returns channel of running capture when device is the active one
+    static bool isCapturing(const PowerMeasDevice& device, uint8_t& channel);
+
+    // Returns true when window RMS should be published as new sample
+    static bool addSample(const PowerMeasDevice& device, float value);
+
+    static float getRms();
+
+    // Incremented with every capture start, readers detect overwritten trace
+    static uint32_t getGeneration();
+
+    static uint16_t getSampleCount();
+
+    // Index from the oldest sample
+    static bool getSample(uint16_t index, Sample& sample);
+
+    // Effective sampling rate of the kept trace, 0 with less than two samples
+    static float getSampleRate();
+
+private:
+
+    PowerMeasCapture();
+
+    static inline PowerMeasCapture& getInstance()
+    {
+        static PowerMeasCapture capture;
+        return capture;
+    }
+
+    void applyConfig();
+
+    String m_config;
+    bool m_enabled;
+    uint8_t m_channelUp;
+    uint8_t m_channelDown;
+    uint32_t m_windowMicro;
+    uint32_t m_emitMicro;
+    // Waveform and RMS registers of some chips differ in full scale
+    float m_gain;
+    bool m_running;
+    uint8_t m_channel;
+    const PowerMeasDevice* m_device;
+    uint64_t m_startMicro;
+    uint32_t m_lastEmitMicro;
+    uint32_t m_generation;
+    // Allocated when capture is enabled first time
+    Sample* m_samples;
+    uint16_t m_head;
+    uint16_t m_count;
+    // Samples of the RMS window are the newest window count samples
+    uint16_t m_windowCount;
+    double m_windowSum;
+};
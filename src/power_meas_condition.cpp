@@ -0,0 +1,303 @@
+#include "power_meas_condition.h"
+#include <math.h>
+#include "log.h"
+#include "power_meas.h"
+
+PowerMeasCondition::PowerMeasCondition() :
+    m_opCount(0),
+    m_leafCount(0),
+    m_timerCount(0),
+    m_result(false)
+{
+    m_name[0] = 0;
+}
+
+void PowerMeasCondition::clear()
+{
+    m_name[0] = 0;
+    m_config = "";
+    m_opCount = 0;
+    m_leafCount = 0;
+    m_timerCount = 0;
+    m_result = false;
+}
+
+bool PowerMeasCondition::isDefined() const
+{
+    return m_opCount > 0;
+}
+
+const char* PowerMeasCondition::getName() const
+{
+    return m_name;
+}
+
+const String& PowerMeasCondition::getConfig() const
+{
+    return m_config;
+}
+
+bool PowerMeasCondition::compile(JsonVariantConst json)
+{
+    clear();
+    if (!json.is<JsonObjectConst>())
+        return false;
+    if (json.containsKey("name"))
+        strlcpy(m_name, json["name"] | "", MAX_NAME_LENGTH);
+    serializeJson(json, m_config);
+    uint8_t depth = 0;
+    if (!compileNode(json, depth))
+    {
+        Log::error("PowerMeas", "Unable to compile condition %s", m_name);
+        m_opCount = 0;
+        return false;
+    }
+    reset();
+    Log::debug("PowerMeas", "Condition %s compiled, ops=%d, leaves=%d, timers=%d", m_name, m_opCount, m_leafCount, m_timerCount);
+    return true;
+}
+
+bool PowerMeasCondition::emit(uint8_t code, uint8_t arg)
+{
+    if (m_opCount >= MAX_OPS)
+        return false;
+    m_ops[m_opCount].code = code;
+    m_ops[m_opCount].arg = arg;
+    m_opCount++;
+    return true;
+}
+
+bool PowerMeasCondition::compileNode(JsonVariantConst json, uint8_t& depth)
+{
+    JsonArrayConst children = json["all"].as<JsonArrayConst>();
+    uint8_t code = OP_AND;
+    if (children.isNull())
+    {
+        children = json["any"].as<JsonArrayConst>();
+        code = OP_OR;
+    }
+    if (!children.isNull())
+    {
+        size_t count = children.size();
+        if ((count == 0) || (count > MAX_STACK))
+            return false;
+        for(JsonVariantConst child : children)
+        {
+            if (!compileNode(child, depth))
+                return false;
+        }
+        if (!emit(code, (uint8_t)count))
+            return false;
+        depth -= (uint8_t)(count - 1);
+    }
+    else
+    {
+        if (m_leafCount >= MAX_LEAVES)
+            return false;
+        Leaf& leaf = m_leaves[m_leafCount];
+        uint8_t index = PowerMeas::NO_VALUE;
+        if (json.containsKey("value"))
+        {
+            // Value referenced by its name, e.g. "current1" or "cse7761/current1"
+            const char* valueName = json["value"] | "";
+            index = PowerMeas::findValue(valueName);
+            if (index == PowerMeas::NO_VALUE)
+            {
+                Log::error("PowerMeas", "Condition %s, unknown value %s", m_name, valueName);
+                return false;
+            }
+        }
+        else if (json.containsKey("index"))
+        {
+            index = json["index"].as<uint8_t>();
+        }
+        else
+        {
+            return false;
+        }
+        // Values which do not exist (yet) are never satisfied
+        leaf.device = PowerMeas::getValueDevice(index, leaf.valueIndex);
+        leaf.comparator = stringToComparator(json["comparator"] | "==");
+        leaf.threshold = json["threshold"] | 0.0f;
+        leaf.hysteresis = json["hysteresis"] | 0.0f;
+        leaf.filterAlpha = json["filter_alpha"] | 1.0f;
+        if ((leaf.filterAlpha <= 0) || (leaf.filterAlpha > 1))
+            leaf.filterAlpha = 1;
+        if (!emit(OP_LEAF, m_leafCount))
+            return false;
+        m_leafCount++;
+        depth++;
+    }
+    if (depth > MAX_STACK)
+        return false;
+    uint32_t durationMilli = json["duration_milli"] | 0;
+    if (durationMilli > 0)
+    {
+        if (m_timerCount >= MAX_TIMERS)
+            return false;
+        m_timers[m_timerCount].durationMilli = durationMilli;
+        if (!emit(OP_HOLD, m_timerCount))
+            return false;
+        m_timerCount++;
+    }
+    return true;
+}
+
+void PowerMeasCondition::reset()
+{
+    for(uint8_t i = 0; i < m_leafCount; i++)
+    {
+        m_leaves[i].filterValid = false;
+        m_leaves[i].result = false;
+    }
+    for(uint8_t i = 0; i < m_timerCount; i++)
+    {
+        m_timers[i].since = 0;
+        m_timers[i].lastInput = false;
+    }
+    m_result = false;
+}
+
+void PowerMeasCondition::updateLeaf(Leaf& leaf)
+{
+    if (leaf.valueIndex >= leaf.device->getDescriptorCount())
+    {
+        leaf.result = false;
+        return;
+    }
+    float value = leaf.device->getLastValue(leaf.valueIndex);
+    if (isnan(value))
+    {
+        leaf.result = false;
+        return;
+    }
+    if (!leaf.filterValid)
+    {
+        leaf.filtered = value;
+        leaf.filterValid = true;
+    }
+    else
+    {
+        leaf.filtered += leaf.filterAlpha * (value - leaf.filtered);
+    }
+    // Once satisfied, value must cross threshold by hysteresis to release
+    float threshold = leaf.threshold;
+    if (leaf.result)
+    {
+        if ((leaf.comparator == CMP_LESS) || (leaf.comparator == CMP_LESS_OR_EQUAL))
+            threshold -= leaf.hysteresis;
+        else if ((leaf.comparator == CMP_GREATER) || (leaf.comparator == CMP_GREATER_OR_EQUAL))
+            threshold += leaf.hysteresis;
+    }
+    leaf.result = compare(threshold, leaf.filtered, leaf.comparator);
+}
+
+bool PowerMeasCondition::evaluate(const PowerMeasDevice& device, uint64_t now, bool newSample, uint8_t valueIndex)
+{
+    if (m_opCount == 0)
+        return false;
+    if (newSample)
+    {
+        for(uint8_t i = 0; i < m_leafCount; i++)
+        {
+            if ((m_leaves[i].device == &device) && ((valueIndex == ALL_VALUES) || (m_leaves[i].valueIndex == valueIndex)))
+                updateLeaf(m_leaves[i]);
+        }
+    }
+    uint32_t stack = 0;
+    for(uint8_t i = 0; i < m_opCount; i++)
+    {
+        const Op& op = m_ops[i];
+        switch(op.code)
+        {
+            case OP_LEAF:
+                stack = (stack << 1) | (m_leaves[op.arg].result ? 1 : 0);
+                break;
+            case OP_AND:
+            case OP_OR:
+                {
+                    uint32_t mask = (op.arg >= 32) ? 0xffffffff : ((1UL << op.arg) - 1);
+                    uint32_t bits = stack & mask;
+                    stack = (op.arg >= 32) ? 0 : (stack >> op.arg);
+                    bool value = (op.code == OP_AND) ? (bits == mask) : (bits != 0);
+                    stack = (stack << 1) | (value ? 1 : 0);
+                }
+                break;
+            case OP_HOLD:
+                {
+                    Timer& timer = m_timers[op.arg];
+                    bool input = (stack & 1) != 0;
+                    if (input && !timer.lastInput)
+                        timer.since = now;
+                    timer.lastInput = input;
+                    bool value = input && (now > timer.since + timer.durationMilli);
+                    stack = (stack & ~1UL) | (value ? 1 : 0);
+                }
+                break;
+        }
+    }
+    m_result = (stack & 1) != 0;
+    return m_result;
+}
+
+bool PowerMeasCondition::getResult() const
+{
+    return m_result;
+}
+
+bool PowerMeasCondition::compare(float value1, float value2, Comparator cmp)
+{
+    switch(cmp)
+    {
+        case CMP_LESS:
+            return value1 < value2;
+        case CMP_LESS_OR_EQUAL:
+            return value1 <= value2;
+        case CMP_EQUAL:
+            return value1 == value2;
+        case CMP_GREATER:
+            return value1 > value2;
+        case CMP_GREATER_OR_EQUAL:
+            return value1 >= value2;
+        case CMP_NOT_EQUAL:
+            return value1 != value2;
+    }
+    return false;
+}
+
+String PowerMeasCondition::comparatorToString(Comparator cmp)
+{
+    switch(cmp)
+    {
+        case CMP_LESS:
+            return "<";
+        case CMP_LESS_OR_EQUAL:
+            return "<=";
+        case CMP_EQUAL:
+            return "==";
+        case CMP_GREATER:
+            return ">";
+        case CMP_GREATER_OR_EQUAL:
+            return ">=";
+        case CMP_NOT_EQUAL:
+            return "!=";
+    }
+    return "==";
+}
+
+PowerMeasCondition::Comparator PowerMeasCondition::stringToComparator(String cmp)
+{
+    if (cmp == "<")
+        return CMP_LESS;
+    else if (cmp == "<=")
+        return CMP_LESS_OR_EQUAL;
+    else if (cmp == "==")
+        return CMP_EQUAL;
+    else if (cmp == ">")
+        return CMP_GREATER;
+    else if (cmp == ">=")
+        return CMP_GREATER_OR_EQUAL;
+    else if (cmp == "!=")
+        return CMP_NOT_EQUAL;
+    return CMP_EQUAL;
+}
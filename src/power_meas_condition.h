@@ -0,0 +1,113 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#include <ArduinoJson.h>
+#include "power_meas_device.h"
+
+// Named condition over measured values. Condition JSON is compiled once into
+// a short postfix program, evaluation uses fixed arrays and a bit stack only.
+class PowerMeasCondition
+{
+public:
+
+    static constexpr uint8_t MAX_NAME_LENGTH = 16;
+    static constexpr uint8_t MAX_LEAVES = 8;
+    static constexpr uint8_t MAX_TIMERS = 8;
+    static constexpr uint8_t MAX_OPS = 24;
+    // Bit stack depth, one bit per intermediate result
+    static constexpr uint8_t MAX_STACK = 32;
+    static constexpr uint8_t ALL_VALUES = 0xff;
+
+    enum Comparator
+    {
+        CMP_LESS = 0,
+        CMP_LESS_OR_EQUAL,
+        CMP_EQUAL,
+        CMP_GREATER,
+        CMP_GREATER_OR_EQUAL,
+        CMP_NOT_EQUAL
+    };
+
+    PowerMeasCondition();
+
+    // Compiles condition object, values are resolved in PowerMeas value namespace
+    bool compile(JsonVariantConst json);
+
+    void clear();
+
+    bool isDefined() const;
+
+    const char* getName() const;
+
+    // Source JSON of the condition
+    const String& getConfig() const;
+
+    // Filters and timers start from scratch
+    void reset();
+
+    // Leaves of the sampling device are updated only when new sample was measured, timers on every call.
+    // Value index limits the update to leaves of that value.
+    bool evaluate(const PowerMeasDevice& device, uint64_t now, bool newSample, uint8_t valueIndex = ALL_VALUES);
+
+    bool getResult() const;
+
+    static String comparatorToString(Comparator cmp);
+
+    static Comparator stringToComparator(String cmp);
+
+private:
+
+    enum OpCode
+    {
+        OP_LEAF = 0,
+        OP_AND,
+        OP_OR,
+        OP_HOLD
+    };
+
+    struct Op
+    {
+        uint8_t code;
+        uint8_t arg;
+    };
+
+    struct Leaf
+    {
+        // Device measuring the value, index is device local
+        const PowerMeasDevice* device;
+        uint8_t valueIndex;
+        Comparator comparator;
+        float threshold;
+        float hysteresis;
+        // Exponential moving average weight, 1 = no filtering
+        float filterAlpha;
+        float filtered;
+        bool filterValid;
+        bool result;
+    };
+
+    struct Timer
+    {
+        uint32_t durationMilli;
+        uint64_t since;
+        bool lastInput;
+    };
+
+    static bool compare(float value1, float value2, Comparator cmp);
+
+    bool compileNode(JsonVariantConst json, uint8_t& depth);
+
+    bool emit(uint8_t code, uint8_t arg);
+
+    void updateLeaf(Leaf& leaf);
+
+    char m_name[MAX_NAME_LENGTH];
+    String m_config;
+    Op m_ops[MAX_OPS];
+    uint8_t m_opCount;
+    Leaf m_leaves[MAX_LEAVES];
+    uint8_t m_leafCount;
+    Timer m_timers[MAX_TIMERS];
+    uint8_t m_timerCount;
+    bool m_result;
+};
@@ -1,10 +1,27 @@
 #include "power_meas.h"
 #include "log.h"
+#include "time.h"
+
+static const PowerMeasDevice::DescriptorInfo INVALID_DESCRIPTOR PROGMEM = { "Invalid", "-", "", "invalid", true };
+static const float ZERO_VALUE = 0;
 
 PowerMeasDevice::PowerMeasDevice() :
-    m_enabled(false)
+    m_enabled(false),
+    m_fastRefresh(false),
+    m_descriptorTable(nullptr),
+    m_descriptorCount(0),
+    m_filters(nullptr),
+    m_filterCount(0),
+    m_updateCount(0),
+    m_lastSampleTime(0),
+    m_sampleListener(nullptr),
+    m_valueListener(nullptr),
+    m_historyFailed(false)
 {
-
+    memset(m_history, 0, sizeof(m_history));
+    memset(m_lastValues, 0, sizeof(m_lastValues));
+    memset(m_minValues, 0, sizeof(m_minValues));
+    memset(m_maxValues, 0, sizeof(m_maxValues));
 }
 
 String PowerMeasDevice::getChipInfo() const
@@ -12,51 +29,125 @@ String PowerMeasDevice::getChipInfo() const
     return "Unknown";
 }
 
-uint8_t PowerMeasDevice::getDescriptorCount()
+uint8_t PowerMeasDevice::getDescriptorCount() const
 {
-    return m_descriptors.size();
+    return m_descriptorCount + m_filterCount;
 }
 
-PowerMeasDevice::ValueDescriptor PowerMeasDevice::getDescriptor(uint8_t index)
+const PowerMeasDevice::DescriptorInfo* PowerMeasDevice::getInvalidDescriptor()
 {
-    if (index > getDescriptorCount())
-        return createEmptyDescriptor();
-    else
-        return m_descriptors[index];
+    return &INVALID_DESCRIPTOR;
+}
+
+const PowerMeasDevice::DescriptorInfo* PowerMeasDevice::getDescriptorInfo(uint8_t index) const
+{
+    if (index < m_descriptorCount)
+        return &m_descriptorTable[index];
+    if (index < m_descriptorCount + m_filterCount)
+        return &m_filters[index - m_descriptorCount].info;
+    return getInvalidDescriptor();
+}
+
+const __FlashStringHelper* PowerMeasDevice::getDescription(uint8_t index) const
+{
+    return FPSTR(getDescriptorInfo(index)->description);
+}
+
+const __FlashStringHelper* PowerMeasDevice::getUnit(uint8_t index) const
+{
+    return FPSTR(getDescriptorInfo(index)->unit);
+}
+
+const __FlashStringHelper* PowerMeasDevice::getValueFormat(uint8_t index) const
+{
+    return FPSTR(getDescriptorInfo(index)->valueFormat);
+}
+
+const __FlashStringHelper* PowerMeasDevice::getMqttTopic(uint8_t index) const
+{
+    return FPSTR(getDescriptorInfo(index)->mqttTopic);
+}
+
+bool PowerMeasDevice::isMqttPublished(uint8_t index) const
+{
+    return pgm_read_byte(&getDescriptorInfo(index)->mqttPublish) != 0;
+}
+
+const float& PowerMeasDevice::getLastValue(uint8_t index) const
+{
+    if (index >= getDescriptorCount())
+        return ZERO_VALUE;
+    return m_lastValues[index];
+}
+
+const float& PowerMeasDevice::getMinValue(uint8_t index) const
+{
+    if (index >= getDescriptorCount())
+        return ZERO_VALUE;
+    return m_minValues[index];
+}
+
+const float& PowerMeasDevice::getMaxValue(uint8_t index) const
+{
+    if (index >= getDescriptorCount())
+        return ZERO_VALUE;
+    return m_maxValues[index];
+}
+
+uint32_t PowerMeasDevice::getUpdateCount() const
+{
+    return m_updateCount;
 }
 
-::std::vector<PowerMeasDevice::ValueDescriptor> PowerMeasDevice::getDescriptors()
+const PowerMeasHistory* PowerMeasDevice::getHistory(uint8_t index) const
 {
-    return m_descriptors;
+    if (index >= m_descriptorCount)
+        return nullptr;
+    return m_history[index];
+}
+
+void PowerMeasDevice::releaseHistory()
+{
+    for(uint8_t i = 0; i < MAX_DESCRIPTORS; i++)
+    {
+        delete m_history[i];
+        m_history[i] = nullptr;
+    }
+    m_historyFailed = false;
 }
 
 String PowerMeasDevice::exportDescriptorsToJSON()
 {
-    String result = "{\"power_meas\":[";
-    for(size_t i = 0; i < m_descriptors.size(); i++)
+    String result;
+    uint8_t count = getDescriptorCount();
+    result.reserve(32 + count * 128);
+    result += "{\"power_meas\":[";
+    for(uint8_t i = 0; i < count; i++)
     {
-        result = result + "{";
-        result = result + "\"description\":\"" + m_descriptors[i].description + "\",";
-        result = result + "\"unit\":\"" + m_descriptors[i].unit + "\",";
-        result = result + "\"valueFormat\":\"" + m_descriptors[i].valueFormat + "\",";
-        result = result + "\"lastValue\":" + String(m_descriptors[i].lastValue) + ",";
-        result = result + "\"minValue\":" + String(m_descriptors[i].minValue) + ",";
-        result = result + "\"maxValue\":" + String(m_descriptors[i].maxValue);
-        result = result + "}";
-        if (i < (m_descriptors.size() - 1))
-            result = result + ",";
+        result += "{\"description\":\"";
+        result += getDescription(i);
+        result += "\",\"unit\":\"";
+        result += getUnit(i);
+        result += "\",\"valueFormat\":\"";
+        result += getValueFormat(i);
+        result += "\",\"lastValue\":";
+        result += String(m_lastValues[i]);
+        result += ",\"minValue\":";
+        result += String(m_minValues[i]);
+        result += ",\"maxValue\":";
+        result += String(m_maxValues[i]);
+        result += "}";
+        if (i < (count - 1))
+            result += ",";
     }
-    result = result + "]}";
+    result += "]}";
     return result;
 }
 
 void PowerMeasDevice::resetMinMax()
 {
-    for(size_t i = 0; i < m_descriptors.size(); i++)
-    {
-        m_descriptors[i].maxValue = 0;
-        m_descriptors[i].minValue = 0;
-    }
+    memset(m_minValues, 0, sizeof(m_minValues));
+    memset(m_maxValues, 0, sizeof(m_maxValues));
 }
 
 String PowerMeasDevice::getConfiguration()
@@ -69,57 +160,151 @@ void PowerMeasDevice::setConfiguration(String config, bool save, bool performIni
 
 }
 
-PowerMeasDevice::ValueDescriptor PowerMeasDevice::createEmptyDescriptor()
-{
-    ValueDescriptor desc;
-    desc.index = 0;
-    desc.description = "Invalid";
-    desc.unit = "-";
-    desc.valueFormat = "";
-    desc.lastValue = 0;
-    desc.minValue = 0;
-    desc.maxValue = 0;
-    desc.mqttTopic = "invalid";
-    desc.mqttPublish = true;
-    return desc;
-}
-
 void PowerMeasDevice::init()
 {
 
 }
 
-void PowerMeasDevice::appendDescriptor(String description, String unit, String valueFormat, String mqttTopic, bool mqttPublish)
+void PowerMeasDevice::setDescriptors(const DescriptorInfo* table, uint8_t count)
 {
-    ValueDescriptor desc;
-    desc.index = m_descriptors.size();
-    desc.description = description;
-    desc.unit = unit;
-    desc.valueFormat = valueFormat;
-    desc.lastValue = 0;
-    desc.minValue = 0;
-    desc.maxValue = 0;
-    desc.mqttTopic = mqttTopic;
-    desc.mqttPublish = mqttPublish;
-    m_descriptors.push_back(desc);
+    if (count > MAX_DESCRIPTORS)
+    {
+        Log::error("PowerMeas", "Too many value descriptors %d, limited to %d", count, MAX_DESCRIPTORS);
+        count = MAX_DESCRIPTORS;
+    }
+    m_descriptorTable = table;
+    m_descriptorCount = count;
 }
 
 void PowerMeasDevice::setLastValue(uint8_t index, float lastValue, bool updateMinMax)
 {
-    if (index < m_descriptors.size())
+    if (index < m_descriptorCount)
     {
-        m_descriptors[index].lastValue = lastValue;
-        if (updateMinMax)
+        uint32_t now = (uint32_t)Time::nowRelativeMilli();
+        if ((m_history[index] == nullptr) && !m_historyFailed && (&PowerMeas::getActiveDeviceDriver() == this))
+        {
+            m_history[index] = new (std::nothrow) PowerMeasHistory;
+            if (m_history[index] == nullptr)
+            {
+                // Not retried, device keeps measuring without history of the rest
+                m_historyFailed = true;
+                Log::error("PowerMeas", "Unable to allocate history of value %d, %d bytes", index, sizeof(PowerMeasHistory));
+            }
+        }
+        if (m_history[index] != nullptr)
+            m_history[index]->addSample(now, lastValue);
+        storeValue(index, lastValue, updateMinMax);
+        for(uint8_t i = 0; i < m_filterCount; i++)
         {
-            if (lastValue > m_descriptors[index].maxValue)
-                m_descriptors[index].maxValue = lastValue;
-            if (lastValue < m_descriptors[index].minValue)
-                m_descriptors[index].minValue = lastValue;
+            if (m_filters[i].sourceIndex == index)
+                storeValue(m_descriptorCount + i, m_filters[i].filter.process(lastValue, now), updateMinMax);
         }
+        m_updateCount++;
+    }
+}
+
+void PowerMeasDevice::storeValue(uint8_t index, float value, bool updateMinMax)
+{
+    m_lastValues[index] = value;
+    if (updateMinMax)
+    {
+        if (value > m_maxValues[index])
+            m_maxValues[index] = value;
+        if (value < m_minValues[index])
+            m_minValues[index] = value;
+    }
+}
+
+void PowerMeasDevice::clearFilters()
+{
+    m_filterCount = 0;
+}
+
+bool PowerMeasDevice::addFilter(uint8_t sourceIndex, PowerMeasFilter::Type type, uint8_t window, float alpha, const char* name, bool mqttPublish)
+{
+    if ((m_filterCount >= MAX_FILTERS) || (sourceIndex >= m_descriptorCount) || (type == PowerMeasFilter::FLT_NONE))
+        return false;
+    if (m_filters == nullptr)
+    {
+        m_filters = new FilterChannel[MAX_FILTERS];
+        Log::info("PowerMeas", "Filters allocated, %d bytes", sizeof(FilterChannel) * MAX_FILTERS);
     }
+    FilterChannel& channel = m_filters[m_filterCount];
+    const DescriptorInfo* source = getDescriptorInfo(sourceIndex);
+    channel.sourceIndex = sourceIndex;
+    channel.filter.configure(type, window, alpha);
+    memset(&channel.info, 0, sizeof(channel.info));
+    snprintf(channel.info.description, sizeof(channel.info.description), "%s %s", name, PowerMeasFilter::typeToString(type));
+    if (type == PowerMeasFilter::FLT_RATE)
+        strncpy(channel.info.unit, "/s", sizeof(channel.info.unit) - 1);
+    else
+        strncpy_P(channel.info.unit, source->unit, sizeof(channel.info.unit) - 1);
+    strncpy_P(channel.info.valueFormat, source->valueFormat, sizeof(channel.info.valueFormat) - 1);
+    strncpy(channel.info.mqttTopic, name, sizeof(channel.info.mqttTopic) - 1);
+    channel.info.mqttPublish = mqttPublish;
+    uint8_t index = m_descriptorCount + m_filterCount;
+    m_lastValues[index] = 0;
+    m_minValues[index] = 0;
+    m_maxValues[index] = 0;
+    // Published last, value arrays are ready when readers see the new descriptor
+    m_filterCount++;
+    return true;
+}
+
+uint8_t PowerMeasDevice::getFilterCount() const
+{
+    return m_filterCount;
 }
 
 void PowerMeasDevice::process()
 {
 
+}
+
+void PowerMeasDevice::setFastRefresh(bool fast)
+{
+    m_fastRefresh = fast;
+}
+
+bool PowerMeasDevice::isFastRefresh() const
+{
+    return m_fastRefresh;
+}
+
+uint32_t PowerMeasDevice::getRefreshPeriod(uint32_t idlePeriodMilli, uint32_t fastPeriodMilli) const
+{
+    if (m_fastRefresh && (fastPeriodMilli < idlePeriodMilli))
+        return fastPeriodMilli;
+    return idlePeriodMilli;
+}
+
+void PowerMeasDevice::setSampleListener(SampleListener listener)
+{
+    m_sampleListener = listener;
+}
+
+uint64_t PowerMeasDevice::getLastSampleTime() const
+{
+    return m_lastSampleTime;
+}
+
+void PowerMeasDevice::setValueListener(ValueListener listener)
+{
+    m_valueListener = listener;
+}
+
+void PowerMeasDevice::emitSample(uint64_t sampleTimeMilli)
+{
+    if (sampleTimeMilli > m_lastSampleTime)
+        m_lastSampleTime = sampleTimeMilli;
+    if (m_sampleListener)
+        m_sampleListener(*this, m_lastSampleTime);
+}
+
+void PowerMeasDevice::emitValue(uint8_t index, uint64_t sampleTimeMilli)
+{
+    if (sampleTimeMilli > m_lastSampleTime)
+        m_lastSampleTime = sampleTimeMilli;
+    if (m_valueListener)
+        m_valueListener(*this, index, m_lastSampleTime);
 }
\ No newline at end of file
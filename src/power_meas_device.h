@@ -1,36 +1,75 @@
 #pragma once
 #include <Arduino.h>
 #include <stdint.h>
-#include <vector>
+#include "power_meas_history.h"
+#include "power_meas_filter.h"
 
 class PowerMeasDevice
 {
 public:
 
-    struct ValueDescriptor
+    static constexpr uint8_t MAX_DESCRIPTORS = 16;
+    // Filtered values are appended after driver values as virtual descriptors
+    static constexpr uint8_t MAX_FILTERS = 8;
+    static constexpr uint8_t MAX_VALUES = MAX_DESCRIPTORS + MAX_FILTERS;
+
+    // Value metadata, drivers keep tables of these in flash (PROGMEM)
+    struct DescriptorInfo
     {
-        uint8_t index;
-        String description;
-        String unit;
-        String valueFormat;
-        float lastValue;
-        float maxValue;
-        float minValue;
-        String mqttTopic;
-        String mqttPublish;
+        char description[24];
+        char unit[4];
+        char valueFormat[6];
+        char mqttTopic[20];
+        bool mqttPublish;
     };
 
+    // Called by driver for every completed reading, time is when values were sampled
+    typedef void (*SampleListener)(const PowerMeasDevice& device, uint64_t sampleTimeMilli);
+
+    // Called when a single value is updated between readings (capture RMS)
+    typedef void (*ValueListener)(const PowerMeasDevice& device, uint8_t index, uint64_t sampleTimeMilli);
+
     PowerMeasDevice();
 
     virtual void init();
 
     virtual String getChipInfo() const;
 
-    uint8_t getDescriptorCount();
+    // Driver values followed by filtered values
+    uint8_t getDescriptorCount() const;
+
+    const __FlashStringHelper* getDescription(uint8_t index) const;
+
+    const __FlashStringHelper* getUnit(uint8_t index) const;
+
+    const __FlashStringHelper* getValueFormat(uint8_t index) const;
+
+    const __FlashStringHelper* getMqttTopic(uint8_t index) const;
+
+    bool isMqttPublished(uint8_t index) const;
+
+    const float& getLastValue(uint8_t index) const;
+
+    const float& getMinValue(uint8_t index) const;
+
+    const float& getMaxValue(uint8_t index) const;
+
+    // Incremented with every measured value
+    uint32_t getUpdateCount() const;
+
+    // History is kept for the active device only. Returns nullptr until first value
+    // is measured or when there was no memory for it, filtered values have no history.
+    const PowerMeasHistory* getHistory(uint8_t index) const;
+
+    // Called when device stops being the active one
+    void releaseHistory();
+
+    void clearFilters();
 
-    ValueDescriptor getDescriptor(uint8_t index);
+    // Adds filtered value of source descriptor, name is used as MQTT topic
+    bool addFilter(uint8_t sourceIndex, PowerMeasFilter::Type type, uint8_t window, float alpha, const char* name, bool mqttPublish);
 
-    ::std::vector<ValueDescriptor> getDescriptors();
+    uint8_t getFilterCount() const;
 
     String exportDescriptorsToJSON();
 
@@ -42,18 +81,66 @@ public:
 
     virtual void process();
 
+    // Drivers read at the fastest rate the chip allows while the motor runs
+    void setFastRefresh(bool fast);
+
+    bool isFastRefresh() const;
+
+    void setSampleListener(SampleListener listener);
+
+    void setValueListener(ValueListener listener);
+
+    uint64_t getLastSampleTime() const;
+
 protected:
 
-    ValueDescriptor createEmptyDescriptor();
+    // Drivers call this when all values of one reading are set. Sample time
+    // never goes back, hold timers of conditions rely on it.
+    void emitSample(uint64_t sampleTimeMilli);
 
-    void appendDescriptor(String description, String unit, String valueFormat, String mqttTopic, bool mqttPublish = true);
+    // Reports one value updated out of reading cycle
+    void emitValue(uint8_t index, uint64_t sampleTimeMilli);
 
-    void setLastValue(uint8_t index, float lastValue, bool updateMinMax = true);
+    // Returns refresh period of the current profile
+    uint32_t getRefreshPeriod(uint32_t idlePeriodMilli, uint32_t fastPeriodMilli) const;
+
+    void setDescriptors(const DescriptorInfo* table, uint8_t count);
 
-    ::std::vector<ValueDescriptor> m_descriptors;
+    void setLastValue(uint8_t index, float lastValue, bool updateMinMax = true);
 
 private:
 
+    struct FilterChannel
+    {
+        PowerMeasFilter filter;
+        uint8_t sourceIndex;
+        // Metadata in RAM, built when filter is added
+        DescriptorInfo info;
+    };
+
+    static const DescriptorInfo* getInvalidDescriptor();
+
+    void storeValue(uint8_t index, float value, bool updateMinMax);
+
+    const DescriptorInfo* getDescriptorInfo(uint8_t index) const;
+
     bool m_enabled;
+    bool m_fastRefresh;
+    const DescriptorInfo* m_descriptorTable;
+    uint8_t m_descriptorCount;
+    // Struct of arrays, values of one kind are kept together
+    float m_lastValues[MAX_VALUES];
+    float m_minValues[MAX_VALUES];
+    float m_maxValues[MAX_VALUES];
+    // Allocated when the first filter is added to the device
+    FilterChannel* m_filters;
+    uint8_t m_filterCount;
+    uint32_t m_updateCount;
+    uint64_t m_lastSampleTime;
+    SampleListener m_sampleListener;
+    ValueListener m_valueListener;
+    // Allocated per value with its first sample, about 1.4 kB each on ESP8266
+    PowerMeasHistory* m_history[MAX_DESCRIPTORS];
+    bool m_historyFailed;
 
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "power_meas_filter.h"
+#include <math.h>
+
+PowerMeasFilter::PowerMeasFilter() :
+    m_type(FLT_NONE),
+    m_window(1),
+    m_alpha(1)
+{
+    reset();
+}
+
+void PowerMeasFilter::configure(Type type, uint8_t window, float alpha)
+{
+    m_type = type;
+    if (window < 1)
+        window = 1;
+    if (window > MAX_WINDOW)
+        window = MAX_WINDOW;
+    m_window = window;
+    if ((alpha <= 0) || (alpha > 1))
+        alpha = 1;
+    m_alpha = alpha;
+    reset();
+}
+
+PowerMeasFilter::Type PowerMeasFilter::getType() const
+{
+    return m_type;
+}
+
+void PowerMeasFilter::reset()
+{
+    m_head = 0;
+    m_count = 0;
+    m_sum = 0;
+    m_output = 0;
+    m_lastValue = 0;
+    m_lastTime = 0;
+}
+
+float PowerMeasFilter::processMedian(float value)
+{
+    uint8_t count = m_count;
+    if (count == m_window)
+    {
+        // Drop the oldest value from the sorted copy
+        float oldest = m_ring[m_head];
+        uint8_t i = 0;
+        while ((i < count - 1) && (m_sorted[i] != oldest))
+            i++;
+        for(; i < count - 1; i++)
+            m_sorted[i] = m_sorted[i + 1];
+        count--;
+    }
+    uint8_t i = count;
+    while ((i > 0) && (m_sorted[i - 1] > value))
+    {
+        m_sorted[i] = m_sorted[i - 1];
+        i--;
+    }
+    m_sorted[i] = value;
+    count++;
+    if ((count & 1) != 0)
+        return m_sorted[count / 2];
+    return (m_sorted[count / 2 - 1] + m_sorted[count / 2]) / 2;
+}
+
+float PowerMeasFilter::process(float value, uint32_t timeMilli)
+{
+    if (isnan(value))
+        return m_output;
+    switch(m_type)
+    {
+        case FLT_EMA:
+            if (m_count == 0)
+                m_output = value;
+            else
+                m_output += m_alpha * (value - m_output);
+            m_count = 1;
+            break;
+        case FLT_MEDIAN:
+            m_output = processMedian(value);
+            break;
+        case FLT_AVERAGE:
+            if (m_count == m_window)
+                m_sum -= m_ring[m_head];
+            m_sum += value;
+            m_output = m_sum / ((m_count == m_window) ? m_count : (m_count + 1));
+            break;
+        case FLT_RATE:
+            if ((m_count > 0) && (timeMilli != m_lastTime))
+                m_output = (value - m_lastValue) * 1000 / (float)(uint32_t)(timeMilli - m_lastTime);
+            m_lastValue = value;
+            m_lastTime = timeMilli;
+            m_count = 1;
+            break;
+        default:
+            m_output = value;
+            break;
+    }
+    if ((m_type == FLT_MEDIAN) || (m_type == FLT_AVERAGE))
+    {
+        m_ring[m_head] = value;
+        m_head = (m_head + 1) % m_window;
+        if (m_count < m_window)
+            m_count++;
+    }
+    return m_output;
+}
+
+const char* PowerMeasFilter::typeToString(Type type)
+{
+    switch(type)
+    {
+        case FLT_EMA:
+            return "ema";
+        case FLT_MEDIAN:
+            return "median";
+        case FLT_AVERAGE:
+            return "average";
+        case FLT_RATE:
+            return "rate";
+        default:
+            return "none";
+    }
+}
+
+PowerMeasFilter::Type PowerMeasFilter::stringToType(const String& type)
+{
+    if (type == "ema")
+        return FLT_EMA;
+    else if (type == "median")
+        return FLT_MEDIAN;
+    else if (type == "average")
+        return FLT_AVERAGE;
+    else if (type == "rate")
+        return FLT_RATE;
+    return FLT_NONE;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+
+// Streaming filter of one measured value, state is kept in a fixed ring buffer
+class PowerMeasFilter
+{
+public:
+
+    static constexpr uint8_t MAX_WINDOW = 16;
+
+    enum Type
+    {
+        FLT_NONE = 0,
+        FLT_EMA,
+        FLT_MEDIAN,
+        FLT_AVERAGE,
+        FLT_RATE
+    };
+
+    PowerMeasFilter();
+
+    // Window is used by median and moving average, alpha by EMA
+    void configure(Type type, uint8_t window, float alpha);
+
+    Type getType() const;
+
+    void reset();
+
+    // Returns filtered value, rate is per second
+    float process(float value, uint32_t timeMilli);
+
+    static const char* typeToString(Type type);
+
+    static Type stringToType(const String& type);
+
+private:
+
+    float processMedian(float value);
+
+    Type m_type;
+    uint8_t m_window;
+    float m_alpha;
+    float m_ring[MAX_WINDOW];
+    // Median keeps window values also sorted
+    float m_sorted[MAX_WINDOW];
+    uint8_t m_head;
+    uint8_t m_count;
+    float m_sum;
+    float m_output;
+    float m_lastValue;
+    uint32_t m_lastTime;
+};
@@ -0,0 +1,180 @@
+#include "power_meas_history.h"
+
+static const uint32_t TIER_PERIOD_MILLI[PowerMeasHistory::TIER_COUNT] = { PowerMeasHistory::RAW_SPACING_MILLI, 10 * 1000, 60 * 1000 };
+static const uint16_t TIER_CAPACITY[PowerMeasHistory::TIER_COUNT] = { PowerMeasHistory::RAW_CAPACITY, 
+    PowerMeasHistory::BUCKET_10S_CAPACITY, PowerMeasHistory::BUCKET_1MIN_CAPACITY };
+
+PowerMeasHistory::PowerMeasHistory() :
+    m_rawHead(0),
+    m_rawCount(0)
+{
+    memset(m_rings, 0, sizeof(m_rings));
+    uint16_t offset = 0;
+    for(uint8_t i = 0; i < TIER_COUNT - 1; i++)
+    {
+        m_rings[i].offset = offset;
+        m_rings[i].capacity = TIER_CAPACITY[i + 1];
+        offset += m_rings[i].capacity;
+    }
+}
+
+uint32_t PowerMeasHistory::getTierPeriodMilli(Tier tier)
+{
+    if (tier < TIER_COUNT)
+        return TIER_PERIOD_MILLI[tier];
+    return 0;
+}
+
+uint16_t PowerMeasHistory::getTierCapacity(Tier tier)
+{
+    if (tier < TIER_COUNT)
+        return TIER_CAPACITY[tier];
+    return 0;
+}
+
+const char* PowerMeasHistory::tierToString(Tier tier)
+{
+    switch(tier)
+    {
+        case TIER_RAW:
+            return "raw";
+        case TIER_10S:
+            return "10s";
+        case TIER_1MIN:
+            return "1min";
+        default:
+            break;
+    }
+    return "raw";
+}
+
+PowerMeasHistory::Tier PowerMeasHistory::stringToTier(const String& tier)
+{
+    if (tier == "10s")
+        return TIER_10S;
+    else if (tier == "1min")
+        return TIER_1MIN;
+    return TIER_RAW;
+}
+
+void PowerMeasHistory::addSample(uint32_t timeMilli, float value)
+{
+    const RawSample& last = m_raw[(m_rawHead + RAW_CAPACITY - 1) % RAW_CAPACITY];
+    if ((m_rawCount == 0) || (timeMilli - last.timeMilli >= RAW_SPACING_MILLI))
+    {
+        m_raw[m_rawHead].timeMilli = timeMilli;
+        m_raw[m_rawHead].value = value;
+        m_rawHead = (m_rawHead + 1) % RAW_CAPACITY;
+        if (m_rawCount < RAW_CAPACITY)
+            m_rawCount++;
+    }
+    for(uint8_t i = 0; i < TIER_COUNT - 1; i++)
+        addToRing(m_rings[i], TIER_PERIOD_MILLI[i + 1], timeMilli, value);
+}
+
+void PowerMeasHistory::pushBucket(BucketRing& ring, const Bucket& bucket)
+{
+    m_buckets[ring.offset + ring.head] = bucket;
+    ring.head = (ring.head + 1) % ring.capacity;
+    if (ring.count < ring.capacity)
+        ring.count++;
+}
+
+void PowerMeasHistory::addToRing(BucketRing& ring, uint32_t period, uint32_t timeMilli, float value)
+{
+    uint32_t bucketId = timeMilli / period;
+    if ((ring.sampleCount != 0) && (bucketId != ring.bucketId))
+    {
+        Bucket bucket;
+        bucket.minValue = ring.minValue;
+        bucket.maxValue = ring.maxValue;
+        bucket.avgValue = ring.sum / ring.sampleCount;
+        pushBucket(ring, bucket);
+        // Periods without samples are kept as empty buckets
+        uint32_t gap = bucketId - ring.bucketId - 1;
+        if (gap > ring.capacity)
+            gap = ring.capacity;
+        Bucket empty = { NAN, NAN, NAN };
+        for(uint32_t i = 0; i < gap; i++)
+            pushBucket(ring, empty);
+        ring.sampleCount = 0;
+    }
+    if (ring.sampleCount == 0)
+    {
+        ring.bucketId = bucketId;
+        ring.minValue = value;
+        ring.maxValue = value;
+        ring.sum = 0;
+    }
+    if (value < ring.minValue)
+        ring.minValue = value;
+    if (value > ring.maxValue)
+        ring.maxValue = value;
+    ring.sum += value;
+    ring.sampleCount++;
+}
+
+uint16_t PowerMeasHistory::getRawStart(uint32_t now) const
+{
+    // Samples are ordered by time, skip the ones older than raw window
+    uint16_t start = 0;
+    while (start < m_rawCount)
+    {
+        const RawSample& raw = m_raw[(m_rawHead + RAW_CAPACITY - m_rawCount + start) % RAW_CAPACITY];
+        if ((now - raw.timeMilli) <= RAW_WINDOW_MILLI)
+            break;
+        start++;
+    }
+    return start;
+}
+
+uint16_t PowerMeasHistory::getSampleCount(Tier tier, uint32_t now) const
+{
+    if (tier == TIER_RAW)
+        return m_rawCount - getRawStart(now);
+    if (tier < TIER_COUNT)
+    {
+        const BucketRing& ring = m_rings[tier - 1];
+        return ring.count + ((ring.sampleCount != 0) ? 1 : 0);
+    }
+    return 0;
+}
+
+bool PowerMeasHistory::getSample(Tier tier, uint16_t index, uint32_t now, Sample& sample) const
+{
+    if (tier == TIER_RAW)
+    {
+        uint16_t start = getRawStart(now);
+        if (index >= (m_rawCount - start))
+            return false;
+        const RawSample& raw = m_raw[(m_rawHead + RAW_CAPACITY - m_rawCount + start + index) % RAW_CAPACITY];
+        sample.timeMilli = raw.timeMilli;
+        sample.minValue = raw.value;
+        sample.avgValue = raw.value;
+        sample.maxValue = raw.value;
+        return true;
+    }
+    if (tier >= TIER_COUNT)
+        return false;
+    const BucketRing& ring = m_rings[tier - 1];
+    uint32_t period = TIER_PERIOD_MILLI[tier];
+    if (index < ring.count)
+    {
+        const Bucket& bucket = m_buckets[ring.offset + (ring.head + ring.capacity - ring.count + index) % ring.capacity];
+        sample.timeMilli = (ring.bucketId - ring.count + index) * period;
+        sample.minValue = bucket.minValue;
+        sample.avgValue = bucket.avgValue;
+        sample.maxValue = bucket.maxValue;
+        return true;
+    }
+    if ((index == ring.count) && (ring.sampleCount != 0))
+    {
+        // Bucket being filled
+        sample.timeMilli = ring.bucketId * period;
+        sample.minValue = ring.minValue;
+        sample.avgValue = ring.sum / ring.sampleCount;
+        sample.maxValue = ring.maxValue;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+
+// Fixed memory history of one measured value, raw samples for the last minute
+// and min/avg/max buckets of 10 s and 1 min (the last hour)
+class PowerMeasHistory
+{
+public:
+
+    enum Tier
+    {
+        TIER_RAW = 0,
+        TIER_10S,
+        TIER_1MIN,
+        TIER_COUNT
+    };
+
+    struct Sample
+    {
+        uint32_t timeMilli;
+        float minValue;
+        float avgValue;
+        float maxValue;
+    };
+
+#ifdef ESP32
+    static constexpr uint16_t RAW_CAPACITY = 128;
+    static constexpr uint16_t BUCKET_10S_CAPACITY = 60;
+#else
+    static constexpr uint16_t RAW_CAPACITY = 32;
+    static constexpr uint16_t BUCKET_10S_CAPACITY = 30;
+#endif
+    static constexpr uint16_t BUCKET_1MIN_CAPACITY = 60;
+    static constexpr uint32_t RAW_WINDOW_MILLI = 60 * 1000;
+    // Faster samples are skipped so raw tier always spans the whole window
+    static constexpr uint32_t RAW_SPACING_MILLI = RAW_WINDOW_MILLI / RAW_CAPACITY;
+
+    PowerMeasHistory();
+
+    void addSample(uint32_t timeMilli, float value);
+
+    // Number of samples available for the tier, oldest sample has index 0
+    uint16_t getSampleCount(Tier tier, uint32_t now) const;
+
+    bool getSample(Tier tier, uint16_t index, uint32_t now, Sample& sample) const;
+
+    // Raw tier reports minimal spacing of samples
+    static uint32_t getTierPeriodMilli(Tier tier);
+
+    static uint16_t getTierCapacity(Tier tier);
+
+    static const char* tierToString(Tier tier);
+
+    static Tier stringToTier(const String& tier);
+
+private:
+
+    struct RawSample
+    {
+        uint32_t timeMilli;
+        float value;
+    };
+
+    struct Bucket
+    {
+        float minValue;
+        float avgValue;
+        float maxValue;
+    };
+
+    struct BucketRing
+    {
+        // Part of m_buckets owned by the tier
+        uint16_t offset;
+        uint16_t capacity;
+        uint16_t head;
+        uint16_t count;
+        // Bucket being filled
+        uint32_t bucketId;
+        float minValue;
+        float maxValue;
+        float sum;
+        uint16_t sampleCount;
+    };
+
+    void addToRing(BucketRing& ring, uint32_t period, uint32_t timeMilli, float value);
+
+    void pushBucket(BucketRing& ring, const Bucket& bucket);
+
+    uint16_t getRawStart(uint32_t now) const;
+
+    RawSample m_raw[RAW_CAPACITY];
+    uint16_t m_rawHead;
+    uint16_t m_rawCount;
+    BucketRing m_rings[TIER_COUNT - 1];
+    Bucket m_buckets[BUCKET_10S_CAPACITY + BUCKET_1MIN_CAPACITY];
+};
@@ -0,0 +1,220 @@
+#include "power_meas_register_device.h"
+#include <math.h>
+#include "power_meas_capture.h"
+#include "time.h"
+#include "log.h"
+
+PowerMeasRegisterDevice::PowerMeasRegisterDevice() :
+    PowerMeasDevice(),
+    m_registerMap(nullptr),
+    m_registerCount(0),
+    m_factors(nullptr),
+    m_queueHead(0),
+    m_queueCount(0),
+    m_readCycle(0),
+    m_pendingReads(0),
+    m_batchFailed(false),
+    m_batchTimestamp(0),
+    m_captureGeneration(0)
+{
+
+}
+
+float PowerMeasRegisterDevice::scaleLinear(int32_t raw, float factor)
+{
+    return (float)raw * factor;
+}
+
+float PowerMeasRegisterDevice::scaleAbsolute(int32_t raw, float factor)
+{
+    return fabsf((float)raw * factor);
+}
+
+void PowerMeasRegisterDevice::setRegisterMap(const RegisterInfo* map, uint8_t count, const float* factors)
+{
+    m_registerMap = map;
+    m_registerCount = count;
+    m_factors = factors;
+}
+
+const PowerMeasRegisterDevice::RegisterInfo* PowerMeasRegisterDevice::findRegister(uint16_t address) const
+{
+    for(uint8_t i = 0; i < m_registerCount; i++)
+    {
+        if (m_registerMap[i].address == address)
+            return &m_registerMap[i];
+    }
+    return nullptr;
+}
+
+uint8_t PowerMeasRegisterDevice::getRegisterWidth(uint16_t address) const
+{
+    const RegisterInfo* info = findRegister(address);
+    return info ? info->width : 0;
+}
+
+bool PowerMeasRegisterDevice::isGroupRegister(uint16_t address) const
+{
+    const RegisterInfo* info = findRegister(address);
+    return info && (info->flags & REG_GROUP);
+}
+
+int32_t PowerMeasRegisterDevice::decodeRaw(uint16_t address, uint32_t raw) const
+{
+    const RegisterInfo* info = findRegister(address);
+    if (!info || !(info->flags & REG_SIGNED) || (info->width >= 4))
+        return (int32_t)raw;
+    uint8_t shift = 32 - 8 * info->width;
+    return (int32_t)(raw << shift) >> shift;
+}
+
+bool PowerMeasRegisterDevice::pushRequest(uint16_t reg, bool write, int32_t value)
+{
+    if (!findRegister(reg))
+    {
+        Log::error(getChipInfo().c_str(), "Unknown register 0x%x, request dropped", reg);
+        return false;
+    }
+    if (m_queueCount >= REQUEST_QUEUE_SIZE)
+    {
+        Log::error(getChipInfo().c_str(), "Request queue full, register 0x%x %s dropped", reg, write ? "write" : "read");
+        return false;
+    }
+    Request& request = m_queue[(m_queueHead + m_queueCount) % REQUEST_QUEUE_SIZE];
+    request.reg = reg;
+    request.write = write;
+    request.value = value;
+    m_queueCount++;
+    return true;
+}
+
+bool PowerMeasRegisterDevice::queueWrite(uint16_t reg, int32_t value)
+{
+    return pushRequest(reg, true, value);
+}
+
+bool PowerMeasRegisterDevice::queueRead(uint16_t reg)
+{
+    return pushRequest(reg, false, 0);
+}
+
+void PowerMeasRegisterDevice::popRequest()
+{
+    if (m_queueCount > 0)
+    {
+        m_queueHead = (m_queueHead + 1) % REQUEST_QUEUE_SIZE;
+        m_queueCount--;
+    }
+}
+
+void PowerMeasRegisterDevice::clearRequests()
+{
+    m_queueHead = 0;
+    m_queueCount = 0;
+    m_pendingReads = 0;
+}
+
+uint8_t PowerMeasRegisterDevice::getRequestCount() const
+{
+    return m_queueCount;
+}
+
+const PowerMeasRegisterDevice::Request& PowerMeasRegisterDevice::getRequest(uint8_t offset) const
+{
+    return m_queue[(m_queueHead + offset) % REQUEST_QUEUE_SIZE];
+}
+
+void PowerMeasRegisterDevice::scheduleReads(uint64_t sampleTimeMilli)
+{
+    m_pendingReads = 0;
+    m_batchFailed = false;
+    m_batchTimestamp = sampleTimeMilli;
+    for(uint8_t i = 0; i < m_registerCount; i++)
+    {
+        const RegisterInfo& info = m_registerMap[i];
+        if ((info.cadence == 0) || ((m_readCycle % info.cadence) != 0))
+            continue;
+        if (queueRead(info.address))
+            m_pendingReads++;
+    }
+    m_readCycle++;
+}
+
+bool PowerMeasRegisterDevice::isBatchPending() const
+{
+    return m_pendingReads > 0;
+}
+
+bool PowerMeasRegisterDevice::storeRegister(uint16_t address, int32_t value)
+{
+    const RegisterInfo* info = findRegister(address);
+    if (!info || !info->scale)
+        return false;
+    if (info->flags & REG_CAPTURE)
+    {
+        float sample = info->scale(value, m_factors ? m_factors[info->factorIndex] : 1);
+        if (PowerMeasCapture::addSample(*this, sample) && (info->descriptor != NO_DESCRIPTOR))
+        {
+            // Other values are unchanged, only conditions on RMS are evaluated
+            setLastValue(info->descriptor, PowerMeasCapture::getRms());
+            emitValue(info->descriptor, Time::nowRelativeMilli());
+        }
+        return true;
+    }
+    if (info->descriptor == NO_DESCRIPTOR)
+        return false;
+    setLastValue(info->descriptor, info->scale(value, m_factors ? m_factors[info->factorIndex] : 1));
+    if (info->cadence > 0)
+        finishRead();
+    return true;
+}
+
+void PowerMeasRegisterDevice::onReadError(uint16_t address)
+{
+    const RegisterInfo* info = findRegister(address);
+    if (info && (info->cadence > 0))
+    {
+        m_batchFailed = true;
+        finishRead();
+    }
+}
+
+void PowerMeasRegisterDevice::finishRead()
+{
+    if (m_pendingReads == 0)
+        return;
+    m_pendingReads--;
+    if ((m_pendingReads == 0) && !m_batchFailed)
+        emitSample(m_batchTimestamp);
+}
+
+bool PowerMeasRegisterDevice::queueCaptureRead()
+{
+    uint8_t channel;
+    if (!PowerMeasCapture::isCapturing(*this, channel))
+        return false;
+    const RegisterInfo* info = findCaptureRegister(channel);
+    if (!info)
+        return false;
+    if (m_captureGeneration != PowerMeasCapture::getGeneration())
+    {
+        // RMS of previous step must not trigger conditions of this one
+        m_captureGeneration = PowerMeasCapture::getGeneration();
+        if (info->descriptor != NO_DESCRIPTOR)
+            setLastValue(info->descriptor, 0);
+    }
+    return queueRead(info->address);
+}
+
+const PowerMeasRegisterDevice::RegisterInfo* PowerMeasRegisterDevice::findCaptureRegister(uint8_t channel) const
+{
+    for(uint8_t i = 0; i < m_registerCount; i++)
+    {
+        if (!(m_registerMap[i].flags & REG_CAPTURE))
+            continue;
+        if (channel == 0)
+            return &m_registerMap[i];
+        channel--;
+    }
+    return nullptr;
+}
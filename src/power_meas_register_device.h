@@ -0,0 +1,119 @@
+#pragma once
+#include "power_meas_device.h"
+
+// Base of metering chip drivers described by constexpr register tables. Drivers
+// keep bus framing and init sequence, the engine queues batched reads of polled
+// registers, converts raw values and updates descriptors.
+class PowerMeasRegisterDevice : public PowerMeasDevice
+{
+public:
+
+    // Converts sign extended raw value, factor is taken from driver calibration
+    typedef float (*ScaleFunction)(int32_t raw, float factor);
+
+    enum RegisterFlags
+    {
+        REG_SIGNED = 0x01,
+        // Adjacent group registers may share one bus transaction
+        REG_GROUP = 0x02,
+        // Instantaneous waveform register of capture, one per channel in table
+        // order, its descriptor receives the window RMS
+        REG_CAPTURE = 0x04
+    };
+
+    static constexpr uint8_t NO_DESCRIPTOR = 0xff;
+
+    struct RegisterInfo
+    {
+        uint16_t address;
+        // Bytes on the bus
+        uint8_t width;
+        uint8_t flags;
+        // Control registers have no scale function
+        ScaleFunction scale;
+        uint8_t factorIndex;
+        uint8_t descriptor;
+        // Read every n-th refresh, 0 = not polled
+        uint8_t cadence;
+    };
+
+    PowerMeasRegisterDevice();
+
+    static float scaleLinear(int32_t raw, float factor);
+
+    static float scaleAbsolute(int32_t raw, float factor);
+
+protected:
+
+    static constexpr uint8_t REQUEST_QUEUE_SIZE = 16;
+
+    struct Request
+    {
+        uint16_t reg;
+        bool write;
+        int32_t value;
+    };
+
+    // Factors are owned by the driver and may change with calibration
+    void setRegisterMap(const RegisterInfo* map, uint8_t count, const float* factors);
+
+    const RegisterInfo* findRegister(uint16_t address) const;
+
+    uint8_t getRegisterWidth(uint16_t address) const;
+
+    bool isGroupRegister(uint16_t address) const;
+
+    // Extends sign of signed registers narrower than 32 bits
+    int32_t decodeRaw(uint16_t address, uint32_t raw) const;
+
+    bool queueWrite(uint16_t reg, int32_t value);
+
+    bool queueRead(uint16_t reg);
+
+    void popRequest();
+
+    void clearRequests();
+
+    uint8_t getRequestCount() const;
+
+    // Offset from the oldest queued request
+    const Request& getRequest(uint8_t offset) const;
+
+    // Queues polled registers due in this refresh cycle in table order, sample
+    // is emitted when the last of them is stored
+    void scheduleReads(uint64_t sampleTimeMilli);
+
+    // Reads of the last scheduled refresh are not finished yet
+    bool isBatchPending() const;
+
+    // Converts measurement register to its descriptor, false for control registers
+    bool storeRegister(uint16_t address, int32_t value);
+
+    // Batch with failed read is not reported as sample
+    void onReadError(uint16_t address);
+
+    // Queues waveform read of the captured channel, false when capture of
+    // this device is not running. Drivers call it whenever the queue runs
+    // empty within their process budget.
+    bool queueCaptureRead();
+
+private:
+
+    bool pushRequest(uint16_t reg, bool write, int32_t value);
+
+    void finishRead();
+
+    const RegisterInfo* findCaptureRegister(uint8_t channel) const;
+
+    const RegisterInfo* m_registerMap;
+    uint8_t m_registerCount;
+    const float* m_factors;
+    Request m_queue[REQUEST_QUEUE_SIZE];
+    uint8_t m_queueHead;
+    uint8_t m_queueCount;
+    uint32_t m_readCycle;
+    uint8_t m_pendingReads;
+    bool m_batchFailed;
+    uint64_t m_batchTimestamp;
+    uint32_t m_captureGeneration;
+};
@@ -0,0 +1,208 @@
+#include "power_meas_uart.h"
+#include "log.h"
+
+PowerMeasUart::PowerMeasUart() :
+#ifdef ESP32
+    m_port(UART_NUM_0),
+    m_eventQueue(nullptr),
+    m_buffered(0),
+#else
+    m_serial(nullptr),
+#endif
+    m_open(false)
+{
+
+}
+
+PowerMeasUart::~PowerMeasUart()
+{
+    end();
+}
+
+bool PowerMeasUart::isOpen() const
+{
+    return m_open;
+}
+
+#ifdef ESP32
+
+bool PowerMeasUart::begin(uint8_t uartIndex, uint32_t baudRate, bool evenParity, uint8_t rxGpio, uint8_t txGpio)
+{
+    end();
+    if (uartIndex >= UART_NUM_MAX)
+        return false;
+    m_port = (uart_port_t)uartIndex;
+    // Port may be held by Arduino serial driver
+    if (uart_is_driver_installed(m_port))
+        uart_driver_delete(m_port);
+    uart_config_t config = {};
+    config.baud_rate = baudRate;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = evenParity ? UART_PARITY_EVEN : UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    if (uart_driver_install(m_port, RX_BUFFER_SIZE, 0, EVENT_QUEUE_SIZE, &m_eventQueue, 0) != ESP_OK)
+    {
+        Log::error("PowerMeasUart", "Unable to install driver of UART %d", uartIndex);
+        return false;
+    }
+    if ((uart_param_config(m_port, &config) != ESP_OK) ||
+        (uart_set_pin(m_port, txGpio, rxGpio, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK))
+    {
+        Log::error("PowerMeasUart", "Unable to configure UART %d", uartIndex);
+        uart_driver_delete(m_port);
+        return false;
+    }
+    uart_set_rx_timeout(m_port, RX_TIMEOUT_SYMBOLS);
+    m_buffered = 0;
+    m_open = true;
+    return true;
+}
+
+void PowerMeasUart::end()
+{
+    if (!m_open)
+        return;
+    uart_driver_delete(m_port);
+    m_eventQueue = nullptr;
+    m_open = false;
+}
+
+void PowerMeasUart::write(const uint8_t* data, size_t length)
+{
+    if (m_open)
+        uart_write_bytes(m_port, data, length);
+}
+
+void PowerMeasUart::discardInput()
+{
+    if (!m_open)
+        return;
+    uart_flush_input(m_port);
+    xQueueReset(m_eventQueue);
+    m_buffered = 0;
+}
+
+bool PowerMeasUart::pollEvents()
+{
+    uart_event_t event;
+    bool received = false;
+    while (xQueueReceive(m_eventQueue, &event, 0) == pdTRUE)
+    {
+        if ((event.type == UART_FIFO_OVF) || (event.type == UART_BUFFER_FULL))
+        {
+            Log::error("PowerMeasUart", "RX overflow on UART %d", m_port);
+            discardInput();
+            return false;
+        }
+        if (event.type == UART_DATA)
+            received = true;
+    }
+    if (received)
+        uart_get_buffered_data_len(m_port, &m_buffered);
+    return received;
+}
+
+bool PowerMeasUart::receiveFrame(uint8_t* buffer, size_t length)
+{
+    if (!m_open)
+        return false;
+    pollEvents();
+    if (m_buffered < length)
+        return false;
+    int read = uart_read_bytes(m_port, buffer, length, 0);
+    if (read < (int)length)
+    {
+        m_buffered = 0;
+        return false;
+    }
+    m_buffered -= length;
+    return true;
+}
+
+size_t PowerMeasUart::read(uint8_t* buffer, size_t maxLength)
+{
+    if (!m_open)
+        return 0;
+    pollEvents();
+    size_t length = (m_buffered < maxLength) ? m_buffered : maxLength;
+    if (length == 0)
+        return 0;
+    int read = uart_read_bytes(m_port, buffer, length, 0);
+    if (read <= 0)
+    {
+        m_buffered = 0;
+        return 0;
+    }
+    m_buffered -= read;
+    return read;
+}
+
+size_t PowerMeasUart::getAvailable()
+{
+    if (!m_open)
+        return 0;
+    pollEvents();
+    return m_buffered;
+}
+
+#else
+
+bool PowerMeasUart::begin(uint8_t uartIndex, uint32_t baudRate, bool evenParity, uint8_t rxGpio, uint8_t txGpio)
+{
+    end();
+    if (uartIndex == 0)
+        m_serial = &Serial;
+    else if (uartIndex == 1)
+        m_serial = &Serial1;
+    else
+        return false;
+    m_serial->begin(baudRate, evenParity ? SERIAL_8E1 : SERIAL_8N1);
+    m_open = true;
+    return true;
+}
+
+void PowerMeasUart::end()
+{
+    m_serial = nullptr;
+    m_open = false;
+}
+
+void PowerMeasUart::write(const uint8_t* data, size_t length)
+{
+    if (m_open)
+        m_serial->write(data, length);
+}
+
+void PowerMeasUart::discardInput()
+{
+    uint8_t scratch[32];
+    while (m_open && (m_serial->available() > 0))
+        m_serial->readBytes(scratch, min((size_t)m_serial->available(), sizeof(scratch)));
+}
+
+bool PowerMeasUart::receiveFrame(uint8_t* buffer, size_t length)
+{
+    if (!m_open || ((size_t)m_serial->available() < length))
+        return false;
+    return m_serial->readBytes(buffer, length) == length;
+}
+
+size_t PowerMeasUart::read(uint8_t* buffer, size_t maxLength)
+{
+    if (!m_open)
+        return 0;
+    size_t length = min((size_t)m_serial->available(), maxLength);
+    if (length == 0)
+        return 0;
+    return m_serial->readBytes(buffer, length);
+}
+
+size_t PowerMeasUart::getAvailable()
+{
+    if (!m_open)
+        return 0;
+    return m_serial->available();
+}
+
+#endif
@@ -0,0 +1,58 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+#ifdef ESP32
+#include <driver/uart.h>
+#endif
+
+// Frame oriented UART of measurement chips. On ESP32 the IDF UART driver moves
+// received bytes to its RX ring buffer from interrupt and reports bursts through
+// the event queue, the loop only checks the queue and copies complete frames.
+// ESP8266 polls the Arduino serial buffer behind the same interface.
+class PowerMeasUart
+{
+public:
+
+    PowerMeasUart();
+
+    ~PowerMeasUart();
+
+    // Returns false when UART cannot be opened
+    bool begin(uint8_t uartIndex, uint32_t baudRate, bool evenParity, uint8_t rxGpio, uint8_t txGpio);
+
+    void end();
+
+    bool isOpen() const;
+
+    void write(const uint8_t* data, size_t length);
+
+    // Drops received data which was not read yet
+    void discardInput();
+
+    // Copies frame of given length in one piece, returns false until whole frame is received
+    bool receiveFrame(uint8_t* buffer, size_t length);
+
+    // Copies up to maxLength received bytes, returns number of bytes copied
+    size_t read(uint8_t* buffer, size_t maxLength);
+
+    // Number of received bytes waiting in RX buffer
+    size_t getAvailable();
+
+private:
+
+#ifdef ESP32
+    static constexpr int RX_BUFFER_SIZE = 256;
+    static constexpr int EVENT_QUEUE_SIZE = 8;
+    // Data event is reported after RX line is idle for this number of symbols
+    static constexpr uint8_t RX_TIMEOUT_SYMBOLS = 2;
+
+    bool pollEvents();
+
+    uart_port_t m_port;
+    QueueHandle_t m_eventQueue;
+    size_t m_buffered;
+#else
+    HardwareSerial* m_serial;
+#endif
+    bool m_open;
+};
@@ -163,3 +163,28 @@
 #ifndef PROFILE_DEFAULT_CSE7761_PERIOD_MILLI
     #define PROFILE_DEFAULT_CSE7761_PERIOD_MILLI 500    
 #endif
+
+//HLW8012
+#ifndef PROFILE_DEFAULT_HLW8012_MODEL
+    #define PROFILE_DEFAULT_HLW8012_MODEL 0
+#endif
+
+#ifndef PROFILE_DEFAULT_HLW8012_CF_GPIO
+    #define PROFILE_DEFAULT_HLW8012_CF_GPIO 4
+#endif
+
+#ifndef PROFILE_DEFAULT_HLW8012_CF1_GPIO
+    #define PROFILE_DEFAULT_HLW8012_CF1_GPIO 5
+#endif
+
+#ifndef PROFILE_DEFAULT_HLW8012_SEL_GPIO
+    #define PROFILE_DEFAULT_HLW8012_SEL_GPIO 12
+#endif
+
+#ifndef PROFILE_DEFAULT_HLW8012_SEL_CURRENT_HIGH
+    #define PROFILE_DEFAULT_HLW8012_SEL_CURRENT_HIGH false
+#endif
+
+#ifndef PROFILE_DEFAULT_HLW8012_PERIOD_MILLI
+    #define PROFILE_DEFAULT_HLW8012_PERIOD_MILLI 500    
+#endif
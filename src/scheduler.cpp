@@ -0,0 +1,191 @@
+#include "scheduler.h"
+#include "time.h"
+#include "log.h"
+
+constexpr uint32_t Scheduler::HISTOGRAM_BOUNDS_MICRO[];
+
+Scheduler::Scheduler() :
+    m_taskCount(0)
+{
+
+}
+
+bool Scheduler::addTask(const char* name, TaskFunction function, uint32_t periodMilli, Priority priority)
+{
+    Scheduler& inst = getInstance();
+    if (inst.m_taskCount >= MAX_TASKS)
+    {
+        Log::error("Scheduler", "Unable to add task \"%s\", task table full", name);
+        return false;
+    }
+    Task& task = inst.m_tasks[inst.m_taskCount];
+    task.name = name;
+    task.function = function;
+    task.periodMilli = periodMilli;
+    task.priority = priority;
+    task.deadline = Time::nowRelativeMilli();
+    memset(&task.metrics, 0, sizeof(task.metrics));
+    inst.m_taskCount++;
+    Log::info("Scheduler", "Task \"%s\" added, period=%d ms, priority=%d", name, periodMilli, priority);
+    return true;
+}
+
+int8_t Scheduler::findDueTask(uint64_t now)
+{
+    int8_t result = -1;
+    for(uint8_t i = 0; i < m_taskCount; i++)
+    {
+        if (m_tasks[i].deadline > now)
+            continue;
+        if ((result == -1) || 
+            (m_tasks[i].priority < m_tasks[result].priority) ||
+            ((m_tasks[i].priority == m_tasks[result].priority) && (m_tasks[i].deadline < m_tasks[result].deadline)))
+            result = i;
+    }
+    return result;
+}
+
+uint64_t Scheduler::getEarliestDeadline()
+{
+    uint64_t result = UINT64_MAX;
+    for(uint8_t i = 0; i < m_taskCount; i++)
+    {
+        if (m_tasks[i].deadline < result)
+            result = m_tasks[i].deadline;
+    }
+    return result;
+}
+
+void Scheduler::process()
+{
+    Scheduler& inst = getInstance();
+    // Highest priority due task is picked again after every run, so motion and
+    // measurement tasks are never queued behind network tasks
+    for(uint8_t run = 0; run < MAX_RUNS_PER_PASS; run++)
+    {
+        uint64_t now = Time::nowRelativeMilli();
+        int8_t index = inst.findDueTask(now);
+        if (index == -1)
+            break;
+        Task& task = inst.m_tasks[index];
+        task.deadline += task.periodMilli;
+        if (task.deadline <= now)
+        {
+            // Overrun - skip missed periods
+            task.deadline = now + task.periodMilli;
+        }
+        inst.runTask(task);
+    }
+    uint64_t now = Time::nowRelativeMilli();
+    uint64_t earliest = inst.getEarliestDeadline();
+    if (earliest > now)
+    {
+        uint64_t sleep = earliest - now;
+        if (sleep > MAX_SLEEP_MILLI)
+            sleep = MAX_SLEEP_MILLI;
+        // delay() yields to RTOS/SDK and allows automatic light/modem sleep
+        delay((uint32_t)sleep);
+    }
+    else
+    {
+        yield();
+    }
+}
+
+void Scheduler::runTask(Task& task)
+{
+    uint32_t start = micros();
+    task.function();
+    uint32_t duration = micros() - start;
+    TaskMetrics& metrics = task.metrics;
+    uint8_t bucket = 0;
+    while ((bucket < HISTOGRAM_BUCKETS - 1) && (duration > HISTOGRAM_BOUNDS_MICRO[bucket]))
+        bucket++;
+    metrics.histogram[bucket]++;
+    metrics.runCount++;
+    metrics.totalMicro += duration;
+    if (duration > metrics.maxMicro)
+        metrics.maxMicro = duration;
+    // Task has blocked the loop for longer than its own period
+    if (duration > task.periodMilli * 1000)
+        metrics.overrunCount++;
+}
+
+uint32_t Scheduler::getPercentileMicro(const TaskMetrics& metrics, uint8_t percent)
+{
+    if (metrics.runCount == 0)
+        return 0;
+    uint32_t target = (uint32_t)(((uint64_t)metrics.runCount * percent + 99) / 100);
+    uint32_t cumulative = 0;
+    for(uint8_t i = 0; i < HISTOGRAM_BUCKETS - 1; i++)
+    {
+        cumulative += metrics.histogram[i];
+        if (cumulative >= target)
+            return (HISTOGRAM_BOUNDS_MICRO[i] < metrics.maxMicro) ? HISTOGRAM_BOUNDS_MICRO[i] : metrics.maxMicro;
+    }
+    return metrics.maxMicro;
+}
+
+void Scheduler::exportMetrics(Print& out)
+{
+    Scheduler& inst = getInstance();
+    out.print("# HELP louver_task_duration_microseconds Run time of scheduler tasks\n");
+    out.print("# TYPE louver_task_duration_microseconds histogram\n");
+    for(uint8_t i = 0; i < inst.m_taskCount; i++)
+    {
+        const Task& task = inst.m_tasks[i];
+        uint32_t cumulative = 0;
+        for(uint8_t ii = 0; ii < HISTOGRAM_BUCKETS - 1; ii++)
+        {
+            cumulative += task.metrics.histogram[ii];
+            out.printf("louver_task_duration_microseconds_bucket{task=\"%s\",le=\"%u\"} %u\n", task.name, HISTOGRAM_BOUNDS_MICRO[ii], cumulative);
+        }
+        out.printf("louver_task_duration_microseconds_bucket{task=\"%s\",le=\"+Inf\"} %u\n", task.name, task.metrics.runCount);
+        out.printf("louver_task_duration_microseconds_sum{task=\"%s\"} %.0f\n", task.name, (double)task.metrics.totalMicro);
+        out.printf("louver_task_duration_microseconds_count{task=\"%s\"} %u\n", task.name, task.metrics.runCount);
+    }
+    out.print("# HELP louver_task_duration_max_microseconds Longest run time of scheduler tasks\n");
+    out.print("# TYPE louver_task_duration_max_microseconds gauge\n");
+    for(uint8_t i = 0; i < inst.m_taskCount; i++)
+        out.printf("louver_task_duration_max_microseconds{task=\"%s\"} %u\n", inst.m_tasks[i].name, inst.m_tasks[i].metrics.maxMicro);
+    out.print("# HELP louver_task_duration_p99_microseconds 99th percentile run time of scheduler tasks (bucket upper bound)\n");
+    out.print("# TYPE louver_task_duration_p99_microseconds gauge\n");
+    for(uint8_t i = 0; i < inst.m_taskCount; i++)
+        out.printf("louver_task_duration_p99_microseconds{task=\"%s\"} %u\n", inst.m_tasks[i].name, getPercentileMicro(inst.m_tasks[i].metrics, 99));
+    out.print("# HELP louver_task_overruns_total Runs longer than the task period\n");
+    out.print("# TYPE louver_task_overruns_total counter\n");
+    for(uint8_t i = 0; i < inst.m_taskCount; i++)
+        out.printf("louver_task_overruns_total{task=\"%s\"} %u\n", inst.m_tasks[i].name, inst.m_tasks[i].metrics.overrunCount);
+}
+
+uint8_t Scheduler::getTaskCount()
+{
+    return getInstance().m_taskCount;
+}
+
+const char* Scheduler::getTaskName(uint8_t index)
+{
+    Scheduler& inst = getInstance();
+    if (index >= inst.m_taskCount)
+        return "";
+    return inst.m_tasks[index].name;
+}
+
+String Scheduler::exportMetricsToJSON(uint8_t index)
+{
+    Scheduler& inst = getInstance();
+    if (index >= inst.m_taskCount)
+        return "{}";
+    const TaskMetrics& metrics = inst.m_tasks[index].metrics;
+    return String("{\"count\":") + String(metrics.runCount) + "," +
+        "\"max\":" + String(metrics.maxMicro) + "," +
+        "\"p99\":" + String(getPercentileMicro(metrics, 99)) + "," +
+        "\"overruns\":" + String(metrics.overrunCount) + "}";
+}
+
+void Scheduler::resetMetrics()
+{
+    Scheduler& inst = getInstance();
+    for(uint8_t i = 0; i < inst.m_taskCount; i++)
+        memset(&inst.m_tasks[i].metrics, 0, sizeof(inst.m_tasks[i].metrics));
+}
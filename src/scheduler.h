@@ -0,0 +1,87 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+
+class Scheduler
+{
+public:
+
+    typedef void (*TaskFunction)();
+
+    // Lower value means higher priority
+    enum Priority
+    {
+        PRIO_MOTION = 0,
+        PRIO_MEASUREMENT,
+        PRIO_SYSTEM,
+        PRIO_NETWORK,
+        PRIO_BACKGROUND
+    };
+
+    static constexpr uint8_t MAX_TASKS = 12;
+
+    static bool addTask(const char* name, TaskFunction function, uint32_t periodMilli, Priority priority);
+
+    static void process();
+
+    // Prometheus text exposition format
+    static void exportMetrics(Print& out);
+
+    static uint8_t getTaskCount();
+
+    static const char* getTaskName(uint8_t index);
+
+    static String exportMetricsToJSON(uint8_t index);
+
+    static void resetMetrics();
+
+private:
+
+    static constexpr uint32_t MAX_SLEEP_MILLI = 10;
+    static constexpr uint8_t MAX_RUNS_PER_PASS = 16;
+
+    static constexpr uint8_t HISTOGRAM_BUCKETS = 11;
+
+    // Upper bounds of the run time histogram buckets, the last bucket is +Inf
+    static constexpr uint32_t HISTOGRAM_BOUNDS_MICRO[HISTOGRAM_BUCKETS - 1] = {
+        50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000
+    };
+
+    struct TaskMetrics
+    {
+        uint32_t histogram[HISTOGRAM_BUCKETS];
+        uint32_t runCount;
+        uint32_t overrunCount;
+        uint32_t maxMicro;
+        uint64_t totalMicro;
+    };
+
+    struct Task
+    {
+        const char* name;
+        TaskFunction function;
+        uint32_t periodMilli;
+        Priority priority;
+        uint64_t deadline;
+        TaskMetrics metrics;
+    };
+
+    Scheduler();
+
+    static inline Scheduler& getInstance()
+    {
+        static Scheduler scheduler;
+        return scheduler;
+    }
+
+    int8_t findDueTask(uint64_t now);
+
+    uint64_t getEarliestDeadline();
+
+    void runTask(Task& task);
+
+    static uint32_t getPercentileMicro(const TaskMetrics& metrics, uint8_t percent);
+
+    Task m_tasks[MAX_TASKS];
+    uint8_t m_taskCount;
+};
@@ -7,6 +7,11 @@
 #include "config.h"
 #include "mqtt.h"
 #include "power_meas.h"
+#include "power_meas_archive.h"
+#include "motion_analyzer.h"
+#include "movement_stats.h"
+#include "power_meas_capture.h"
+#include "scheduler.h"
 
 void setup() {
     // put your setup code here, to run once:
@@ -14,21 +19,30 @@ void setup() {
     Log::info("main", "Louver control, firmware version %s", Config::VERSION);
     Module::loadConfig();
     Louver::loadConfig();
+    Louver::init();
     HttpServer::loadConfig();
     HttpServer::init();
     Mdns::loadConfig();
     Mdns::init();
     Mqtt::loadConfig();
     PowerMeas::loadConfig();
+    PowerMeasArchive::loadConfig();
+    MotionAnalyzer::loadConfig();
+    MovementStats::loadConfig();
+    PowerMeasCapture::loadConfig();
+    // Motion and measurement tasks have strict priority over network tasks
+    Scheduler::addTask("louver", Louver::process, 5, Scheduler::PRIO_MOTION);
+    Scheduler::addTask("power_meas", PowerMeas::process, 2, Scheduler::PRIO_MEASUREMENT);
+    Scheduler::addTask("module", Module::process, 20, Scheduler::PRIO_SYSTEM);
+    Scheduler::addTask("wifi", HttpServer::process, 20, Scheduler::PRIO_NETWORK);
+    Scheduler::addTask("mqtt", Mqtt::process, 20, Scheduler::PRIO_NETWORK);
+    Scheduler::addTask("mdns", Mdns::process, 100, Scheduler::PRIO_NETWORK);
+    Scheduler::addTask("ntp", Time::process, 1000, Scheduler::PRIO_NETWORK);
+    Scheduler::addTask("archive", PowerMeasArchive::process, 1000, Scheduler::PRIO_BACKGROUND);
+    Scheduler::addTask("led", Module::processLed, 100, Scheduler::PRIO_BACKGROUND);
 }
 
 void loop() 
 {
-    Time::process();
-    Module::process();
-    Louver::process();
-    HttpServer::process();
-    Mdns::process();
-    Mqtt::process();
-    PowerMeas::process();
+    Scheduler::process();
 }
\ No newline at end of file
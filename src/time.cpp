@@ -1,5 +1,8 @@
 #include "time.h"
 #include <ESPDateTime.h>
+#ifdef ESP32
+#include <esp_timer.h>
+#endif
 #include "http_server.h"
 
 using namespace std;
@@ -23,6 +26,22 @@ uint64_t Time::nowRelativeMilli()
     return (epoch << 32) | now;
 }
 
+uint64_t IRAM_ATTR Time::nowRelativeMicro()
+{
+#ifdef ESP32
+    return (uint64_t)esp_timer_get_time();
+#else
+    return micros64();
+#endif
+}
+
+uint32_t Time::nowEpoch()
+{
+    if (!DateTime.isTimeValid())
+        return 0;
+    return (uint32_t)DateTime.now();
+}
+
 String Time::getTimeLog()
 {
     return DateTime.toString();
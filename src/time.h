@@ -10,6 +10,11 @@ public:
 
     static uint64_t nowRelativeMilli();
 
+    static uint64_t nowRelativeMicro();
+
+    // Unix time in seconds, 0 when time is not synchronized yet
+    static uint32_t nowEpoch();
+
     static void process();
 
 private:
@@ -0,0 +1,412 @@
+#include "host.h"
+#include <stdarg.h>
+#include <map>
+#include <string>
+#include "time.h"
+#include "log.h"
+#include "config.h"
+#include "power_meas.h"
+#include "mqtt.h"
+
+HardwareSerial Serial;
+HardwareSerial Serial1;
+EspClass ESP;
+
+static const uint8_t MAX_PINS = 64;
+
+struct Interrupt
+{
+    void (*handler)(void*);
+    void* arg;
+};
+
+static uint64_t s_micro = 0;
+static uint32_t s_epoch = 0;
+static int s_pinLevels[MAX_PINS];
+static Interrupt s_interrupts[MAX_PINS];
+static void (*s_timer1Handler)() = nullptr;
+static bool s_timer1Enabled = false;
+static uint64_t s_timer1Micro = 0;
+static uint8_t s_rtcMemory[512];
+static bool s_logPrinted = false;
+static std::map<std::string, std::string> s_config;
+static PowerMeasDevice* s_activeDevice = nullptr;
+static uint32_t s_movementEventCount = 0;
+static const char* s_lastMovementEvent = "";
+
+uint64_t Host::getMicro()
+{
+    return s_micro;
+}
+
+void Host::advanceMicro(uint64_t micro)
+{
+    s_micro += micro;
+}
+
+void Host::reset()
+{
+    // Firmware clock never starts at zero, timestamps 0 often mean "never"
+    s_micro = 1000000;
+    s_epoch = 0;
+    memset(s_pinLevels, 0, sizeof(s_pinLevels));
+    memset(s_interrupts, 0, sizeof(s_interrupts));
+    s_timer1Handler = nullptr;
+    s_timer1Enabled = false;
+    s_timer1Micro = 0;
+    s_config.clear();
+    s_activeDevice = nullptr;
+    s_movementEventCount = 0;
+    s_lastMovementEvent = "";
+    Serial.reset();
+    Serial1.reset();
+}
+
+void Host::setMicro(uint64_t micro)
+{
+    s_micro = micro;
+}
+
+void Host::advanceMilli(uint64_t milli)
+{
+    s_micro += milli * 1000;
+}
+
+void Host::setEpoch(uint32_t epoch)
+{
+    s_epoch = epoch;
+}
+
+int Host::getPinLevel(uint8_t pin)
+{
+    return (pin < MAX_PINS) ? s_pinLevels[pin] : LOW;
+}
+
+void Host::setPinLevel(uint8_t pin, int level)
+{
+    if (pin < MAX_PINS)
+        s_pinLevels[pin] = level;
+}
+
+bool Host::fireInterrupt(uint8_t pin)
+{
+    if ((pin >= MAX_PINS) || !s_interrupts[pin].handler)
+        return false;
+    s_interrupts[pin].handler(s_interrupts[pin].arg);
+    return true;
+}
+
+uint64_t Host::getTimer1Micro()
+{
+    return s_timer1Micro;
+}
+
+void Host::fireTimer1()
+{
+    s_timer1Micro = 0;
+    if (s_timer1Handler)
+        s_timer1Handler();
+}
+
+void Host::setActiveDevice(PowerMeasDevice* device)
+{
+    s_activeDevice = device;
+}
+
+uint32_t Host::getMovementEventCount()
+{
+    return s_movementEventCount;
+}
+
+const char* Host::getLastMovementEvent()
+{
+    return s_lastMovementEvent;
+}
+
+void Host::setLogPrinted(bool printed)
+{
+    s_logPrinted = printed;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    // Unconnected input with pull up reads high
+    if ((pin < MAX_PINS) && (mode & INPUT_PULLUP))
+        s_pinLevels[pin] = HIGH;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    if (pin < MAX_PINS)
+        s_pinLevels[pin] = value;
+}
+
+int digitalRead(uint8_t pin)
+{
+    return Host::getPinLevel(pin);
+}
+
+void attachInterruptArg(uint8_t interrupt, void (*handler)(void*), void* arg, int mode)
+{
+    if (interrupt < MAX_PINS)
+        s_interrupts[interrupt] = { handler, arg };
+}
+
+void detachInterrupt(uint8_t interrupt)
+{
+    if (interrupt < MAX_PINS)
+        s_interrupts[interrupt] = { nullptr, nullptr };
+}
+
+void timer1_attachInterrupt(void (*handler)())
+{
+    s_timer1Handler = handler;
+}
+
+void timer1_enable(uint8_t divider, uint8_t edge, uint8_t reload)
+{
+    s_timer1Enabled = true;
+}
+
+void timer1_disable()
+{
+    s_timer1Enabled = false;
+    s_timer1Micro = 0;
+}
+
+void timer1_write(uint32_t ticks)
+{
+    // 80 MHz / 256, one tick is 3.2 us
+    if (s_timer1Enabled)
+        s_timer1Micro = s_micro + (uint64_t)ticks * 16 / 5;
+}
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size)
+{
+    if (offset * 4 + size > sizeof(s_rtcMemory))
+        return false;
+    memcpy(data, s_rtcMemory + offset * 4, size);
+    return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size)
+{
+    if (offset * 4 + size > sizeof(s_rtcMemory))
+        return false;
+    memcpy(s_rtcMemory + offset * 4, data, size);
+    return true;
+}
+
+String Time::getTimeLog()
+{
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%llu.%06llu", (unsigned long long)(s_micro / 1000000), (unsigned long long)(s_micro % 1000000));
+    return String(buffer);
+}
+
+uint64_t Time::nowRelativeMilli()
+{
+    return s_micro / 1000;
+}
+
+uint64_t Time::nowRelativeMicro()
+{
+    return s_micro;
+}
+
+uint32_t Time::nowEpoch()
+{
+    return s_epoch;
+}
+
+void Time::process()
+{
+
+}
+
+static void printLog(const char* level, const char* module, const char* format, va_list arg)
+{
+    if (!s_logPrinted)
+        return;
+    printf("    %s %-5s %-16s ", Time::getTimeLog().c_str(), level, module);
+    vprintf(format, arg);
+    printf("\n");
+}
+
+void Log::error(const char* module, const char* format, ...)
+{
+    va_list arg;
+    va_start(arg, format);
+    printLog("ERROR", module, format, arg);
+    va_end(arg);
+}
+
+void Log::warning(const char* module, const char* format, ...)
+{
+    va_list arg;
+    va_start(arg, format);
+    printLog("WARN", module, format, arg);
+    va_end(arg);
+}
+
+void Log::info(const char* module, const char* format, ...)
+{
+    va_list arg;
+    va_start(arg, format);
+    printLog("INFO", module, format, arg);
+    va_end(arg);
+}
+
+void Log::debug(const char* module, const char* format, ...)
+{
+    va_list arg;
+    va_start(arg, format);
+    printLog("DEBUG", module, format, arg);
+    va_end(arg);
+}
+
+void Log::verbose(const char* module, const char* format, ...)
+{
+    va_list arg;
+    va_start(arg, format);
+    printLog("VERB", module, format, arg);
+    va_end(arg);
+}
+
+bool Config::flush()
+{
+    return true;
+}
+
+bool Config::isSaved()
+{
+    return true;
+}
+
+void Config::clearAll()
+{
+    s_config.clear();
+}
+
+void Config::setInt(const char* key, int value)
+{
+    s_config[key] = std::to_string(value);
+}
+
+void Config::setString(const char* key, String value)
+{
+    s_config[key] = value.c_str();
+}
+
+void Config::setFloat(const char* key, float value)
+{
+    s_config[key] = String(value, 6).c_str();
+}
+
+void Config::setBool(const char* key, bool value)
+{
+    s_config[key] = value ? "1" : "0";
+}
+
+int Config::getInt(const char* key, int defaultValue)
+{
+    auto value = s_config.find(key);
+    return (value == s_config.end()) ? defaultValue : atoi(value->second.c_str());
+}
+
+String Config::getString(const char* key, String defaultValue)
+{
+    auto value = s_config.find(key);
+    return (value == s_config.end()) ? defaultValue : String(value->second);
+}
+
+float Config::getFloat(const char* key, float defaultValue)
+{
+    auto value = s_config.find(key);
+    return (value == s_config.end()) ? defaultValue : atof(value->second.c_str());
+}
+
+bool Config::getBool(const char* key, bool defaultValue)
+{
+    auto value = s_config.find(key);
+    return (value == s_config.end()) ? defaultValue : (value->second == "1");
+}
+
+void Config::remove(const char* key)
+{
+    s_config.erase(key);
+}
+
+PowerMeas::DeviceType PowerMeas::getActiveDeviceType()
+{
+    // Type of the test device does not matter, only presence
+    return s_activeDevice ? DEV_CSE7761 : DEV_NONE;
+}
+
+const PowerMeasDevice& PowerMeas::getActiveDeviceDriver()
+{
+    static PowerMeasDevice noDevice;
+    return s_activeDevice ? *s_activeDevice : noDevice;
+}
+
+// No power conditions are configured on host
+uint8_t PowerMeas::findCondition(const String& name)
+{
+    return NO_CONDITION;
+}
+
+const char* PowerMeas::getConditionName(uint8_t conditionIndex)
+{
+    return "";
+}
+
+bool PowerMeas::getConditionResult(uint8_t conditionIndex)
+{
+    return false;
+}
+
+void PowerMeas::resetAllConditions()
+{
+
+}
+
+void PowerMeas::setConditionListener(ConditionListener listener)
+{
+
+}
+
+void PowerMeas::setMotionActive(bool active)
+{
+
+}
+
+void Mqtt::publishMovement(const char* value)
+{
+
+}
+
+void Mqtt::publishKey(const char* key, const char* value)
+{
+
+}
+
+void Mqtt::publishPosition(uint8_t position)
+{
+
+}
+
+void Mqtt::publishOvershoot(int32_t overshootMicro)
+{
+
+}
+
+void Mqtt::publishMovementRecord(const char* record)
+{
+
+}
+
+void Mqtt::queueMovementEvent(const char* event, uint32_t timeMilli, float value, float plateau)
+{
+    s_movementEventCount++;
+    s_lastMovementEvent = event;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <Arduino.h>
+#include <stdint.h>
+
+class PowerMeasDevice;
+
+// Control of the simulated environment, modules under test see it through
+// the Arduino stubs and fake Time, Log, Config, PowerMeas and Mqtt
+namespace Host
+{
+    // Clock, pins, serial ports, configuration and active device are cleared before each test
+    void reset();
+
+    void setMicro(uint64_t micro);
+
+    void advanceMilli(uint64_t milli);
+
+    // Unix time returned by Time::nowEpoch, 0 = not synchronized
+    void setEpoch(uint32_t epoch);
+
+    int getPinLevel(uint8_t pin);
+
+    // Input level driven from outside, e.g. key press
+    void setPinLevel(uint8_t pin, int level);
+
+    // Calls handler attached to the pin as if the edge came now
+    bool fireInterrupt(uint8_t pin);
+
+    // Time when timer1 interrupt is due, 0 = not armed
+    uint64_t getTimer1Micro();
+
+    // Calls timer1 handler, single shot timer is disarmed before
+    void fireTimer1();
+
+    // Driver returned by PowerMeas::getActiveDeviceDriver
+    void setActiveDevice(PowerMeasDevice* device);
+
+    // Movement events queued through Mqtt::queueMovementEvent since reset
+    uint32_t getMovementEventCount();
+
+    const char* getLastMovementEvent();
+
+    // Log output is printed when TEST_VERBOSE environment variable is set
+    void setLogPrinted(bool printed);
+}
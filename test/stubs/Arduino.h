@@ -0,0 +1,307 @@
+#pragma once
+// Host replacement of the Arduino core, only the parts used by tested modules.
+// Time, pins, interrupts and serial ports are simulated by the test harness.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+#include <deque>
+#include <functional>
+#include <algorithm>
+
+#define PROGMEM
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+typedef const char* PGM_P;
+class __FlashStringHelper;
+#define FPSTR(x) (reinterpret_cast<const __FlashStringHelper*>(x))
+#define F(x) FPSTR(x)
+#define PSTR(x) (x)
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_float(p) (*(const float*)(p))
+#define memcpy_P memcpy
+#define strcmp_P strcmp
+#define strncpy_P strncpy
+#define strlen_P strlen
+
+typedef uint8_t byte;
+using std::min;
+using std::max;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x04
+#define CHANGE 3
+#define RISING 1
+#define FALLING 2
+#define NOT_AN_INTERRUPT -1
+
+#define SERIAL_8N1 0x1c
+#define SERIAL_8E1 0x1e
+
+#define TIM_DIV256 3
+#define TIM_EDGE 0
+#define TIM_SINGLE 0
+
+// Simulated clock, advanced by the test and by writes to full serial FIFO
+namespace Host
+{
+    uint64_t getMicro();
+
+    void advanceMicro(uint64_t micro);
+}
+
+inline unsigned long micros()
+{
+    return (unsigned long)Host::getMicro();
+}
+
+inline unsigned long millis()
+{
+    return (unsigned long)(Host::getMicro() / 1000);
+}
+
+inline void delay(unsigned long ms)
+{
+    Host::advanceMicro((uint64_t)ms * 1000);
+}
+
+inline void delayMicroseconds(unsigned int us)
+{
+    Host::advanceMicro(us);
+}
+
+inline void yield()
+{
+
+}
+
+inline void noInterrupts()
+{
+
+}
+
+inline void interrupts()
+{
+
+}
+
+void pinMode(uint8_t pin, uint8_t mode);
+
+void digitalWrite(uint8_t pin, uint8_t value);
+
+int digitalRead(uint8_t pin);
+
+inline int digitalPinToInterrupt(uint8_t pin)
+{
+    return pin;
+}
+
+void attachInterruptArg(uint8_t interrupt, void (*handler)(void*), void* arg, int mode);
+
+void detachInterrupt(uint8_t interrupt);
+
+void timer1_attachInterrupt(void (*handler)());
+
+void timer1_enable(uint8_t divider, uint8_t edge, uint8_t reload);
+
+void timer1_disable();
+
+void timer1_write(uint32_t ticks);
+
+// RTC user memory of ESP8266, kept over simulated resets
+class EspClass
+{
+public:
+
+    bool rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size);
+
+    bool rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size);
+};
+
+extern EspClass ESP;
+
+class String
+{
+public:
+
+    String() {}
+    String(const char* value) : m_value(value ? value : "") {}
+    String(const __FlashStringHelper* value) : m_value(value ? (const char*)value : "") {}
+    String(const std::string& value) : m_value(value) {}
+    explicit String(char value) : m_value(1, value) {}
+    String(int value) : m_value(std::to_string(value)) {}
+    String(unsigned int value) : m_value(std::to_string(value)) {}
+    String(long value) : m_value(std::to_string(value)) {}
+    String(unsigned long value) : m_value(std::to_string(value)) {}
+    String(long long value) : m_value(std::to_string(value)) {}
+    String(unsigned long long value) : m_value(std::to_string(value)) {}
+    String(float value, unsigned int decimals = 2) : m_value(format(value, decimals)) {}
+    String(double value, unsigned int decimals = 2) : m_value(format(value, decimals)) {}
+
+    const char* c_str() const { return m_value.c_str(); }
+    unsigned int length() const { return m_value.size(); }
+    bool reserve(unsigned int size) { m_value.reserve(size); return true; }
+    char charAt(unsigned int index) const { return (index < m_value.size()) ? m_value[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    long toInt() const { return atol(m_value.c_str()); }
+    float toFloat() const { return atof(m_value.c_str()); }
+    int indexOf(char value, unsigned int from = 0) const { return position(m_value.find(value, from)); }
+    int indexOf(const String& value, unsigned int from = 0) const { return position(m_value.find(value.m_value, from)); }
+    bool startsWith(const String& prefix) const { return m_value.compare(0, prefix.m_value.size(), prefix.m_value) == 0; }
+    String substring(unsigned int from) const { return (from < m_value.size()) ? String(m_value.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const
+    {
+        if ((from >= m_value.size()) || (to <= from))
+            return String();
+        return String(m_value.substr(from, to - from));
+    }
+    void trim()
+    {
+        size_t first = m_value.find_first_not_of(" \t\r\n");
+        size_t last = m_value.find_last_not_of(" \t\r\n");
+        m_value = (first == std::string::npos) ? "" : m_value.substr(first, last - first + 1);
+    }
+
+    String& operator+=(const String& value) { m_value += value.m_value; return *this; }
+    String& operator+=(const char* value) { m_value += value; return *this; }
+    String& operator+=(const __FlashStringHelper* value) { m_value += (const char*)value; return *this; }
+    String& operator+=(char value) { m_value += value; return *this; }
+    bool operator==(const String& value) const { return m_value == value.m_value; }
+    bool operator==(const char* value) const { return m_value == value; }
+    bool operator!=(const String& value) const { return m_value != value.m_value; }
+    bool operator!=(const char* value) const { return m_value != value; }
+
+    friend String operator+(const String& left, const String& right) { return String(left.m_value + right.m_value); }
+    friend String operator+(const String& left, const char* right) { return String(left.m_value + right); }
+    friend String operator+(const char* left, const String& right) { return String(left + right.m_value); }
+
+private:
+
+    static std::string format(double value, unsigned int decimals)
+    {
+        char buffer[48];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        return buffer;
+    }
+
+    static int position(size_t index)
+    {
+        return (index == std::string::npos) ? -1 : (int)index;
+    }
+
+    std::string m_value;
+};
+
+// Serial port connected to a simulated peer, every written frame is passed
+// to the write handler which may inject the response
+class HardwareSerial
+{
+public:
+
+    typedef std::function<void(HardwareSerial& serial, const uint8_t* data, size_t length)> WriteHandler;
+
+    // Transmit FIFO of the UART, write blocks only when it is full
+    static constexpr size_t TX_FIFO_SIZE = 128;
+
+    HardwareSerial() : m_baudRate(0), m_config(0), m_txEndMicro(0) {}
+
+    void begin(unsigned long baudRate, int config = SERIAL_8N1)
+    {
+        m_baudRate = baudRate;
+        m_config = config;
+        m_rx.clear();
+        m_txEndMicro = 0;
+    }
+
+    void end()
+    {
+        m_baudRate = 0;
+    }
+
+    size_t write(const uint8_t* data, size_t length)
+    {
+        // Line is busy for the frame time, writer waits only for room in the FIFO
+        if (m_baudRate > 0)
+        {
+            uint64_t now = Host::getMicro();
+            m_txEndMicro = max(m_txEndMicro, now) + length * getByteMicro();
+            uint64_t fifoMicro = TX_FIFO_SIZE * getByteMicro();
+            if (m_txEndMicro > now + fifoMicro)
+                Host::advanceMicro(m_txEndMicro - now - fifoMicro);
+        }
+        if (m_writeHandler)
+            m_writeHandler(*this, data, length);
+        return length;
+    }
+
+    // Time of one byte on the line, start, stop and parity bits included
+    uint64_t getByteMicro() const
+    {
+        return (m_baudRate > 0) ? ((m_config == SERIAL_8E1) ? 11 : 10) * 1000000 / m_baudRate : 0;
+    }
+
+    // When the last written byte leaves the line
+    uint64_t getTxEndMicro() const
+    {
+        return m_txEndMicro;
+    }
+
+    int available()
+    {
+        return (int)m_rx.size();
+    }
+
+    size_t readBytes(uint8_t* buffer, size_t length)
+    {
+        size_t count = 0;
+        while ((count < length) && !m_rx.empty())
+        {
+            buffer[count++] = m_rx.front();
+            m_rx.pop_front();
+        }
+        return count;
+    }
+
+    // Host side of the line
+    void inject(const uint8_t* data, size_t length)
+    {
+        m_rx.insert(m_rx.end(), data, data + length);
+    }
+
+    void setWriteHandler(WriteHandler handler)
+    {
+        m_writeHandler = handler;
+    }
+
+    unsigned long getBaudRate() const
+    {
+        return m_baudRate;
+    }
+
+    void reset()
+    {
+        m_baudRate = 0;
+        m_config = 0;
+        m_rx.clear();
+        m_txEndMicro = 0;
+        m_writeHandler = nullptr;
+    }
+
+private:
+
+    unsigned long m_baudRate;
+    int m_config;
+    uint64_t m_txEndMicro;
+    std::deque<uint8_t> m_rx;
+    WriteHandler m_writeHandler;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
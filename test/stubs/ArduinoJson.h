@@ -0,0 +1,253 @@
+#pragma once
+// Host replacement of ArduinoJson, parses flat objects of numbers, booleans
+// and strings, which is what module configurations under test use
+#include <Arduino.h>
+#include <map>
+#include <string>
+
+class JsonVariantConst
+{
+public:
+
+    JsonVariantConst() : m_type(T_NULL), m_number(0) {}
+
+    static JsonVariantConst fromBool(bool value)
+    {
+        JsonVariantConst variant;
+        variant.m_type = T_BOOL;
+        variant.m_number = value ? 1 : 0;
+        return variant;
+    }
+
+    static JsonVariantConst fromNumber(double value)
+    {
+        JsonVariantConst variant;
+        variant.m_type = T_NUMBER;
+        variant.m_number = value;
+        return variant;
+    }
+
+    static JsonVariantConst fromString(const std::string& value)
+    {
+        JsonVariantConst variant;
+        variant.m_type = T_STRING;
+        variant.m_string = value;
+        return variant;
+    }
+
+    bool isNull() const
+    {
+        return m_type == T_NULL;
+    }
+
+    template<typename T>
+    T as() const
+    {
+        return (T)m_number;
+    }
+
+    template<typename T>
+    T operator|(T defaultValue) const
+    {
+        if ((m_type == T_NUMBER) || (m_type == T_BOOL))
+            return (T)m_number;
+        return defaultValue;
+    }
+
+    const char* operator|(const char* defaultValue) const
+    {
+        return (m_type == T_STRING) ? m_string.c_str() : defaultValue;
+    }
+
+    bool operator==(const char* value) const
+    {
+        return (m_type == T_STRING) && (m_string == value);
+    }
+
+private:
+
+    enum Type
+    {
+        T_NULL = 0,
+        T_BOOL,
+        T_NUMBER,
+        T_STRING
+    };
+
+    Type m_type;
+    double m_number;
+    std::string m_string;
+};
+
+template<>
+inline const char* JsonVariantConst::as<const char*>() const
+{
+    return m_string.c_str();
+}
+
+template<>
+inline String JsonVariantConst::as<String>() const
+{
+    return String(m_string);
+}
+
+template<>
+inline bool JsonVariantConst::operator|(bool defaultValue) const
+{
+    return (m_type == T_BOOL) ? (m_number != 0) : defaultValue;
+}
+
+typedef JsonVariantConst JsonVariant;
+
+class DeserializationError
+{
+public:
+
+    enum Code
+    {
+        Ok = 0,
+        InvalidInput,
+        NotSupported
+    };
+
+    DeserializationError(Code code) : m_code(code) {}
+
+    const char* c_str() const
+    {
+        static const char* const names[] = { "Ok", "InvalidInput", "NotSupported" };
+        return names[m_code];
+    }
+
+    explicit operator bool() const
+    {
+        return m_code != Ok;
+    }
+
+private:
+
+    Code m_code;
+};
+
+class DynamicJsonDocument
+{
+public:
+
+    explicit DynamicJsonDocument(size_t capacity) : m_capacity(capacity) {}
+
+    const JsonVariantConst& operator[](const char* key) const
+    {
+        static const JsonVariantConst nullVariant;
+        auto member = m_members.find(key);
+        return (member == m_members.end()) ? nullVariant : member->second;
+    }
+
+    bool containsKey(const char* key) const
+    {
+        return m_members.count(key) > 0;
+    }
+
+    void clear()
+    {
+        m_members.clear();
+    }
+
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    std::map<std::string, JsonVariantConst> m_members;
+
+private:
+
+    size_t m_capacity;
+};
+
+namespace HostJson
+{
+    inline void skipSpace(const char*& text)
+    {
+        while ((*text == ' ') || (*text == '\t') || (*text == '\r') || (*text == '\n'))
+            text++;
+    }
+
+    inline bool parseString(const char*& text, std::string& value)
+    {
+        if (*text != '"')
+            return false;
+        text++;
+        value.clear();
+        while (*text && (*text != '"'))
+        {
+            if ((*text == '\\') && text[1])
+                text++;
+            value += *text++;
+        }
+        if (*text != '"')
+            return false;
+        text++;
+        return true;
+    }
+}
+
+inline DeserializationError deserializeJson(DynamicJsonDocument& document, const String& input)
+{
+    using namespace HostJson;
+    document.clear();
+    const char* text = input.c_str();
+    skipSpace(text);
+    if (*text++ != '{')
+        return DeserializationError::InvalidInput;
+    skipSpace(text);
+    if (*text == '}')
+        return DeserializationError::Ok;
+    while (true)
+    {
+        std::string key;
+        skipSpace(text);
+        if (!parseString(text, key))
+            return DeserializationError::InvalidInput;
+        skipSpace(text);
+        if (*text++ != ':')
+            return DeserializationError::InvalidInput;
+        skipSpace(text);
+        if ((*text == '{') || (*text == '['))
+            return DeserializationError::NotSupported;
+        std::string stringValue;
+        if (*text == '"')
+        {
+            if (!parseString(text, stringValue))
+                return DeserializationError::InvalidInput;
+            document.m_members[key] = JsonVariantConst::fromString(stringValue);
+        }
+        else if (strncmp(text, "true", 4) == 0)
+        {
+            text += 4;
+            document.m_members[key] = JsonVariantConst::fromBool(true);
+        }
+        else if (strncmp(text, "false", 5) == 0)
+        {
+            text += 5;
+            document.m_members[key] = JsonVariantConst::fromBool(false);
+        }
+        else if (strncmp(text, "null", 4) == 0)
+        {
+            text += 4;
+            document.m_members[key] = JsonVariantConst();
+        }
+        else
+        {
+            char* end;
+            double number = strtod(text, &end);
+            if (end == text)
+                return DeserializationError::InvalidInput;
+            text = end;
+            document.m_members[key] = JsonVariantConst::fromNumber(number);
+        }
+        skipSpace(text);
+        if (*text == '}')
+            return DeserializationError::Ok;
+        if (*text++ != ',')
+            return DeserializationError::InvalidInput;
+    }
+}
@@ -0,0 +1,8 @@
+#pragma once
+// Host replacement of ESP8266WiFi, network is never used by tested modules
+#include <Arduino.h>
+
+class WiFiClient
+{
+
+};
@@ -0,0 +1,108 @@
+#pragma once
+// Host replacement of LittleFS, files are kept in memory for the whole run
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class File
+{
+public:
+
+    File() : m_position(0) {}
+
+    File(std::shared_ptr<std::vector<uint8_t>> data) : m_data(data), m_position(0) {}
+
+    explicit operator bool() const
+    {
+        return m_data != nullptr;
+    }
+
+    size_t size() const
+    {
+        return m_data ? m_data->size() : 0;
+    }
+
+    bool seek(uint32_t position)
+    {
+        if (!m_data || (position > m_data->size()))
+            return false;
+        m_position = position;
+        return true;
+    }
+
+    size_t read(uint8_t* buffer, size_t length)
+    {
+        if (!m_data)
+            return 0;
+        size_t count = min(length, m_data->size() - m_position);
+        memcpy(buffer, m_data->data() + m_position, count);
+        m_position += count;
+        return count;
+    }
+
+    size_t write(const uint8_t* buffer, size_t length)
+    {
+        if (!m_data)
+            return 0;
+        if (m_position + length > m_data->size())
+            m_data->resize(m_position + length);
+        memcpy(m_data->data() + m_position, buffer, length);
+        m_position += length;
+        return length;
+    }
+
+    void close()
+    {
+        m_data = nullptr;
+    }
+
+private:
+
+    std::shared_ptr<std::vector<uint8_t>> m_data;
+    size_t m_position;
+};
+
+class HostFS
+{
+public:
+
+    bool begin(bool formatOnFail = false)
+    {
+        return true;
+    }
+
+    bool exists(const char* path) const
+    {
+        return m_files.count(path) > 0;
+    }
+
+    // Modes "r", "r+", "w" (truncates) and "a" (appends) are supported
+    File open(const char* path, const char* mode)
+    {
+        auto file = m_files.find(path);
+        if ((strcmp(mode, "w") == 0) || ((strcmp(mode, "a") == 0) && (file == m_files.end())))
+        {
+            m_files[path] = std::make_shared<std::vector<uint8_t>>();
+            return File(m_files[path]);
+        }
+        if (file == m_files.end())
+            return File();
+        File result(file->second);
+        if (strcmp(mode, "a") == 0)
+            result.seek(result.size());
+        return result;
+    }
+
+    bool remove(const char* path)
+    {
+        return m_files.erase(path) > 0;
+    }
+
+private:
+
+    std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> m_files;
+};
+
+inline HostFS LittleFS;
@@ -0,0 +1,8 @@
+#pragma once
+// Host replacement of PubSubClient, MQTT is faked by the test harness
+#include <Arduino.h>
+
+class PubSubClient
+{
+
+};
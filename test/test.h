@@ -0,0 +1,36 @@
+#pragma once
+#include <stdio.h>
+#include <math.h>
+#include "host.h"
+
+// Minimal test runner, test cases register themselves and run in file order
+class TestCase
+{
+public:
+
+    typedef void (*Function)();
+
+    TestCase(const char* name, Function function);
+
+    static bool check(bool condition, const char* expression, const char* file, int line);
+
+    static bool checkNear(double expected, double actual, double tolerance, const char* expression, const char* file, int line);
+
+    static int runAll();
+
+private:
+
+    const char* m_name;
+    Function m_function;
+    TestCase* m_next;
+};
+
+#define TEST(name) \
+    static void name(); \
+    static TestCase name##Case(#name, name); \
+    static void name()
+
+#define CHECK(condition) TestCase::check((condition), #condition, __FILE__, __LINE__)
+
+#define CHECK_NEAR(expected, actual, tolerance) \
+    TestCase::checkNear((expected), (actual), (tolerance), #actual, __FILE__, __LINE__)
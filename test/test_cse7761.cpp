@@ -0,0 +1,340 @@
+#include "test.h"
+#include <deque>
+#include <map>
+#include <vector>
+#include "config.h"
+#include "cse7761.h"
+#include "power_meas_capture.h"
+
+// Simulated CSE7761 on Serial1, answers read frames from its register file.
+// Response starts when the request has left the line and comes byte by byte.
+class Cse7761Chip
+{
+public:
+
+    struct Write
+    {
+        uint64_t timeMicro;
+        uint8_t command;
+        uint32_t value;
+    };
+
+    Cse7761Chip() :
+        m_corruptReads(0),
+        m_silentReads(0),
+        m_waveAmplitude(0)
+    {
+        m_registers[0x7f] = 0x776110;
+        m_registers[0x43] = 0x10;
+        m_registers[0x00] = 0xff04;
+        Serial1.setWriteHandler([this](HardwareSerial& serial, const uint8_t* data, size_t length) {
+            onFrame(serial, data, length);
+        });
+    }
+
+    void setRegister(uint8_t reg, uint32_t value)
+    {
+        m_registers[reg] = value;
+    }
+
+    uint32_t getReadCount(uint8_t reg) const
+    {
+        auto count = m_readCounts.find(reg);
+        return (count == m_readCounts.end()) ? 0 : count->second;
+    }
+
+    uint64_t getFirstReadMicro(uint8_t reg) const
+    {
+        auto time = m_firstReads.find(reg);
+        return (time == m_firstReads.end()) ? 0 : time->second;
+    }
+
+    const std::vector<Write>& getWrites() const
+    {
+        return m_writes;
+    }
+
+    // Next reads are answered with wrong checksum or not at all
+    void corruptReads(uint32_t count)
+    {
+        m_corruptReads = count;
+    }
+
+    void dropReads(uint32_t count)
+    {
+        m_silentReads = count;
+    }
+
+    // Waveform registers return 50 Hz sine of this raw amplitude
+    void setWaveAmplitude(int32_t amplitude)
+    {
+        m_waveAmplitude = amplitude;
+    }
+
+    // Moves response bytes which are already on the line to receive buffer
+    void transmit()
+    {
+        while (!m_response.empty() && (m_response.front().timeMicro <= Host::getMicro()))
+        {
+            Serial1.inject(&m_response.front().value, 1);
+            m_response.pop_front();
+        }
+    }
+
+private:
+
+    struct ResponseByte
+    {
+        uint64_t timeMicro;
+        uint8_t value;
+    };
+
+    static uint8_t getWidth(uint8_t reg)
+    {
+        switch(reg)
+        {
+            case 0x43:
+                return 1;
+            case 0x24: case 0x25: case 0x26: case 0x36: case 0x37: case 0x7f:
+                return 3;
+            case 0x2c: case 0x2d:
+                return 4;
+            default:
+                return 2;
+        }
+    }
+
+    void onFrame(HardwareSerial& serial, const uint8_t* data, size_t length)
+    {
+        if ((length < 2) || (data[0] != 0xa5))
+            return;
+        if (length > 2)
+        {
+            uint32_t value = 0;
+            for(size_t i = 2; i < length - 1; i++)
+                value = (value << 8) | data[i];
+            m_writes.push_back({ Host::getMicro(), data[1], value });
+            return;
+        }
+        uint8_t reg = data[1];
+        m_readCounts[reg]++;
+        if (m_firstReads.count(reg) == 0)
+            m_firstReads[reg] = Host::getMicro();
+        if (m_silentReads > 0)
+        {
+            m_silentReads--;
+            return;
+        }
+        uint32_t value = m_registers[reg];
+        if ((reg == 0x36) || (reg == 0x37))
+            value = (uint32_t)(int32_t)(m_waveAmplitude * sin(2 * M_PI * 50 * Host::getMicro() / 1e6)) & 0xffffff;
+        uint8_t width = getWidth(reg);
+        uint8_t response[5];
+        uint8_t checksum = data[0] + data[1];
+        for(uint8_t i = 0; i < width; i++)
+        {
+            response[i] = (value >> (8 * (width - 1 - i))) & 0xff;
+            checksum += response[i];
+        }
+        response[width] = ~checksum;
+        if (m_corruptReads > 0)
+        {
+            m_corruptReads--;
+            response[width] ^= 0x5a;
+        }
+        uint64_t time = max(serial.getTxEndMicro(), m_response.empty() ? 0 : m_response.back().timeMicro);
+        for(uint8_t i = 0; i <= width; i++)
+        {
+            time += serial.getByteMicro();
+            m_response.push_back({ time, response[i] });
+        }
+    }
+
+    std::map<uint8_t, uint32_t> m_registers;
+    std::map<uint8_t, uint32_t> m_readCounts;
+    std::map<uint8_t, uint64_t> m_firstReads;
+    std::vector<Write> m_writes;
+    std::deque<ResponseByte> m_response;
+    uint32_t m_corruptReads;
+    uint32_t m_silentReads;
+    int32_t m_waveAmplitude;
+};
+
+static const uint8_t REG_RMSIA = 0x24;
+static const uint8_t REG_RMSU = 0x26;
+static const uint8_t REG_RMSIAC = 0x70;
+static const uint8_t REG_SPECIAL = 0xea;
+// Default calibration used by the driver
+static const float UREF = 42563;
+static const float IREF = 52241;
+// Time slice of one process pass of the driver
+static const uint32_t PROCESS_BUDGET_MICRO = 300;
+
+static uint32_t s_samples = 0;
+static uint32_t s_values = 0;
+static uint64_t s_lastSampleTime = 0;
+static bool s_timeWentBack = false;
+static uint64_t s_maxProcessMicro = 0;
+
+static void onSample(const PowerMeasDevice& device, uint64_t sampleTimeMilli)
+{
+    s_samples++;
+    s_timeWentBack |= sampleTimeMilli < s_lastSampleTime;
+    s_lastSampleTime = sampleTimeMilli;
+}
+
+static void onValue(const PowerMeasDevice& device, uint8_t index, uint64_t sampleTimeMilli)
+{
+    s_values++;
+    s_timeWentBack |= sampleTimeMilli < s_lastSampleTime;
+    s_lastSampleTime = sampleTimeMilli;
+}
+
+// Loop passes come every 200 us, a response of 3 to 5 bytes spans several of them
+static void pass(Cse7761Chip& chip, CSE7761& cse)
+{
+    chip.transmit();
+    uint64_t before = Host::getMicro();
+    cse.process();
+    s_maxProcessMicro = max(s_maxProcessMicro, Host::getMicro() - before);
+    Host::advanceMicro(200);
+}
+
+static void run(Cse7761Chip& chip, CSE7761& cse, uint32_t milli)
+{
+    uint64_t end = Host::getMicro() + (uint64_t)milli * 1000;
+    while (Host::getMicro() < end)
+        pass(chip, cse);
+}
+
+// Detect, reset and init take a bit more than two seconds
+static void start(Cse7761Chip& chip, CSE7761& cse)
+{
+    s_samples = 0;
+    s_values = 0;
+    s_lastSampleTime = 0;
+    s_timeWentBack = false;
+    s_maxProcessMicro = 0;
+    Config::setInt("cse7761/serial", 1);
+    cse.setSampleListener(onSample);
+    cse.setValueListener(onValue);
+    cse.init();
+    run(chip, cse, 3000);
+}
+
+TEST(initWaitsForResetBeforeReadingCoefficients)
+{
+    Cse7761Chip chip;
+    CSE7761 cse;
+    start(chip, cse);
+    uint64_t resetMicro = 0;
+    for(const Cse7761Chip::Write& write : chip.getWrites())
+    {
+        if ((write.command == REG_SPECIAL) && (write.value == 0x96))
+            resetMicro = write.timeMicro;
+    }
+    CHECK(resetMicro > 0);
+    CHECK(chip.getFirstReadMicro(REG_RMSIAC) >= resetMicro + 1000000);
+    CHECK(chip.getReadCount(REG_RMSU) > 0);
+}
+
+TEST(refreshBatchEmitsOneSampleWithScaledValues)
+{
+    Cse7761Chip chip;
+    chip.setRegister(REG_RMSU, 2266500);
+    chip.setRegister(REG_RMSIA, 1000000);
+    CSE7761 cse;
+    start(chip, cse);
+    uint32_t samples = s_samples;
+    uint32_t reads = chip.getReadCount(REG_RMSU);
+    CHECK(samples > 0);
+    run(chip, cse, 2000);
+    // Idle refresh period is 500 ms, every batch is one sample
+    CHECK(s_samples - samples == chip.getReadCount(REG_RMSU) - reads);
+    CHECK(s_samples - samples >= 3);
+    CHECK_NEAR(0.01 * 2266500 * UREF / 0x400000, cse.getLastValue(0), 0.01);
+    CHECK_NEAR(0.001 * 1000000 * IREF / 0x800000, cse.getLastValue(2), 0.0001);
+    // Sample time is when the batch was scheduled, not when the last register arrived
+    CHECK(s_lastSampleTime <= Host::getMicro() / 1000);
+    // Driver never waits for the line
+    CHECK(s_maxProcessMicro <= PROCESS_BUDGET_MICRO);
+}
+
+TEST(partlyReceivedRegisterIsCompletedByLaterPass)
+{
+    Cse7761Chip chip;
+    chip.setRegister(REG_RMSU, 2266500);
+    CSE7761 cse;
+    start(chip, cse);
+    // Stop in the middle of the voltage response, 4 bytes take about 1.1 ms
+    uint32_t reads = chip.getReadCount(REG_RMSU);
+    chip.setRegister(REG_RMSU, 1133250);
+    while (chip.getReadCount(REG_RMSU) == reads)
+        pass(chip, cse);
+    while (Serial1.available() < 2)
+        pass(chip, cse);
+    CHECK(Serial1.available() < 4);
+    CHECK(cse.getLastValue(0) > 200);
+    // Rest of the response comes with next passes
+    run(chip, cse, 2);
+    CHECK_NEAR(0.01 * 1133250 * UREF / 0x400000, cse.getLastValue(0), 0.01);
+    CHECK(s_maxProcessMicro <= PROCESS_BUDGET_MICRO);
+}
+
+TEST(badChecksumDropsOnlyItsBatch)
+{
+    Cse7761Chip chip;
+    CSE7761 cse;
+    start(chip, cse);
+    // Next refresh fails in the middle of the batch
+    run(chip, cse, 500);
+    uint32_t samples = s_samples;
+    uint32_t reads = chip.getReadCount(REG_RMSU);
+    chip.corruptReads(1);
+    run(chip, cse, 1600);
+    uint32_t batches = chip.getReadCount(REG_RMSU) - reads;
+    CHECK(batches >= 3);
+    CHECK(s_samples - samples == batches - 1);
+    CHECK(s_maxProcessMicro <= PROCESS_BUDGET_MICRO);
+}
+
+TEST(receiveTimeoutMovesQueueOn)
+{
+    Cse7761Chip chip;
+    CSE7761 cse;
+    start(chip, cse);
+    run(chip, cse, 500);
+    uint32_t samples = s_samples;
+    uint32_t reads = chip.getReadCount(REG_RMSU);
+    chip.dropReads(1);
+    run(chip, cse, 1600);
+    uint32_t batches = chip.getReadCount(REG_RMSU) - reads;
+    CHECK(batches >= 3);
+    CHECK(s_samples - samples == batches - 1);
+    CHECK(s_maxProcessMicro <= PROCESS_BUDGET_MICRO);
+}
+
+TEST(captureReadsFillIdleLineWithoutStarvingRefresh)
+{
+    Cse7761Chip chip;
+    chip.setWaveAmplitude(1000000);
+    CSE7761 cse;
+    start(chip, cse);
+    PowerMeasCapture::setConfig("{\"enabled\":true,\"channel_up\":0,\"channel_down\":1,\"window_milli\":40,\"emit_milli\":20}");
+    Host::setActiveDevice(&cse);
+    cse.setFastRefresh(true);
+    uint32_t reads = chip.getReadCount(REG_RMSU);
+    uint32_t samples = s_samples;
+    PowerMeasCapture::start(true);
+    run(chip, cse, 1000);
+    PowerMeasCapture::stop();
+    // Fast refresh period is 100 ms, waveform reads are queued only on empty queue
+    CHECK(chip.getReadCount(REG_RMSU) - reads >= 9);
+    // RMS is reported every 20 ms on its own, batches stay one sample each
+    CHECK(s_values >= 40);
+    CHECK(s_samples - samples <= chip.getReadCount(REG_RMSU) - reads);
+    CHECK(!s_timeWentBack);
+    CHECK(PowerMeasCapture::getSampleCount() > 300);
+    CHECK(PowerMeasCapture::getSampleRate() > 300);
+    CHECK_NEAR(0.001 * 1000000 / sqrt(2) * IREF / 0x800000, cse.getLastValue(6), 0.3);
+}
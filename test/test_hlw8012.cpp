@@ -0,0 +1,145 @@
+#include "test.h"
+#include "config.h"
+#include "hlw8012.h"
+
+static const uint8_t CF_GPIO = 4;
+static const uint8_t CF1_GPIO = 5;
+static const uint8_t SEL_GPIO = 12;
+// HLW8012 transfer with default divider and shunt, values per Hz
+static const double POWER_PER_HZ = 2.43 * 2.43 * 2351 * 128 / (48 * 3579000 * 0.001);
+static const double CURRENT_PER_HZ = 2.43 * 512 / (24 * 3579000 * 0.001);
+static const double VOLTAGE_PER_HZ = 2.43 * 2351 * 512 / (2 * 3579000.0);
+
+// Simulated chip outputs, CF1 frequency follows the SEL pin (low selects current)
+struct PulseSource
+{
+    double cfHz;
+    double currentHz;
+    double voltageHz;
+    uint64_t nextCfMicro;
+    uint64_t nextCf1Micro;
+    uint32_t cfEdges;
+};
+
+static uint64_t nextEdge(uint64_t now, double hz)
+{
+    return (hz > 0) ? now + (uint64_t)(1000000 / hz) : UINT64_MAX;
+}
+
+static double getCf1Hz(const PulseSource& source)
+{
+    return (Host::getPinLevel(SEL_GPIO) == LOW) ? source.currentHz : source.voltageHz;
+}
+
+static void start(HLW8012& hlw, PulseSource& source)
+{
+    hlw.init();
+    // Edges are not aligned with refresh
+    source.nextCfMicro = nextEdge(Host::getMicro() + 1234, source.cfHz);
+    source.nextCf1Micro = nextEdge(Host::getMicro() + 567, getCf1Hz(source));
+    source.cfEdges = 0;
+}
+
+// Frequencies may be changed between runs, next edge is planned from the new one
+static void run(HLW8012& hlw, PulseSource& source, uint32_t milli)
+{
+    uint64_t end = Host::getMicro() + (uint64_t)milli * 1000;
+    uint64_t nextProcess = Host::getMicro();
+    if (source.nextCfMicro == UINT64_MAX)
+        source.nextCfMicro = nextEdge(Host::getMicro(), source.cfHz);
+    if (source.nextCf1Micro == UINT64_MAX)
+        source.nextCf1Micro = nextEdge(Host::getMicro(), getCf1Hz(source));
+    while (true)
+    {
+        uint64_t next = min(nextProcess, min(source.nextCfMicro, source.nextCf1Micro));
+        if (next >= end)
+            break;
+        Host::setMicro(next);
+        if (next == source.nextCfMicro)
+        {
+            Host::fireInterrupt(CF_GPIO);
+            source.cfEdges++;
+            source.nextCfMicro = nextEdge(next, source.cfHz);
+        }
+        if (next == source.nextCf1Micro)
+        {
+            Host::fireInterrupt(CF1_GPIO);
+            source.nextCf1Micro = nextEdge(next, getCf1Hz(source));
+        }
+        if (next == nextProcess)
+        {
+            hlw.process();
+            nextProcess += 10000;
+        }
+    }
+    Host::setMicro(end);
+}
+
+TEST(powerFrequencyIsNotQuantizedByRefresh)
+{
+    HLW8012 hlw;
+    PulseSource source = { 37.3, 0, 0 };
+    start(hlw, source);
+    hlw.setFastRefresh(true);
+    run(hlw, source, 2000);
+    // Fixed 100 ms windows would see 3 or 4 edges, 30 or 40 Hz
+    CHECK_NEAR(37.3 * POWER_PER_HZ, hlw.getLastValue(2), 37.3 * POWER_PER_HZ * 0.002);
+    // Energy counts every edge, up to four came after the last refresh
+    CHECK(hlw.getLastValue(3) <= source.cfEdges * POWER_PER_HZ / 3600 * 1.0001);
+    CHECK(hlw.getLastValue(3) >= (source.cfEdges - 4) * POWER_PER_HZ / 3600 * 0.9999);
+}
+
+TEST(powerFollowsFrequencyChange)
+{
+    HLW8012 hlw;
+    PulseSource source = { 100, 0, 0 };
+    start(hlw, source);
+    hlw.setFastRefresh(true);
+    run(hlw, source, 1000);
+    CHECK_NEAR(100 * POWER_PER_HZ, hlw.getLastValue(2), 100 * POWER_PER_HZ * 0.002);
+    source.cfHz = 200;
+    run(hlw, source, 300);
+    CHECK_NEAR(200 * POWER_PER_HZ, hlw.getLastValue(2), 200 * POWER_PER_HZ * 0.002);
+}
+
+TEST(currentIsMeasuredWhileFast)
+{
+    HLW8012 hlw;
+    PulseSource source = { 0, 523.7, 1000 };
+    start(hlw, source);
+    hlw.setFastRefresh(true);
+    run(hlw, source, 15000);
+    CHECK(Host::getPinLevel(SEL_GPIO) == LOW);
+    CHECK_NEAR(523.7 * CURRENT_PER_HZ, hlw.getLastValue(1), 523.7 * CURRENT_PER_HZ * 0.002);
+    // Voltage is never selected while motor runs
+    CHECK(hlw.getLastValue(0) == 0);
+}
+
+TEST(voltageIsMeasuredWhenIdle)
+{
+    HLW8012 hlw;
+    PulseSource source = { 0, 523.7, 91.1 };
+    start(hlw, source);
+    run(hlw, source, 12000);
+    CHECK_NEAR(91.1 * VOLTAGE_PER_HZ, hlw.getLastValue(0), 91.1 * VOLTAGE_PER_HZ * 0.002);
+    // Current edges before the switch do not leak into voltage and back
+    CHECK_NEAR(523.7 * CURRENT_PER_HZ, hlw.getLastValue(1), 523.7 * CURRENT_PER_HZ * 0.002);
+}
+
+TEST(silenceBoundsFrequencyThenZeroes)
+{
+    HLW8012 hlw;
+    PulseSource source = { 50, 0, 0 };
+    start(hlw, source);
+    hlw.setFastRefresh(true);
+    run(hlw, source, 1000);
+    CHECK_NEAR(50 * POWER_PER_HZ, hlw.getLastValue(2), 50 * POWER_PER_HZ * 0.002);
+    source.cfHz = 0;
+    source.nextCfMicro = UINT64_MAX;
+    run(hlw, source, 2000);
+    // Period is at least the silence, almost two seconds at the last refresh
+    CHECK(hlw.getLastValue(2) > 0);
+    CHECK(hlw.getLastValue(2) <= POWER_PER_HZ / 1.8);
+    run(hlw, source, 9000);
+    CHECK(hlw.getLastValue(2) == 0);
+}
@@ -0,0 +1,203 @@
+#include "test.h"
+#include "louver.h"
+
+// Louver is a singleton, its timestamps stay valid only if the clock never
+// goes back, so every test continues where the previous one ended
+static uint64_t s_clock = 10000000;
+static uint32_t s_seed = 7;
+
+static uint32_t random(uint32_t range)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+    return ((s_seed >> 8) & 0xffffff) % range;
+}
+
+// Motor moved by relays with start and stop lag, position in %, 100 = closed
+class Motor
+{
+public:
+
+    Motor(float timeUpSecs, float timeDownSecs, uint32_t lagUp[2], uint32_t lagDown[2]) :
+        m_position(37),
+        m_state(OFF),
+        m_onMicro(0),
+        m_offMicro(0)
+    {
+        bool keyActiveHigh, pullEnabled;
+        uint8_t pinKey;
+        Louver::getGpioConfig(Louver::DIR_UP, pinKey, m_pinUp, keyActiveHigh, m_upActiveHigh, pullEnabled);
+        Louver::getGpioConfig(Louver::DIR_DOWN, pinKey, m_pinDown, keyActiveHigh, m_downActiveHigh, pullEnabled);
+        m_fullMicro[UP] = timeUpSecs * 1000000;
+        m_fullMicro[DOWN] = timeDownSecs * 1000000;
+        m_startLagMicro[UP] = lagUp[0] * 1000;
+        m_stopLagMicro[UP] = lagUp[1] * 1000;
+        m_startLagMicro[DOWN] = lagDown[0] * 1000;
+        m_stopLagMicro[DOWN] = lagDown[1] * 1000;
+    }
+
+    // Called after anything that may switch relays
+    void observe()
+    {
+        State state = OFF;
+        if (Host::getPinLevel(m_pinUp) == (m_upActiveHigh ? HIGH : LOW))
+            state = UP;
+        else if (Host::getPinLevel(m_pinDown) == (m_downActiveHigh ? HIGH : LOW))
+            state = DOWN;
+        if (state == m_state)
+            return;
+        uint64_t now = Host::getMicro();
+        if (m_state != OFF)
+        {
+            // Motor starts after start lag and coasts for stop lag
+            int64_t runMicro = (int64_t)(now - m_onMicro) - m_startLagMicro[m_state];
+            if (runMicro > 0)
+            {
+                double travel = (double)(runMicro + m_stopLagMicro[m_state]) * 100 / m_fullMicro[m_state];
+                m_position += (m_state == UP) ? -travel : travel;
+                m_position = max(0.0, min(100.0, m_position));
+            }
+            m_offMicro = now;
+        }
+        m_state = state;
+        m_onMicro = now;
+    }
+
+    bool isRunning() const
+    {
+        return m_state != OFF;
+    }
+
+    uint64_t getOffMicro() const
+    {
+        return m_offMicro;
+    }
+
+    double getPosition() const
+    {
+        return m_position;
+    }
+
+private:
+
+    enum State
+    {
+        UP = 0,
+        DOWN,
+        OFF
+    };
+
+    uint8_t m_pinUp;
+    uint8_t m_pinDown;
+    bool m_upActiveHigh;
+    bool m_downActiveHigh;
+    int64_t m_fullMicro[2];
+    int64_t m_startLagMicro[2];
+    int64_t m_stopLagMicro[2];
+    double m_position;
+    State m_state;
+    uint64_t m_onMicro;
+    uint64_t m_offMicro;
+};
+
+static uint32_t LAG_UP[2] = { 150, 80 };
+static uint32_t LAG_DOWN[2] = { 120, 60 };
+
+static void start()
+{
+    Host::setMicro(s_clock);
+    Louver::setDefaults();
+    Louver::configureTimes(30, 28, 2, 0.25);
+    Louver::configureMotorLag(Louver::DIR_UP, LAG_UP[0], LAG_UP[1]);
+    Louver::configureMotorLag(Louver::DIR_DOWN, LAG_DOWN[0], LAG_DOWN[1]);
+}
+
+// Loop passes come at irregular times, step timer interrupt exactly when due.
+// Returns when relays are off for a while after the movement.
+static void runMovement(Motor& motor)
+{
+    uint64_t commandMicro = Host::getMicro();
+    while (true)
+    {
+        uint64_t next = Host::getMicro() + 1000 + random(19000);
+        uint64_t timer = Host::getTimer1Micro();
+        if ((timer != 0) && (timer <= next))
+        {
+            Host::setMicro(timer);
+            Host::fireTimer1();
+            motor.observe();
+        }
+        Host::setMicro(next);
+        Louver::process();
+        motor.observe();
+        uint64_t lastActivity = max(commandMicro, motor.getOffMicro());
+        if (!motor.isRunning() && (Host::getMicro() > lastActivity + 500000))
+            break;
+    }
+    s_clock = Host::getMicro();
+}
+
+// Full close is longer than timer1 range, motor position is unknown before
+static void home(Motor& motor)
+{
+    Louver::fullClose();
+    runMovement(motor);
+}
+
+TEST(randomShortMovesKeepPositionBounded)
+{
+    start();
+    Motor motor(30, 28, LAG_UP, LAG_DOWN);
+    home(motor);
+    CHECK(motor.getPosition() == 100);
+    CHECK(Louver::getPosition() == 100);
+
+    double maxError = 0;
+    double maxTargetError = 0;
+    for(uint32_t move = 0; move < 10000; move++)
+    {
+        float position = Louver::getPosition();
+        if (random(2) == 0)
+        {
+            // Target 1 to 10 % away, inside of the travel
+            float delta = (float)(100 + random(900)) / 100;
+            float target = ((random(2) == 0) || (position + delta > 98)) && (position - delta > 2) ? position - delta : position + delta;
+            Louver::moveToPosition(target);
+            runMovement(motor);
+            maxTargetError = max(maxTargetError, fabs(motor.getPosition() - target));
+        }
+        else
+        {
+            // Up to a second, shortest ones do not get over start lag
+            float timeSecs = (float)(50 + random(950)) / 1000;
+            if (((random(2) == 0) || (position > 90)) && (position > 10))
+                Louver::shortOpen(timeSecs);
+            else
+                Louver::shortClose(timeSecs);
+            runMovement(motor);
+        }
+        maxError = max(maxError, fabs(motor.getPosition() - Louver::getPosition()));
+    }
+    // Integration error of all moves together stays within float resolution
+    CHECK(maxError < 0.01);
+    // Lag compensation and 1 ms step resolution
+    CHECK(maxTargetError < 0.02);
+}
+
+TEST(moveShorterThanStartLagDoesNotMove)
+{
+    start();
+    Motor motor(30, 28, LAG_UP, LAG_DOWN);
+    home(motor);
+    Louver::moveToPosition(50);
+    runMovement(motor);
+    float position = Louver::getPosition();
+    double motorPosition = motor.getPosition();
+    Louver::shortClose(0.1);
+    runMovement(motor);
+    CHECK(motor.getPosition() == motorPosition);
+    CHECK(Louver::getPosition() == position);
+    Louver::shortOpen(0.2);
+    runMovement(motor);
+    CHECK(motor.getPosition() < motorPosition);
+    CHECK(fabs(motor.getPosition() - Louver::getPosition()) < 0.001);
+}
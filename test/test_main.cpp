@@ -0,0 +1,62 @@
+#include "test.h"
+
+static TestCase* s_first = nullptr;
+static TestCase* s_last = nullptr;
+static uint32_t s_failures = 0;
+
+TestCase::TestCase(const char* name, Function function) :
+    m_name(name),
+    m_function(function),
+    m_next(nullptr)
+{
+    if (s_last)
+        s_last->m_next = this;
+    else
+        s_first = this;
+    s_last = this;
+}
+
+bool TestCase::check(bool condition, const char* expression, const char* file, int line)
+{
+    if (!condition)
+    {
+        printf("  %s:%d: check failed: %s\n", file, line, expression);
+        s_failures++;
+    }
+    return condition;
+}
+
+bool TestCase::checkNear(double expected, double actual, double tolerance, const char* expression, const char* file, int line)
+{
+    bool near = fabs(expected - actual) <= tolerance;
+    if (!near)
+    {
+        printf("  %s:%d: %s = %g, expected %g +- %g\n", file, line, expression, actual, expected, tolerance);
+        s_failures++;
+    }
+    return near;
+}
+
+int TestCase::runAll()
+{
+    uint32_t failedCases = 0;
+    uint32_t count = 0;
+    for(TestCase* test = s_first; test; test = test->m_next)
+    {
+        uint32_t failures = s_failures;
+        Host::reset();
+        test->m_function();
+        count++;
+        if (s_failures != failures)
+            failedCases++;
+        printf("%-48s %s\n", test->m_name, (s_failures == failures) ? "ok" : "FAILED");
+    }
+    printf("%d of %d test cases passed\n", count - failedCases, count);
+    return (failedCases == 0) ? 0 : 1;
+}
+
+int main()
+{
+    Host::setLogPrinted(getenv("TEST_VERBOSE") != nullptr);
+    return TestCase::runAll();
+}
@@ -0,0 +1,138 @@
+#include "test.h"
+#include "motion_analyzer.h"
+
+class TestDevice : public PowerMeasDevice
+{
+public:
+
+    TestDevice()
+    {
+        static constexpr DescriptorInfo descriptors[] = {
+            { "Voltage RMS", "V", ".1f", "voltage", true },
+            { "Current RMS 1", "A", ".3f", "current1", true },
+            { "Current RMS 2", "A", ".3f", "current2", true }
+        };
+        setDescriptors(descriptors, 3);
+    }
+
+    void setValue(uint8_t index, float value)
+    {
+        setLastValue(index, value);
+    }
+};
+
+// Inrush 700 ms, plateau after 3 samples, drop below 30 %, rise above 160 %
+static const char* CONFIG = "{\"enabled\":true,\"value_up\":\"current1\",\"value_down\":\"current2\"}";
+// Last sample of this length is still inside of inrush
+static const uint32_t INRUSH_MILLI = 600;
+
+// Samples every 100 ms, value of the channel is constant for the whole run
+static void feed(TestDevice& device, uint8_t index, float value, uint32_t milli)
+{
+    for(uint32_t time = 0; time < milli; time += 100)
+    {
+        Host::advanceMilli(100);
+        device.setValue(index, value);
+        MotionAnalyzer::onSample(device, Host::getMicro() / 1000);
+    }
+}
+
+static void start(bool directionUp)
+{
+    MotionAnalyzer::setConfig(CONFIG);
+    MotionAnalyzer::start(directionUp);
+}
+
+TEST(dropAfterPlateauIsEndStop)
+{
+    TestDevice device;
+    start(true);
+    feed(device, 1, 2.0, INRUSH_MILLI);
+    feed(device, 1, 0.5, 2000);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_NONE);
+    feed(device, 1, 0.1, 100);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_END_STOP);
+    CHECK(MotionAnalyzer::getEventTimeMilli() == INRUSH_MILLI + 2100);
+    CHECK(Host::getMovementEventCount() == 1);
+    CHECK(strcmp(Host::getLastMovementEvent(), "end_stop") == 0);
+    // Event is taken once and nothing follows until next start
+    feed(device, 1, 2.0, 500);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_NONE);
+    CHECK(Host::getMovementEventCount() == 1);
+}
+
+TEST(riseAfterPlateauIsObstruction)
+{
+    TestDevice device;
+    start(true);
+    feed(device, 1, 2.0, INRUSH_MILLI);
+    feed(device, 1, 0.5, 1000);
+    feed(device, 1, 0.9, 100);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_OBSTRUCTION);
+    CHECK(strcmp(Host::getLastMovementEvent(), "obstruction") == 0);
+}
+
+TEST(inrushIsIgnored)
+{
+    TestDevice device;
+    start(true);
+    // Spikes and gaps of starting motor
+    feed(device, 1, 3.0, 200);
+    feed(device, 1, 0.0, 200);
+    feed(device, 1, 5.0, 200);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_NONE);
+    feed(device, 1, 0.5, 2000);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_NONE);
+    CHECK(Host::getMovementEventCount() == 0);
+}
+
+TEST(slowPlateauChangeIsFollowed)
+{
+    TestDevice device;
+    start(true);
+    feed(device, 1, 2.0, INRUSH_MILLI);
+    // Load of the louver grows slowly along the way
+    for(uint32_t step = 0; step < 20; step++)
+        feed(device, 1, 0.5 + step * 0.05, 200);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_NONE);
+    feed(device, 1, 0.3, 100);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_END_STOP);
+}
+
+TEST(downMovementWatchesItsChannel)
+{
+    TestDevice device;
+    start(false);
+    device.setValue(1, 0.5);
+    feed(device, 2, 2.0, INRUSH_MILLI);
+    feed(device, 2, 0.5, 1000);
+    // Other channel does not matter
+    device.setValue(1, 0);
+    feed(device, 2, 0.5, 500);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_NONE);
+    feed(device, 2, 0.05, 100);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_END_STOP);
+}
+
+TEST(plateauBelowMinimumIsNotWatched)
+{
+    TestDevice device;
+    start(true);
+    feed(device, 1, 0.5, INRUSH_MILLI);
+    feed(device, 1, 0.02, 1000);
+    feed(device, 1, 0.0, 100);
+    feed(device, 1, 0.04, 100);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_NONE);
+}
+
+TEST(stoppedAnalyzerIgnoresSamples)
+{
+    TestDevice device;
+    start(true);
+    feed(device, 1, 2.0, INRUSH_MILLI);
+    feed(device, 1, 0.5, 1000);
+    MotionAnalyzer::stop();
+    feed(device, 1, 0.0, 500);
+    CHECK(MotionAnalyzer::takeEvent() == MotionAnalyzer::EV_NONE);
+    CHECK(Host::getMovementEventCount() == 0);
+}
@@ -0,0 +1,256 @@
+#include "test.h"
+#include <chrono>
+#include <string>
+#include <vector>
+#include <LittleFS.h>
+#include "power_meas_archive.h"
+
+// Archive is a singleton and the file system lives for the whole run, so every
+// test writes its own time range and reads only that range back
+class TestDevice : public PowerMeasDevice
+{
+public:
+
+    static constexpr uint8_t CHANNELS = 3;
+
+    TestDevice()
+    {
+        static constexpr DescriptorInfo descriptors[CHANNELS] = {
+            { "Voltage RMS", "V", ".1f", "voltage", true },
+            { "Current RMS", "A", ".3f", "current", true },
+            { "Power", "W", ".1f", "power", true }
+        };
+        setDescriptors(descriptors, CHANNELS);
+    }
+
+    void setValue(uint8_t index, float value)
+    {
+        setLastValue(index, value);
+    }
+};
+
+struct Sample
+{
+    uint32_t time;
+    float values[TestDevice::CHANNELS];
+};
+
+static uint32_t s_seed = 1;
+
+static uint32_t random(uint32_t range)
+{
+    s_seed = s_seed * 1103515245 + 12345;
+    return ((s_seed >> 8) & 0xffffff) % range;
+}
+
+static void record(TestDevice& device, std::vector<Sample>& samples, uint32_t time)
+{
+    Sample sample;
+    sample.time = time;
+    for(uint8_t i = 0; i < TestDevice::CHANNELS; i++)
+    {
+        sample.values[i] = device.getLastValue(i);
+    }
+    Host::setEpoch(time);
+    PowerMeasArchive::process();
+    samples.push_back(sample);
+}
+
+static std::vector<Sample> readBack(uint8_t channel, uint32_t fromTime, uint32_t toTime)
+{
+    PowerMeasArchive::Reader reader(channel, fromTime, toTime);
+    std::string csv;
+    uint8_t buffer[300];
+    size_t length;
+    while ((length = reader.read(buffer, sizeof(buffer))) > 0)
+        csv.append((const char*)buffer, length);
+    std::vector<Sample> samples;
+    size_t start = csv.find('\n') + 1;
+    while (start < csv.size())
+    {
+        size_t end = csv.find('\n', start);
+        std::string line = csv.substr(start, end - start);
+        Sample sample = {};
+        char* next;
+        sample.time = strtoul(line.c_str(), &next, 10);
+        for(uint8_t i = 0; (i < TestDevice::CHANNELS) && (*next == ','); i++)
+            sample.values[i] = strtof(next + 1, &next);
+        samples.push_back(sample);
+        start = end + 1;
+    }
+    return samples;
+}
+
+static bool sameSample(const Sample& expected, const Sample& actual, int8_t channel)
+{
+    if (expected.time != actual.time)
+        return false;
+    for(uint8_t i = 0; i < TestDevice::CHANNELS; i++)
+    {
+        float value = (channel < 0) ? actual.values[i] : (i == channel) ? actual.values[0] : expected.values[i];
+        // CSV has three decimals
+        if (fabs(expected.values[i] - value) > 0.0006)
+            return false;
+    }
+    return true;
+}
+
+TEST(samplesRoundTripThroughCompression)
+{
+    TestDevice device;
+    Host::setActiveDevice(&device);
+    std::vector<Sample> samples;
+    uint32_t time = 1700000000;
+    float voltage = 230;
+    for(uint32_t i = 0; i < 600; i++)
+    {
+        // Jitter of the period, occasional longer gaps hit every delta-of-delta width
+        if (i == 200)
+            time += 3000;
+        else if (i == 400)
+            time += 100000;
+        else if (i % 50 == 0)
+            time += 10 + random(200);
+        else
+            time += 10 + random(4);
+        // Steady, repeating, zero and negative values
+        voltage += (float)((int32_t)random(2001) - 1000) / 1000;
+        device.setValue(0, voltage);
+        device.setValue(1, (i % 7 < 3) ? 0 : (float)random(5000) / 1000);
+        device.setValue(2, (i % 3 == 0) ? -12.5f : (float)random(100000) / 37);
+        record(device, samples, time);
+    }
+    std::vector<Sample> decoded = readBack(PowerMeasArchive::Reader::ALL_CHANNELS, 1700000000, time);
+    CHECK(decoded.size() == samples.size());
+    uint32_t mismatches = 0;
+    for(size_t i = 0; (i < decoded.size()) && (i < samples.size()); i++)
+    {
+        if (!sameSample(samples[i], decoded[i], -1))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+
+    // One channel only, time range inside blocks
+    decoded = readBack(2, samples[100].time, samples[450].time);
+    CHECK(decoded.size() == 351);
+    mismatches = 0;
+    for(size_t i = 0; i < decoded.size(); i++)
+    {
+        if (!sameSample(samples[100 + i], decoded[i], 2))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST(oldestBlocksAreOverwrittenAfterWrap)
+{
+    TestDevice device;
+    Host::setActiveDevice(&device);
+    std::vector<Sample> samples;
+    uint32_t time = 1800000000;
+    // Random values do not compress, a few tens of samples fit a block
+    for(uint32_t i = 0; i < 8000; i++)
+    {
+        time += 10 + random(4);
+        for(uint8_t c = 0; c < TestDevice::CHANNELS; c++)
+            device.setValue(c, (float)random(10000000) / 1000);
+        record(device, samples, time);
+    }
+    std::vector<Sample> decoded = readBack(PowerMeasArchive::Reader::ALL_CHANNELS, 1800000000, time);
+    CHECK(decoded.size() > 1000);
+    CHECK(decoded.size() < samples.size());
+    // What remains is the newest part without holes
+    size_t first = samples.size() - min(decoded.size(), samples.size());
+    uint32_t mismatches = 0;
+    for(size_t i = 0; (i < decoded.size()) && (first + i < samples.size()); i++)
+    {
+        if (!sameSample(samples[first + i], decoded[i], -1))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+}
+
+// Block header as stored in the archive file
+struct StoredBlockHeader
+{
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t startTime;
+    uint32_t endTime;
+    uint32_t bitCount;
+    uint16_t sampleCount;
+    uint8_t channelCount;
+    uint8_t reserved;
+};
+
+// Noise of the chip in its raw units, values are raw times scale as drivers report them
+static float chipValue(float value, float scale, uint32_t noise)
+{
+    int32_t raw = (int32_t)(value / scale) + (int32_t)random(2 * noise + 1) - (int32_t)noise;
+    return (raw > 0) ? raw * scale : 0;
+}
+
+TEST(dayOfIdleAndMotorSamplesCompresses)
+{
+    TestDevice device;
+    Host::setActiveDevice(&device);
+    std::vector<Sample> samples;
+    uint32_t startTime = 1900000000;
+    uint32_t time = startTime;
+    // CSE7761 scales of default calibration, mains drifts slowly during the day
+    const float voltageScale = 0.01 * 42563 / 0x400000;
+    const float currentScale = 0.001 * 52241 / 0x800000;
+    const float powerScale = 0.1 * 42563 * 52241 / 0x80000000 / 4;
+    uint64_t encodeNanos = 0;
+    for(uint32_t i = 0; i < 8640; i++)
+    {
+        // Loop pass is late now and then, archive period is 10 s
+        time += (random(20) == 0) ? 11 : 10;
+        float voltage = 230 + 4 * sinf(2 * M_PI * i / 8640);
+        // Eight movements of 30 s, motor current with inrush
+        uint32_t phase = i % 1080;
+        float current = (phase == 0) ? 1.8 : (phase < 3) ? 0.45 : 0;
+        device.setValue(0, chipValue(voltage, voltageScale, 2000));
+        device.setValue(1, (current > 0) ? chipValue(current, currentScale, 300) : 0);
+        device.setValue(2, (current > 0) ? chipValue(voltage * current * 0.6, powerScale, 300) : 0);
+        auto before = std::chrono::steady_clock::now();
+        record(device, samples, time);
+        encodeNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - before).count();
+    }
+    // Finished blocks of this run in the archive file, last one is still in RAM
+    File file = LittleFS.open("/power_meas.arc", "r");
+    CHECK((bool)file);
+    uint32_t blocks = 0;
+    uint32_t blockSamples = 0;
+    uint64_t bits = 0;
+    for(uint32_t slot = 0; slot * PowerMeasArchive::BLOCK_SIZE < file.size(); slot++)
+    {
+        StoredBlockHeader header;
+        file.seek(slot * PowerMeasArchive::BLOCK_SIZE);
+        file.read((uint8_t*)&header, sizeof(header));
+        if (header.startTime < startTime)
+            continue;
+        blocks++;
+        blockSamples += header.sampleCount;
+        bits += header.bitCount;
+    }
+    file.close();
+    CHECK(blocks > 0);
+    double bytesPerSample = (double)blocks * PowerMeasArchive::BLOCK_SIZE / max(blockSamples, 1U);
+    double rawBytesPerSample = sizeof(uint32_t) * (1 + TestDevice::CHANNELS);
+    printf("  %u samples, %.2f bytes per sample stored (%.2f in data bits), ratio %.1f, encode %.2f us per sample\n",
+        (unsigned)samples.size(), bytesPerSample, (double)bits / 8 / max(blockSamples, 1U),
+        rawBytesPerSample / bytesPerSample, (double)encodeNanos / 1000 / samples.size());
+    // About 3 bytes of 16, mostly the voltage noise
+    CHECK(rawBytesPerSample / bytesPerSample >= 4);
+    // Compression is lossless
+    std::vector<Sample> decoded = readBack(PowerMeasArchive::Reader::ALL_CHANNELS, startTime, time);
+    CHECK(decoded.size() == samples.size());
+    uint32_t mismatches = 0;
+    for(size_t i = 0; (i < decoded.size()) && (i < samples.size()); i++)
+    {
+        if (!sameSample(samples[i], decoded[i], -1))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+}